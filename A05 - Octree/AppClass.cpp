@@ -17,20 +17,25 @@ void Application::InitVariables(void)
 #endif
 	int nSquare = static_cast<int>(std::sqrt(uInstances));
 	m_uObjects = nSquare * nSquare;
-	uint uIndex = -1;
-	for (int i = 0; i < nSquare; i++)
+	std::vector<matrix4> lPosition(m_uObjects);
+	for (uint i = 0; i < m_uObjects; i++)
 	{
-		for (int j = 0; j < nSquare; j++)
-		{
-			uIndex++;
-			m_pEntityMngr->AddEntity("Minecraft\\Cube.obj");
-			vector3 v3Position = vector3(glm::sphericalRand(34.0f));
-			matrix4 m4Position = glm::translate(v3Position);
-			m_pEntityMngr->SetModelMatrix(m4Position);
-		}
+		vector3 v3Position = vector3(glm::sphericalRand(34.0f));
+		lPosition[i] = glm::translate(v3Position);
 	}
+	m_pEntityMngr->AddEntities("Minecraft\\Cube.obj", m_uObjects, lPosition);
 	m_uOctantLevels = 1;
-	m_pRoot = new MyOctant(m_uOctantLevels, 5);	
+	m_pRoot = new MyOctant(m_uOctantLevels, m_uOctantIdealCount);
+
+	//a single core has no thread to spare, the rebuild takes a slice of every frame instead
+	if (std::thread::hardware_concurrency() <= 1)
+		m_Builder.SetSliceMs(m_dSliceMs);
+
+	//the .ini can pick a broadphase of the Entity Manager instead of the dimensions
+	if (m_nBroadphase >= 0 && m_nBroadphase < BROADPHASE_COUNT)
+		m_pEntityMngr->SetBroadphase(MyBroadphase::Create(static_cast<eBROADPHASE>(m_nBroadphase)));
+	else
+		m_nBroadphase = -1;
 	m_pEntityMngr->Update();
 }
 void Application::Update(void)
@@ -44,11 +49,76 @@ void Application::Update(void)
 	//Is the first person camera active?
 	CameraRotation();
 	
-	//Update Entity Manager
-	m_pEntityMngr->Update();
+	//while tuning each candidate is built once before its first frame, out of the time measured,
+	//so it is scored on the same update every other frame runs
+	if (m_Tuner.IsNewCandidate())
+	{
+		m_uOctantLevels = m_Tuner.GetMaxLevel();
+		m_uOctantIdealCount = m_Tuner.GetIdealCount();
+		RebuildOctree();
+	}
+
+	//Move the entities that changed to their new octants, the linear octree is rebuilt instead
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	MyOctant* pTree = m_Builder.TakeTree(m_pRoot);
+	if (pTree != nullptr)
+	{
+		//the new tree caught up with what moved while it was built and linked, it replaces the old one
+		SafeDelete(m_pRoot);
+		m_pRoot = pTree;
+		m_uOctantID = -1;
+	}
+	if (!m_bLinearOctree)
+		m_pRoot->Update();
+	else if (m_pEntityMngr->GetMovedList().size() > 0)
+		RebuildOctree();
+	m_dBuildMs = MyBenchmark::ElapsedMs(tStart);
+
+	//Update Entity Manager, only the pairs the octree or the chosen broadphase finds go through the narrowphase
+	tStart = std::chrono::high_resolution_clock::now();
+	m_lPair.clear();
+	if (m_nBroadphase >= 0)
+		m_pEntityMngr->UpdateBroadphase();
+	else
+	{
+		if (m_bLinearOctree)
+			m_pLinearRoot->GetPairs(m_lPair);
+		else
+			m_pRoot->GetPairs(m_lPair);
+		m_pEntityMngr->Update(m_lPair);
+	}
+	m_dBroadphaseMs = MyBenchmark::ElapsedMs(tStart);
+
+	//once every candidate is measured build with the cheapest
+	if (m_Tuner.IsRunning())
+	{
+		m_Tuner.AddFrame(m_dBuildMs, m_dBroadphaseMs);
+		if (!m_Tuner.IsRunning())
+		{
+			m_uOctantLevels = m_Tuner.GetMaxLevel();
+			m_uOctantIdealCount = m_Tuner.GetIdealCount();
+			RebuildOctree();
+		}
+	}
 
-	//Add objects to render list
-	m_pEntityMngr->AddEntityToRenderList(-1, true);
+	//Add objects to render list, the pointer octree skips the ones the camera cannot see
+	if (m_bLinearOctree)
+	{
+		m_pEntityMngr->AddEntityToRenderList(-1, true);
+		m_uCulledCount = 0;
+	}
+	else
+	{
+		matrix4 m4ViewProjection = m_pCameraMngr->GetProjectionMatrix() * m_pCameraMngr->GetViewMatrix();
+		m_lVisible.clear();
+		m_pRoot->GetVisible(m4ViewProjection, m_lVisible);
+		uint nVisible = m_lVisible.size();
+		for (uint i = 0; i < nVisible; i++)
+		{
+			m_pEntityMngr->AddEntityToRenderList(m_lVisible[i], true);
+		}
+		m_uCulledCount = m_pEntityMngr->GetEntityCount() - nVisible;
+	}
 }
 void Application::Display(void)
 {
@@ -56,10 +126,20 @@ void Application::Display(void)
 	ClearScreen();
 
 	//display octree
-	if (m_uOctantID == -1)
-		m_pRoot->Display();
+	if (m_bLinearOctree)
+	{
+		if (m_uOctantID == -1)
+			m_pLinearRoot->Display();
+		else
+			m_pLinearRoot->Display(m_uOctantID);
+	}
 	else
-		m_pRoot->Display(m_uOctantID);
+	{
+		if (m_uOctantID == -1)
+			m_pRoot->Display();
+		else
+			m_pRoot->Display(m_uOctantID);
+	}
 	
 	// draw a skybox
 	m_pMeshMngr->AddSkyboxToRenderList();
@@ -78,6 +158,12 @@ void Application::Display(void)
 }
 void Application::Release(void)
 {
+	//release octrees, a build still running is thrown away once it is done
+	m_Builder.Cancel();
+	m_Builder.Wait();
+	SafeDelete(m_pRoot);
+	SafeDelete(m_pLinearRoot);
+
 	//release GUI
 	ShutdownGUI();
 }
\ No newline at end of file
@@ -12,6 +12,12 @@ Date: 2017/06
 
 #include "MyEntityManager.h"
 #include "MyOctant.h"
+#include "MyLinearOctree.h"
+#include "MyBenchmark.h"
+#include "MyOctreeTuner.h"
+#include "MyOctreeBuilder.h"
+
+#include <fstream>
 
 namespace Simplex
 {
@@ -22,7 +28,21 @@ class Application
 	uint m_uOctantID = -1; //Index of Octant to display
 	uint m_uObjects = 0; //Number of objects in the scene
 	uint m_uOctantLevels = 0; //Number of levels in the octree
+	uint m_uOctantIdealCount = 5; //Ideal number of entities per octant
+	static const uint m_uMaxOctantLevels = 7; //deepest level the keys and the tuner can take the octree to
+	MyOctreeTuner m_Tuner; //picks the levels and ideal count of the octree by timing frames
+	double m_dBuildMs = 0.0; //time updating or building the octree in the last frame
+	double m_dBroadphaseMs = 0.0; //time finding and checking the pairs in the last frame
 	MyOctant* m_pRoot = nullptr;
+	MyOctreeBuilder m_Builder; //builds the pointer octree on another thread while the old one stays in use
+	double m_dSliceMs = 2.0; //milliseconds per frame of a sliced rebuild
+	MyLinearOctree* m_pLinearRoot = nullptr; //Linear octree, used instead of the root when enabled
+	bool m_bLinearOctree = false; //use the linear octree?
+	bool m_bLooseOctree = false; //make the pointer octree loose?
+	float m_fLooseness = 2.0f; //size of the loose bounds of each octant over the octant size
+	std::vector<std::pair<uint, uint>> m_lPair; //candidate pairs the octree found this frame
+	int m_nBroadphase = -1; //eBROADPHASE the Entity Manager finds the pairs with, -1 for the pairs of the octree of the application
+	std::vector<uint> m_lVisible; //entities inside of the view frustum this frame
 private:
 	String m_sProgrammer = "Sean Foley - stf7169@rit.edu"; //programmer
 
@@ -31,8 +51,11 @@ private:
 	bool m_bGUI_Console = true; //show Credits GUI window?
 	bool m_bGUI_Test = false; //show Test GUI window?
 	bool m_bGUI_Controller = false; //show Controller GUI window?
+	bool m_bGUI_Benchmark = true; //show Benchmark GUI window?
+	bool m_bGUI_Stats = true; //show Octree statistics GUI window?
 
 	uint m_uRenderCallCount = 0; //count of render calls per frame
+	uint m_uCulledCount = 0; //count of entities outside of the view frustum per frame
 	uint m_uControllerCount = 0; //count of controllers connected
 
 	bool m_bFocused = true; //is the window focused?
@@ -174,6 +197,19 @@ private:
 #pragma endregion
 
 #pragma region Application Controls
+	/*
+	USAGE: Deletes the octree in use and builds it again with the current number of levels
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RebuildOctree(void);
+	/*
+	USAGE: Builds the pointer octree again on another thread, the current one is used until the new
+	one is done; the linear octree and the tuner rebuild right away
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void RebuildOctreeAsync(void);
 	/*
 	USAGE: Manage constant keyboard state
 	ARGUMENTS: ---
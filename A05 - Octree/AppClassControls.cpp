@@ -113,39 +113,52 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 		break;
 	case sf::Keyboard::PageUp:
 		++m_uOctantID;
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_uOctantID >= (m_bLinearOctree ? m_pLinearRoot->GetOctantCount() : m_pRoot->GetOctantCount()))
 			m_uOctantID = - 1;
 		
 		break;
 	case sf::Keyboard::PageDown:
 		--m_uOctantID;
 		
-		if (m_uOctantID >= m_pRoot->GetOctantCount())
+		if (m_uOctantID >= (m_bLinearOctree ? m_pLinearRoot->GetOctantCount() : m_pRoot->GetOctantCount()))
 			m_uOctantID = - 1;
 		
 		break;
 	case sf::Keyboard::Add:
-		if (m_uOctantLevels < 4)
+		if (m_uOctantLevels < m_uMaxOctantLevels)
 		{
-			m_pEntityMngr->ClearDimensionSetAll();
 			++m_uOctantLevels;
-			
-			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
-			
+			RebuildOctreeAsync();
 		}
 		break;
 	case sf::Keyboard::Subtract:
 		if (m_uOctantLevels > 0)
 		{
-			m_pEntityMngr->ClearDimensionSetAll();
 			--m_uOctantLevels;
-			
-			SafeDelete(m_pRoot);
-			m_pRoot = new MyOctant(m_uOctantLevels, 5);
-			
+			RebuildOctreeAsync();
 		}
 		break;
+	case sf::Keyboard::L:
+		m_bLinearOctree = !m_bLinearOctree;
+		m_uOctantID = -1;
+		RebuildOctree();
+		break;
+	case sf::Keyboard::O:
+		m_bLooseOctree = !m_bLooseOctree;
+		RebuildOctreeAsync();
+		break;
+	case sf::Keyboard::B:
+		//the build running keeps going the way it started
+		m_Builder.SetSliceMs(m_Builder.GetSliceMs() > 0.0 ? 0.0 : m_dSliceMs);
+		break;
+	case sf::Keyboard::T:
+		//the tuner times the pairs of the octree, a broadphase of the manager does not use them
+		if (m_nBroadphase >= 0)
+			break;
+		//the octants change while tuning, show all of them
+		m_uOctantID = -1;
+		m_Tuner.Start(m_pEntityMngr->GetEntityCount(), m_uMaxOctantLevels);
+		break;
 	case sf::Keyboard::LShift:
 	case sf::Keyboard::RShift:
 		m_bModifier = false;
@@ -156,6 +169,41 @@ void Application::ProcessKeyReleased(sf::Event a_event)
 	gui.io.KeyCtrl = a_event.key.control;
 	gui.io.KeyShift = a_event.key.shift;
 }
+void Application::RebuildOctree(void)
+{
+	//a tree built now is newer than the one on the other thread
+	m_Builder.Cancel();
+	m_pEntityMngr->ClearDimensionSetAll();
+
+	//only the octree in use is kept, the pointer octree reuses the octants of its last build
+	if (m_bLinearOctree)
+	{
+		SafeDelete(m_pRoot);
+		SafeDelete(m_pLinearRoot);
+		m_pLinearRoot = new MyLinearOctree(m_uOctantLevels, m_uOctantIdealCount);
+	}
+	else
+	{
+		SafeDelete(m_pLinearRoot);
+		float fLooseness = m_bLooseOctree ? m_fLooseness : 0.0f;
+		if (m_pRoot == nullptr)
+			m_pRoot = new MyOctant(m_uOctantLevels, m_uOctantIdealCount, fLooseness);
+		else
+			m_pRoot->Rebuild(m_uOctantLevels, m_uOctantIdealCount, fLooseness);
+	}
+}
+void Application::RebuildOctreeAsync(void)
+{
+	//the linear octree is rebuilt every time something moves, only the pointer octree is worth the thread
+	if (m_bLinearOctree || m_Tuner.IsRunning())
+	{
+		RebuildOctree();
+		return;
+	}
+
+	float fLooseness = m_bLooseOctree ? m_fLooseness : 0.0f;
+	m_Builder.Start(m_uOctantLevels, m_uOctantIdealCount, fLooseness);
+}
 //Joystick
 void Application::ProcessJoystickConnected(uint nController)
 {
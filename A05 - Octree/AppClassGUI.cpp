@@ -16,6 +16,11 @@ void Application::DrawGUI(void)
 	m_pMeshMngr->Print("RenderCalls: ");//Add a line on top
 	m_pMeshMngr->PrintLine(std::to_string(m_uRenderCallCount), C_YELLOW);
 
+	//m_pMeshMngr->Print("						");
+	m_pMeshMngr->Print("Culled/Submitted: ");
+	m_pMeshMngr->PrintLine(std::to_string(m_uCulledCount) + "/" +
+		std::to_string(m_pEntityMngr->GetEntityCount() - m_uCulledCount), C_YELLOW);
+
 	//m_pMeshMngr->Print("						");
 	m_pMeshMngr->Print("FPS:");
 	m_pMeshMngr->PrintLine(std::to_string(m_pSystem->GetFPS()), C_RED);
@@ -39,8 +44,61 @@ void Application::DrawGUI(void)
 			ImGui::Text("FrameRate: %.2f [FPS] -> %.3f [ms/frame]\n",
 				ImGui::GetIO().Framerate, 1000.0f / ImGui::GetIO().Framerate);
 			ImGui::Text("Levels in Octree: %d\n", m_uOctantLevels);
-			//ImGui::Text("Octants: %d\n", m_pRoot->GetOctantCount());
+			ImGui::Text("Ideal Entities per Octant: %d\n", m_uOctantIdealCount);
+			if (m_nBroadphase >= 0)
+				ImGui::TextColored(ImColor(128, 128, 128), "Auto-tune: off, the broadphase does not use the octree\n");
+			else if (m_Tuner.IsRunning())
+				ImGui::Text("Auto-tune: measuring %d of %d\n", m_Tuner.GetCandidate() + 1, m_Tuner.GetCandidateCount());
+			else if (m_Tuner.GetCandidateCount() > 0)
+				ImGui::Text("Auto-tune: build %.3f ms, pairs %.3f ms\n", m_Tuner.GetBuildMs(), m_Tuner.GetBroadphaseMs());
+			ImGui::Text("Octree update %.3f ms, pairs %.3f ms\n", m_dBuildMs, m_dBroadphaseMs);
+			if (m_Builder.GetSliceMs() > 0.0)
+				ImGui::Text("Octree rebuild: sliced, %.1f ms per frame\n", m_Builder.GetSliceMs());
+			else
+				ImGui::Text("Octree rebuild: background thread\n");
+			if (m_Builder.IsBuilding())
+				ImGui::TextColored(ImColor(255, 255, 0), "Rebuilding octree...\n");
+			ImGui::Text("Octree mode: %s\n", m_bLinearOctree ? "Linear" : (m_bLooseOctree ? "Loose" : "Pointer"));
+			{
+				//the octree keeps culling either way, the broadphase only picks the pairs
+				const char* lBroadphase[BROADPHASE_COUNT + 1];
+				lBroadphase[0] = "Octree pairs (app)";
+				for (int i = 0; i < BROADPHASE_COUNT; i++)
+					lBroadphase[i + 1] = MyBroadphase::GetTypeName(static_cast<eBROADPHASE>(i));
+				int nSelected = m_nBroadphase + 1;
+				if (ImGui::Combo("Broadphase", &nSelected, lBroadphase, BROADPHASE_COUNT + 1) && nSelected - 1 != m_nBroadphase)
+				{
+					m_nBroadphase = nSelected - 1;
+					if (m_nBroadphase >= 0)
+					{
+						//the octree keeps the levels of the candidate being measured
+						m_Tuner.Stop();
+						m_pEntityMngr->SetBroadphase(MyBroadphase::Create(static_cast<eBROADPHASE>(m_nBroadphase)));
+					}
+					else
+						m_pEntityMngr->SetBroadphase(nullptr);
+				}
+			}
+			{
+				//the Entities can live in the lists of the manager instead of their own objects
+				bool bDataOriented = m_pEntityMngr->IsDataOriented();
+				if (ImGui::Checkbox("Data oriented Entities", &bDataOriented))
+					m_pEntityMngr->SetDataOriented(bDataOriented);
+			}
+			if (!m_bLinearOctree)
+				ImGui::Text("Duplication factor: %.2f\n", m_pRoot->GetDuplicationFactor());
+			{
+				//dimensions go through SharesDimension for every pair
+				uint nEntities = m_pEntityMngr->GetEntityCount();
+				uint nDimensions = 0;
+				for (uint i = 0; i < nEntities; i++)
+					nDimensions += m_pEntityMngr->GetDimensionCount(i);
+				ImGui::Text("Dimensions per Entity: %.2f\n", nEntities > 0 ? nDimensions / static_cast<float>(nEntities) : 0.0f);
+			}
+			ImGui::Text("Octants: %d\n", m_bLinearOctree ? m_pLinearRoot->GetOctantCount() : m_pRoot->GetOctantCount());
 			ImGui::Text("Objects: %d\n", m_uObjects);
+			ImGui::Text("Candidate pairs: %d\n", static_cast<int>(m_nBroadphase >= 0 ?
+				m_pEntityMngr->GetBroadphasePairs().size() : m_lPair.size()));
 			ImGui::Separator();
 			ImGui::Text("Control:\n");
 			ImGui::Text("   WASD: Movement\n");
@@ -54,12 +112,101 @@ void Application::DrawGUI(void)
 			ImGui::Separator();
 			ImGui::Text("	  -: Increment Octree subdivision\n");
 			ImGui::Text("	  +: Decrement Octree subdivision\n");
+			ImGui::Text("	  L: Toggle linear Octree\n");
+			ImGui::Text("	  O: Toggle loose Octree\n");
+			if (m_nBroadphase >= 0)
+				ImGui::TextColored(ImColor(128, 128, 128), "	  T: Auto-tune Octree levels\n");
+			else
+				ImGui::Text("	  T: Auto-tune Octree levels\n");
+			ImGui::Text("	  B: Toggle sliced Octree rebuild\n");
 			ImGui::Separator();
 			ImGui::TextColored(ImColor(255, 255, 0), "Octree\n");
 		}
 		ImGui::End();
 	}
 
+	//Benchmark Window
+	if (m_bGUI_Benchmark)
+	{
+		ImGui::SetNextWindowPos(ImVec2(m_pSystem->GetWindowWidth() - 321.0f, 1), ImGuiSetCond_FirstUseEver);
+		ImGui::SetNextWindowSize(ImVec2(320, 400), ImGuiSetCond_FirstUseEver);
+		ImGui::Begin("Benchmarks (results in console)", (bool*)0, ImGuiWindowFlags_NoCollapse);
+		{
+			if (ImGui::Button("Octree build 1k - 1M"))
+				MyBenchmark::OctreeBuild();
+			if (ImGui::Button("Octree incremental update 100k"))
+				MyBenchmark::OctreeUpdate();
+			if (ImGui::Button("Pointer vs linear octree 1k - 1M"))
+				MyBenchmark::LinearOctree();
+			if (ImGui::Button("Octree node pool 1849"))
+				MyBenchmark::OctreePool();
+			if (ImGui::Button("Regular vs loose octree 1849"))
+				MyBenchmark::LooseOctree();
+			if (ImGui::Button("Octree pairs vs all pairs 1849 - 100k"))
+				MyBenchmark::OctreePairs();
+			if (ImGui::Button("Parallel octree build 1M, 1 - all cores"))
+				MyBenchmark::ParallelBuild();
+			if (ImGui::Button("Ray cast vs all boxes 1849 - 100k"))
+				MyBenchmark::RayCast();
+			if (ImGui::Button("Sliced octree build 1M, 1 - 4 ms"))
+				MyBenchmark::SlicedBuild();
+			if (ImGui::Button("Broadphases, moving cubes 1849 - 50k"))
+				MyBenchmark::Broadphases();
+			if (ImGui::Button("Hash grid vs octree 1849 - 100k"))
+				MyBenchmark::HashGrid();
+			if (ImGui::Button("Broadphases, mixed sizes 20k"))
+				MyBenchmark::MixedSizes();
+			if (ImGui::Button("Box test kernels, scalar vs SIMD 1849 - 10k"))
+				MyBenchmark::BoxKernels();
+			if (ImGui::Button("Entity load, one at a time vs bulk 1849 - 50k"))
+				MyBenchmark::EntityLoad();
+			if (ImGui::Button("Entity lookup, names vs handles 1849 - 50k"))
+				MyBenchmark::EntityLookup();
+			if (ImGui::Button("Entity layout, objects vs lists 1849 - 10k"))
+				MyBenchmark::EntityLayout();
+			if (ImGui::Button("Dimension sets, arrays vs inline 1 - 16"))
+				MyBenchmark::DimensionSets();
+			if (ImGui::Button("Contacts, arrays per body vs buffer 1849 - 25k"))
+				MyBenchmark::ContactBuffer();
+		}
+		ImGui::End();
+	}
+
+	//Octree Statistics Window
+	if (m_bGUI_Stats && !m_bLinearOctree)
+	{
+		ImGui::SetNextWindowPos(ImVec2(m_pSystem->GetWindowWidth() - 321.0f, 402), ImGuiSetCond_FirstUseEver);
+		ImGui::SetNextWindowSize(ImVec2(320, 300), ImGuiSetCond_FirstUseEver);
+		ImGui::Begin("Octree statistics", (bool*)0, ImGuiWindowFlags_NoCollapse);
+		{
+			MyOctant::Stats stats;
+			m_pRoot->GetStats(stats);
+			ImGui::Text("Octants: %d, Entities: %d\n", stats.uOctantCount, stats.uEntityCount);
+			for (uint i = 0; i < stats.lLevelOctants.size(); i++)
+				ImGui::Text("  Level %d: %d octants\n", i, stats.lLevelOctants[i]);
+			ImGui::Text("Leafs: %d (%d empty)\n", stats.uLeafCount, stats.uEmptyLeafCount);
+			ImGui::Text("Most Entities in a leaf: %d\n", stats.uMaxLeafEntities);
+			if (m_pRoot->IsLoose())
+				ImGui::Text("Entities above the leafs: %d\n", stats.uBranchEntities);
+			ImGui::Text("Duplication factor: %.2f\n", stats.fDuplication);
+			ImGui::Text("Last build: %.3f ms\n", stats.dBuildMs);
+			ImGui::Text("Memory: %.1f KB\n", stats.uMemoryBytes / 1024.0);
+
+			//leafs by the number of Entities they hold, the last bar is that many or more
+			std::vector<float> lOccupancy(stats.lLeafOccupancy.begin(), stats.lLeafOccupancy.end());
+			ImGui::PlotHistogram("", lOccupancy.data(), static_cast<int>(lOccupancy.size()), 0,
+				"Leafs by Entity count", 0.0f, FLT_MAX, ImVec2(300, 80));
+
+			if (ImGui::Button("Save to OctreeStats.json"))
+			{
+				std::ofstream file("OctreeStats.json");
+				file << MyOctant::GetStatsJSON(stats);
+				std::cout << "Octree statistics saved to OctreeStats.json" << std::endl;
+			}
+		}
+		ImGui::End();
+	}
+
 	// Rendering
 	ImGui::Render();
 
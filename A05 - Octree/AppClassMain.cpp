@@ -339,6 +339,12 @@ void Application::ReadConfig(void)
 			sscanf_s(reader.m_sLine.c_str(), "Borderless: %d", &nValue);
 			m_pSystem->SetWindowBorderless(nValue != 0);
 		}
+		else if (sWord == "Broadphase:")
+		{
+			int nValue;
+			sscanf_s(reader.m_sLine.c_str(), "Broadphase: %d", &nValue);
+			m_nBroadphase = nValue;
+		}
 		else if (sWord == "FrameRate:")
 		{
 			int nValue;
@@ -443,6 +449,11 @@ void Application::WriteConfig(void)
 	fprintf(pFile, "\n\nFrameRate: ");
 	fprintf(pFile, "%d", m_pSystem->GetMaxFrameRate());
 
+	fprintf(pFile, "\n\nBroadphase: %d", m_nBroadphase);
+	fprintf(pFile, "\n# Broadphase: -1 (Octree pairs (app))");
+	for (int i = 0; i < BROADPHASE_COUNT; i++)
+		fprintf(pFile, "\n# Broadphase: %d (%s)", i, MyBroadphase::GetTypeName(static_cast<eBROADPHASE>(i)));
+
 	fprintf(pFile, "\n\nResolution: [ %d x %d ]", m_pSystem->GetWindowWidth(), m_pSystem->GetWindowHeight());
 	fprintf(pFile, "\n# Resolution: [ 640 x 480 ]");
 	fprintf(pFile, "\n# Resolution: [ 1280 x 720 ]");
@@ -0,0 +1,348 @@
+#include "MyAABBTreeBroadphase.h"
+using namespace Simplex;
+const uint MyAABBTreeBroadphase::m_uNull;
+
+namespace
+{
+	//box holding the two boxes given
+	void GetUnion(vector3 const& a_v3MinA, vector3 const& a_v3MaxA, vector3 const& a_v3MinB, vector3 const& a_v3MaxB,
+		vector3& a_v3Min, vector3& a_v3Max)
+	{
+		a_v3Min = vector3(std::min(a_v3MinA.x, a_v3MinB.x), std::min(a_v3MinA.y, a_v3MinB.y), std::min(a_v3MinA.z, a_v3MinB.z));
+		a_v3Max = vector3(std::max(a_v3MaxA.x, a_v3MaxB.x), std::max(a_v3MaxA.y, a_v3MaxB.y), std::max(a_v3MaxA.z, a_v3MaxB.z));
+	}
+}
+
+String MyAABBTreeBroadphase::GetName(void) { return GetTypeName(BROADPHASE_AABB_TREE); }
+
+int MyAABBTreeBroadphase::GetHeight(void) { return m_uRoot == m_uNull ? -1 : m_lNode[m_uRoot].nHeight; }
+
+uint MyAABBTreeBroadphase::GetReinsertCount(void) { return m_uReinsertCount; }
+
+void MyAABBTreeBroadphase::Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	m_lNode.clear();
+	m_uRoot = m_uNull;
+	m_uFreeNode = m_uNull;
+	m_lLeaf.clear();
+	m_lMin.clear();
+	m_lMax.clear();
+	m_lPair.clear();
+	m_lMovedStamp.clear();
+
+	//every box is new, the update inserts them all and finds every pair
+	uint nEntities = a_lMin.size();
+	m_lNode.reserve(nEntities * 2);
+	std::vector<uint> lNew(nEntities);
+	for (uint i = 0; i < nEntities; i++)
+		lNew[i] = i;
+	Update(a_lMin, a_lMax, lNew);
+}
+
+void MyAABBTreeBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& a_lMoved)
+{
+	//removed Entities shift the indices
+	uint nEntities = a_lMin.size();
+	if (nEntities < m_lLeaf.size())
+	{
+		Build(a_lMin, a_lMax);
+		return;
+	}
+
+	m_uStamp++;
+	m_uReinsertCount = 0;
+	m_lLeaf.resize(nEntities, m_uNull);
+	m_lMin.resize(nEntities);
+	m_lMax.resize(nEntities);
+	m_lMovedStamp.resize(nEntities, 0);
+
+	uint nMoved = a_lMoved.size();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = a_lMoved[i];
+		m_lMin[uEntity] = a_lMin[uEntity];
+		m_lMax[uEntity] = a_lMax[uEntity];
+		m_lMovedStamp[uEntity] = m_uStamp;
+
+		uint uLeaf = m_lLeaf[uEntity];
+		if (uLeaf == m_uNull)
+		{
+			uLeaf = AllocateNode();
+			m_lNode[uLeaf].uEntity = uEntity;
+			m_lNode[uLeaf].nHeight = 0;
+			m_lLeaf[uEntity] = uLeaf;
+			SetFatBox(uEntity);
+			InsertLeaf(uLeaf);
+			continue;
+		}
+
+		//a box still inside of its fat box leaves the tree as it is
+		Node const& leaf = m_lNode[uLeaf];
+		if (leaf.v3Min.x <= a_lMin[uEntity].x && leaf.v3Min.y <= a_lMin[uEntity].y && leaf.v3Min.z <= a_lMin[uEntity].z &&
+			leaf.v3Max.x >= a_lMax[uEntity].x && leaf.v3Max.y >= a_lMax[uEntity].y && leaf.v3Max.z >= a_lMax[uEntity].z)
+			continue;
+
+		RemoveLeaf(uLeaf);
+		SetFatBox(uEntity);
+		InsertLeaf(uLeaf);
+		m_uReinsertCount++;
+	}
+
+	//the pairs of two Entities that stayed still did not change
+	std::vector<uint> const& lStamp = m_lMovedStamp;
+	uint uStamp = m_uStamp;
+	m_lPair.erase(std::remove_if(m_lPair.begin(), m_lPair.end(), [&lStamp, uStamp](std::pair<uint, uint> const& a_Pair)
+	{
+		return lStamp[a_Pair.first] == uStamp || lStamp[a_Pair.second] == uStamp;
+	}), m_lPair.end());
+
+	for (uint i = 0; i < nMoved; i++)
+		FindPairs(a_lMoved[i]);
+}
+
+void MyAABBTreeBroadphase::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	a_lOutput.insert(a_lOutput.end(), m_lPair.begin(), m_lPair.end());
+}
+
+void MyAABBTreeBroadphase::Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput)
+{
+	if (m_uRoot == m_uNull)
+		return;
+
+	m_lStack.clear();
+	m_lStack.push_back(m_uRoot);
+	while (!m_lStack.empty())
+	{
+		uint uNode = m_lStack.back();
+		m_lStack.pop_back();
+		Node const& node = m_lNode[uNode];
+		if (!IsOverlapping(node.v3Min, node.v3Max, a_v3Min, a_v3Max))
+			continue;
+
+		if (node.nHeight == 0)
+		{
+			//the fat box overlapped, the box itself may not
+			if (IsOverlapping(m_lMin[node.uEntity], m_lMax[node.uEntity], a_v3Min, a_v3Max))
+				a_lOutput.push_back(node.uEntity);
+			continue;
+		}
+		m_lStack.push_back(node.lChild[0]);
+		m_lStack.push_back(node.lChild[1]);
+	}
+}
+
+void MyAABBTreeBroadphase::FindPairs(uint a_uEntity)
+{
+	vector3 const& v3Min = m_lMin[a_uEntity];
+	vector3 const& v3Max = m_lMax[a_uEntity];
+
+	m_lStack.clear();
+	m_lStack.push_back(m_uRoot);
+	while (!m_lStack.empty())
+	{
+		uint uNode = m_lStack.back();
+		m_lStack.pop_back();
+		Node const& node = m_lNode[uNode];
+		if (!IsOverlapping(node.v3Min, node.v3Max, v3Min, v3Max))
+			continue;
+
+		if (node.nHeight > 0)
+		{
+			m_lStack.push_back(node.lChild[0]);
+			m_lStack.push_back(node.lChild[1]);
+			continue;
+		}
+
+		uint uOther = node.uEntity;
+		if (uOther == a_uEntity || (m_lMovedStamp[uOther] == m_uStamp && uOther < a_uEntity))
+			continue;
+		if (IsOverlapping(v3Min, v3Max, m_lMin[uOther], m_lMax[uOther]))
+			m_lPair.push_back(std::pair<uint, uint>(std::min(a_uEntity, uOther), std::max(a_uEntity, uOther)));
+	}
+}
+
+uint MyAABBTreeBroadphase::AllocateNode(void)
+{
+	uint uNode = m_uFreeNode;
+	if (uNode != m_uNull)
+	{
+		m_uFreeNode = m_lNode[uNode].uParent;
+		m_lNode[uNode] = Node();
+		return uNode;
+	}
+
+	m_lNode.push_back(Node());
+	return m_lNode.size() - 1;
+}
+
+void MyAABBTreeBroadphase::FreeNode(uint a_uNode)
+{
+	m_lNode[a_uNode].nHeight = -1;
+	m_lNode[a_uNode].uParent = m_uFreeNode;
+	m_uFreeNode = a_uNode;
+}
+
+void MyAABBTreeBroadphase::SetFatBox(uint a_uEntity)
+{
+	//bigger boxes get a bigger margin, a fixed one would be lost on them and too much on small ones
+	vector3 v3Margin = vector3(m_fMargin) + (m_lMax[a_uEntity] - m_lMin[a_uEntity]) * m_fMarginScale;
+	Node& leaf = m_lNode[m_lLeaf[a_uEntity]];
+	leaf.v3Min = m_lMin[a_uEntity] - v3Margin;
+	leaf.v3Max = m_lMax[a_uEntity] + v3Margin;
+}
+
+void MyAABBTreeBroadphase::InsertLeaf(uint a_uLeaf)
+{
+	if (m_uRoot == m_uNull)
+	{
+		m_uRoot = a_uLeaf;
+		m_lNode[a_uLeaf].uParent = m_uNull;
+		return;
+	}
+
+	//walk down to the node that costs the least to pair with the leaf, counting what the branches above grow
+	vector3 v3LeafMin = m_lNode[a_uLeaf].v3Min;
+	vector3 v3LeafMax = m_lNode[a_uLeaf].v3Max;
+	uint uNode = m_uRoot;
+	while (m_lNode[uNode].nHeight > 0)
+	{
+		Node const& node = m_lNode[uNode];
+		vector3 v3Min;
+		vector3 v3Max;
+		GetUnion(node.v3Min, node.v3Max, v3LeafMin, v3LeafMax, v3Min, v3Max);
+		float fArea = GetArea(node.v3Min, node.v3Max);
+		float fCombined = GetArea(v3Min, v3Max);
+
+		//a new parent of this node and the leaf, or the growth of this node plus going further down
+		float fCost = 2.0f * fCombined;
+		float fInheritance = 2.0f * (fCombined - fArea);
+		float lChildCost[2];
+		for (uint i = 0; i < 2; i++)
+		{
+			Node const& child = m_lNode[node.lChild[i]];
+			GetUnion(child.v3Min, child.v3Max, v3LeafMin, v3LeafMax, v3Min, v3Max);
+			lChildCost[i] = GetArea(v3Min, v3Max) + fInheritance;
+			if (child.nHeight > 0)
+				lChildCost[i] -= GetArea(child.v3Min, child.v3Max);
+		}
+
+		if (fCost < lChildCost[0] && fCost < lChildCost[1])
+			break;
+		uNode = lChildCost[0] < lChildCost[1] ? node.lChild[0] : node.lChild[1];
+	}
+
+	//the leaf and the node found become the children of a new branch
+	uint uSibling = uNode;
+	uint uOldParent = m_lNode[uSibling].uParent;
+	uint uNewParent = AllocateNode();
+	Node& newParent = m_lNode[uNewParent];
+	newParent.uParent = uOldParent;
+	newParent.lChild[0] = uSibling;
+	newParent.lChild[1] = a_uLeaf;
+	newParent.nHeight = m_lNode[uSibling].nHeight + 1;
+	GetUnion(m_lNode[uSibling].v3Min, m_lNode[uSibling].v3Max, v3LeafMin, v3LeafMax, newParent.v3Min, newParent.v3Max);
+	m_lNode[uSibling].uParent = uNewParent;
+	m_lNode[a_uLeaf].uParent = uNewParent;
+
+	if (uOldParent == m_uNull)
+		m_uRoot = uNewParent;
+	else if (m_lNode[uOldParent].lChild[0] == uSibling)
+		m_lNode[uOldParent].lChild[0] = uNewParent;
+	else
+		m_lNode[uOldParent].lChild[1] = uNewParent;
+
+	FixUpwards(uOldParent);
+}
+
+void MyAABBTreeBroadphase::RemoveLeaf(uint a_uLeaf)
+{
+	if (a_uLeaf == m_uRoot)
+	{
+		m_uRoot = m_uNull;
+		return;
+	}
+
+	uint uParent = m_lNode[a_uLeaf].uParent;
+	uint uGrandParent = m_lNode[uParent].uParent;
+	uint uSibling = m_lNode[uParent].lChild[0] == a_uLeaf ? m_lNode[uParent].lChild[1] : m_lNode[uParent].lChild[0];
+	FreeNode(uParent);
+
+	m_lNode[uSibling].uParent = uGrandParent;
+	if (uGrandParent == m_uNull)
+	{
+		m_uRoot = uSibling;
+		return;
+	}
+	if (m_lNode[uGrandParent].lChild[0] == uParent)
+		m_lNode[uGrandParent].lChild[0] = uSibling;
+	else
+		m_lNode[uGrandParent].lChild[1] = uSibling;
+	FixUpwards(uGrandParent);
+}
+
+void MyAABBTreeBroadphase::FixUpwards(uint a_uNode)
+{
+	while (a_uNode != m_uNull)
+	{
+		a_uNode = Balance(a_uNode);
+		Refit(a_uNode);
+		a_uNode = m_lNode[a_uNode].uParent;
+	}
+}
+
+void MyAABBTreeBroadphase::Refit(uint a_uNode)
+{
+	Node& node = m_lNode[a_uNode];
+	Node const& left = m_lNode[node.lChild[0]];
+	Node const& right = m_lNode[node.lChild[1]];
+	node.nHeight = 1 + std::max(left.nHeight, right.nHeight);
+	GetUnion(left.v3Min, left.v3Max, right.v3Min, right.v3Max, node.v3Min, node.v3Max);
+}
+
+uint MyAABBTreeBroadphase::Balance(uint a_uNode)
+{
+	if (m_lNode[a_uNode].nHeight < 2)
+		return a_uNode;
+
+	//the taller child takes the place of the node, the node keeps the shorter grandchild
+	int nBalance = m_lNode[m_lNode[a_uNode].lChild[1]].nHeight - m_lNode[m_lNode[a_uNode].lChild[0]].nHeight;
+	if (nBalance >= -1 && nBalance <= 1)
+		return a_uNode;
+
+	uint uTall = nBalance > 0 ? 1 : 0;
+	uint uUp = m_lNode[a_uNode].lChild[uTall];
+	uint uParent = m_lNode[a_uNode].uParent;
+
+	//the child goes up
+	m_lNode[uUp].uParent = uParent;
+	m_lNode[a_uNode].uParent = uUp;
+	if (uParent == m_uNull)
+		m_uRoot = uUp;
+	else if (m_lNode[uParent].lChild[0] == a_uNode)
+		m_lNode[uParent].lChild[0] = uUp;
+	else
+		m_lNode[uParent].lChild[1] = uUp;
+
+	//its taller child stays with it next to the node, the shorter one moves down to the node
+	uint uGrandTall = m_lNode[uUp].lChild[0];
+	uint uGrandShort = m_lNode[uUp].lChild[1];
+	if (m_lNode[uGrandTall].nHeight < m_lNode[uGrandShort].nHeight)
+		std::swap(uGrandTall, uGrandShort);
+
+	m_lNode[uUp].lChild[0] = a_uNode;
+	m_lNode[uUp].lChild[1] = uGrandTall;
+	m_lNode[a_uNode].lChild[uTall] = uGrandShort;
+	m_lNode[uGrandShort].uParent = a_uNode;
+
+	Refit(a_uNode);
+	Refit(uUp);
+	return uUp;
+}
+
+float MyAABBTreeBroadphase::GetArea(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	vector3 v3Size = a_v3Max - a_v3Min;
+	return v3Size.x * v3Size.y + v3Size.y * v3Size.z + v3Size.z * v3Size.x;
+}
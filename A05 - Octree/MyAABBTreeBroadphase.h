@@ -0,0 +1,164 @@
+#ifndef __MYAABBTREEBROADPHASECLASS_H_
+#define __MYAABBTREEBROADPHASECLASS_H_
+
+#include "MyBroadphase.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyAABBTreeBroadphase : public MyBroadphase
+	{
+		static const uint m_uNull = static_cast<uint>(-1); //index of no node and of no Entity
+
+		//node of the tree, a leaf holds the fat box of an Entity and a branch the box of its two children
+		struct Node
+		{
+			vector3 v3Min; //minimum corner of the fat box
+			vector3 v3Max; //maximum corner of the fat box
+			uint uParent = m_uNull; //parent node, next free node once freed
+			uint lChild[2] = { m_uNull, m_uNull }; //children, none for a leaf
+			int nHeight = -1; //0 for a leaf, -1 once freed
+			uint uEntity = m_uNull; //Entity of a leaf
+		};
+
+		float m_fMargin = 0.1f; //distance the fat boxes grow on every side
+		float m_fMarginScale = 0.1f; //part of the size of each box the fat box grows on every side on top of the margin
+
+		std::vector<Node> m_lNode; //nodes of the tree, freed ones are reused
+		uint m_uRoot = m_uNull; //root node
+		uint m_uFreeNode = m_uNull; //first freed node
+		std::vector<uint> m_lLeaf; //leaf of each Entity
+		std::vector<vector3> m_lMin; //minimum corner of the box of each Entity
+		std::vector<vector3> m_lMax; //maximum corner of the box of each Entity
+		std::vector<std::pair<uint, uint>> m_lPair; //overlapping pairs, the ones of the Entities that did not move are kept
+		std::vector<uint> m_lMovedStamp; //update each Entity last moved in
+		uint m_uStamp = 0; //current update
+		std::vector<uint> m_lStack; //nodes left to visit by a query
+		uint m_uReinsertCount = 0; //leafs taken out and inserted again in the last Update
+
+	public:
+		/*
+		USAGE: Gets the name of the broadphase
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		String GetName(void) override;
+		/*
+		USAGE: Inserts every box in a new tree with its fat box and finds every pair
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) override;
+		/*
+		USAGE: Inserts the boxes of the new Entities, takes out and inserts again the moved ones that
+		left their fat box, and finds the pairs of the moved Entities only; the pairs of the rest are kept
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new
+		OUTPUT: ---
+		*/
+		void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved) override;
+		/*
+		USAGE: Gets the pairs found by the last Build and Update
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) override;
+		/*
+		USAGE: Finds the Entities whose box overlaps a box, going down only the nodes whose fat box does
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		- std::vector<uint>& a_lOutput -> list the Entities are appended to
+		OUTPUT: ---
+		*/
+		void Query(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Gets the height of the tree, the rotations keep it about the log of the Entity count
+		ARGUMENTS: ---
+		OUTPUT: levels below the root, -1 if empty
+		*/
+		int GetHeight(void);
+		/*
+		USAGE: Gets how many leafs left their fat box and were inserted again in the last Update
+		ARGUMENTS: ---
+		OUTPUT: reinsert count
+		*/
+		uint GetReinsertCount(void);
+
+	private:
+		/*
+		USAGE: Takes a node from the freed ones or adds one
+		ARGUMENTS: ---
+		OUTPUT: index of the node
+		*/
+		uint AllocateNode(void);
+		/*
+		USAGE: Hands a node back to be reused
+		ARGUMENTS: uint a_uNode -> index of the node
+		OUTPUT: ---
+		*/
+		void FreeNode(uint a_uNode);
+		/*
+		USAGE: Sets the fat box of the leaf of an Entity from its box
+		ARGUMENTS: uint a_uEntity -> Entity
+		OUTPUT: ---
+		*/
+		void SetFatBox(uint a_uEntity);
+		/*
+		USAGE: Inserts a leaf next to the node whose box grows the least with it, then refits and
+		balances the branches up to the root
+		ARGUMENTS: uint a_uLeaf -> leaf node
+		OUTPUT: ---
+		*/
+		void InsertLeaf(uint a_uLeaf);
+		/*
+		USAGE: Takes a leaf out of the tree, its sibling takes the place of their parent
+		ARGUMENTS: uint a_uLeaf -> leaf node
+		OUTPUT: ---
+		*/
+		void RemoveLeaf(uint a_uLeaf);
+		/*
+		USAGE: Refits and balances the branches from a node up to the root
+		ARGUMENTS: uint a_uNode -> first branch
+		OUTPUT: ---
+		*/
+		void FixUpwards(uint a_uNode);
+		/*
+		USAGE: Rotates the taller grandchild up if the heights of the children of a branch differ by
+		more than 1
+		ARGUMENTS: uint a_uNode -> branch
+		OUTPUT: node in the place of the branch
+		*/
+		uint Balance(uint a_uNode);
+		/*
+		USAGE: Sets the box and height of a branch from its children
+		ARGUMENTS: uint a_uNode -> branch
+		OUTPUT: ---
+		*/
+		void Refit(uint a_uNode);
+		/*
+		USAGE: Finds the pairs of an Entity, skipping the moved Entities before it so pairs of two moved
+		Entities come out once
+		ARGUMENTS: uint a_uEntity -> Entity
+		OUTPUT: ---
+		*/
+		void FindPairs(uint a_uEntity);
+		/*
+		USAGE: Gets the half of the surface area of a box, the cost of a node
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner
+		- vector3 const& a_v3Max -> maximum corner
+		OUTPUT: area
+		*/
+		static float GetArea(vector3 const& a_v3Min, vector3 const& a_v3Max);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYAABBTREEBROADPHASECLASS_H_
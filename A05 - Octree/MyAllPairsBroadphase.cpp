@@ -0,0 +1,42 @@
+#include "MyAllPairsBroadphase.h"
+using namespace Simplex;
+
+String MyAllPairsBroadphase::GetName(void) { return GetTypeName(BROADPHASE_ALLPAIRS); }
+
+void MyAllPairsBroadphase::Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	uint nEntities = a_lMin.size();
+	m_Boxes.Resize(nEntities);
+	for (uint i = 0; i < nEntities; i++)
+		m_Boxes.Set(i, a_lMin[i], a_lMax[i]);
+}
+
+void MyAllPairsBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& a_lMoved)
+{
+	if (a_lMin.size() < m_Boxes.GetCount())
+	{
+		Build(a_lMin, a_lMax);
+		return;
+	}
+
+	m_Boxes.Resize(a_lMin.size());
+	uint nMoved = a_lMoved.size();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = a_lMoved[i];
+		m_Boxes.Set(uEntity, a_lMin[uEntity], a_lMax[uEntity]);
+	}
+}
+
+void MyAllPairsBroadphase::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	uint nEntities = m_Boxes.GetCount();
+	m_lHit.resize(nEntities);
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint nHits = m_Boxes.Overlap(m_Boxes.GetMin(i), m_Boxes.GetMax(i), i + 1, nEntities, m_lHit.data());
+		for (uint j = 0; j < nHits; j++)
+			a_lOutput.push_back(std::make_pair(i, m_lHit[j]));
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef __MYALLPAIRSBROADPHASECLASS_H_
+#define __MYALLPAIRSBROADPHASECLASS_H_
+
+#include "MyBroadphase.h"
+#include "MyBoxArray.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyAllPairsBroadphase : public MyBroadphase
+	{
+		MyBoxArray m_Boxes; //box of each Entity, one list per component
+		std::vector<uint> m_lHit; //Entities overlapping the box being tested
+
+	public:
+		/*
+		USAGE: Gets the name of the broadphase
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		String GetName(void) override;
+		/*
+		USAGE: Keeps a copy of the boxes
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) override;
+		/*
+		USAGE: Copies the boxes that moved
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new
+		OUTPUT: ---
+		*/
+		void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved) override;
+		/*
+		USAGE: Tests every box against every other a few at a time, the reference the other broadphases
+		are checked with
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) override;
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYALLPAIRSBROADPHASECLASS_H_
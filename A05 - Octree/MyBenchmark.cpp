@@ -0,0 +1,1499 @@
+#include "MyBenchmark.h"
+using namespace Simplex;
+
+namespace
+{
+	//allocations made by this thread, the node pool benchmark reads it around each build so a tree
+	//built on another thread meanwhile is not counted
+	thread_local size_t uAllocationCount = 0;
+
+	//octant allocated on its own, as the octree was built before the node pool
+	struct HeapOctant
+	{
+		vector3 v3Center = vector3(0.0f); //center of the octant
+		vector3 v3Min = vector3(0.0f); //minimum corner of the octant
+		vector3 v3Max = vector3(0.0f); //maximum corner of the octant
+		float fSize = 0.0f; //size of the octant
+		uint uLevel = 0; //level of the octant
+		HeapOctant* pChild[8] = {}; //children, all null on a leaf
+		std::vector<uint> lEntity; //Entities overlapping the octant, only leafs keep them
+	};
+
+	//subdivides an octant as MyOctant::Subdivide does on a regular octree, allocating each child,
+	//and returns the octants created below it
+	uint SubdivideHeapOctant(HeapOctant* a_pOctant, std::vector<vector3> const& a_lMin,
+		std::vector<vector3> const& a_lMax, uint a_uMaxLevel, uint a_uIdealCount)
+	{
+		if (a_pOctant->uLevel >= a_uMaxLevel) return 0;
+
+		uint nOctants = 8;
+		float fOffset = a_pOctant->fSize / 4.0f;
+		for (uint i = 0; i < 8; i++)
+		{
+			HeapOctant* pChild = new HeapOctant();
+			a_pOctant->pChild[i] = pChild;
+			pChild->fSize = a_pOctant->fSize / 2.0f;
+			pChild->uLevel = a_pOctant->uLevel + 1;
+			for (uint k = 0; k < 3; k++)
+			{
+				bool bLow = (i >> k & 1) == 0;
+				pChild->v3Center[k] = a_pOctant->v3Center[k] + (bLow ? -fOffset : fOffset);
+				pChild->v3Min[k] = bLow ? a_pOctant->v3Min[k] : a_pOctant->v3Center[k];
+				pChild->v3Max[k] = bLow ? a_pOctant->v3Center[k] : a_pOctant->v3Max[k];
+			}
+
+			for (uint uEntity : a_pOctant->lEntity)
+			{
+				vector3 const& v3Min = a_lMin[uEntity];
+				vector3 const& v3Max = a_lMax[uEntity];
+				if (pChild->v3Max.x < v3Min.x || pChild->v3Min.x > v3Max.x) continue;
+				if (pChild->v3Max.y < v3Min.y || pChild->v3Min.y > v3Max.y) continue;
+				if (pChild->v3Max.z < v3Min.z || pChild->v3Min.z > v3Max.z) continue;
+				pChild->lEntity.push_back(uEntity);
+			}
+		}
+		a_pOctant->lEntity.clear();
+
+		for (uint i = 0; i < 8; i++)
+		{
+			if (a_pOctant->pChild[i]->lEntity.size() > a_uIdealCount)
+				nOctants += SubdivideHeapOctant(a_pOctant->pChild[i], a_lMin, a_lMax, a_uMaxLevel, a_uIdealCount);
+		}
+		return nOctants;
+	}
+
+	//deletes an octant and every octant below it one by one
+	void DeleteHeapOctant(HeapOctant* a_pOctant)
+	{
+		for (uint i = 0; i < 8; i++)
+		{
+			if (a_pOctant->pChild[i] != nullptr)
+				DeleteHeapOctant(a_pOctant->pChild[i]);
+		}
+		delete a_pOctant;
+	}
+}
+
+//every allocation goes through here so the benchmarks can count them
+void* operator new(size_t a_uSize)
+{
+	uAllocationCount++;
+	void* pMemory = std::malloc(a_uSize > 0 ? a_uSize : 1);
+	if (pMemory == nullptr)
+		throw std::bad_alloc();
+	return pMemory;
+}
+
+void operator delete(void* a_pMemory) noexcept { std::free(a_pMemory); }
+void operator delete(void* a_pMemory, size_t) noexcept { std::free(a_pMemory); }
+
+double MyBenchmark::ElapsedMs(Clock::time_point a_tStart)
+{
+	return std::chrono::duration<double, std::milli>(Clock::now() - a_tStart).count();
+}
+
+void MyBenchmark::GenerateBoxes(uint a_uCount, std::vector<vector3>& a_lMin,
+	std::vector<vector3>& a_lMax, uint a_uSeed, bool a_bSurface)
+{
+	//same density as 1849 cubes in a radius of 34
+	float fRadius = 34.0f * std::cbrt(a_uCount / 1849.0f);
+	float fSurfaceRadius = 34.0f * std::sqrt(a_uCount / 1849.0f);
+
+	std::mt19937 generator(a_uSeed);
+	std::uniform_real_distribution<float> distribution(-fRadius, fRadius);
+
+	a_lMin.resize(a_uCount);
+	a_lMax.resize(a_uCount);
+	for (uint i = 0; i < a_uCount; i++)
+	{
+		//reject the points outside of the ball
+		vector3 v3Position;
+		do
+		{
+			v3Position = vector3(distribution(generator), distribution(generator), distribution(generator));
+		} while (glm::length(v3Position) > fRadius || glm::length(v3Position) == 0.0f);
+
+		//same placement as glm::sphericalRand(34.0f) in the application
+		if (a_bSurface)
+			v3Position = glm::normalize(v3Position) * fSurfaceRadius;
+
+		a_lMin[i] = v3Position - vector3(0.5f);
+		a_lMax[i] = v3Position + vector3(0.5f);
+	}
+}
+
+void MyBenchmark::OctreeBuild(void)
+{
+	const uint uIdealCount = 5;
+	const uint uRuns = 3;
+	uint lCount[] = { 1000, 10000, 100000, 1000000 };
+
+	std::cout << "Octree build benchmark (best of " << uRuns << " runs)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+
+		//deep enough for leafs to hold around the ideal count
+		uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(8.0f)));
+
+		double dBest = -1.0;
+		uint uOctants = 0;
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			Clock::time_point tStart = Clock::now();
+			MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+			double dTime = ElapsedMs(tStart);
+			uOctants = pRoot->GetOctantCount();
+			SafeDelete(pRoot);
+
+			if (dBest < 0.0 || dTime < dBest)
+				dBest = dTime;
+		}
+
+		//time per N log N should stay roughly flat
+		double dNLogN = uCount * std::log2(static_cast<double>(uCount));
+		std::cout << "  N: " << uCount << " levels: " << uLevels << " octants: " << uOctants
+			<< " build: " << dBest << " ms (" << dBest * 1000000.0 / dNLogN << " ns per N log N)" << std::endl;
+	}
+}
+
+
+void MyBenchmark::OctreeUpdate(void)
+{
+	const uint uCount = 100000;
+	const uint uLevels = 5;
+	const uint uIdealCount = 5;
+	uint lMoved[] = { 100, 1000, 10000, 100000 };
+
+	std::vector<vector3> lMin;
+	std::vector<vector3> lMax;
+	GenerateBoxes(uCount, lMin, lMax);
+
+	Clock::time_point tStart = Clock::now();
+	MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+	double dRebuild = ElapsedMs(tStart);
+
+	std::cout << "Octree update benchmark (N: " << uCount << ", full rebuild: " << dRebuild << " ms)" << std::endl;
+
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<uint> pick(0, uCount - 1);
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+	for (uint uMoved : lMoved)
+	{
+		//pick the entities and their new place before timing
+		std::vector<uint> lIndex(uMoved);
+		std::vector<vector3> lOffset(uMoved);
+		for (uint i = 0; i < uMoved; i++)
+		{
+			lIndex[i] = pick(generator);
+			lOffset[i] = vector3(offset(generator), offset(generator), offset(generator));
+		}
+
+		tStart = Clock::now();
+		for (uint i = 0; i < uMoved; i++)
+		{
+			uint uEntity = lIndex[i];
+			lMin[uEntity] += lOffset[i];
+			lMax[uEntity] += lOffset[i];
+			pRoot->UpdateEntity(uEntity, lMin[uEntity], lMax[uEntity]);
+		}
+		double dTime = ElapsedMs(tStart);
+
+		std::cout << "  moved: " << uMoved << " update: " << dTime << " ms ("
+			<< dTime * 1000.0 / uMoved << " us per entity)" << std::endl;
+	}
+	SafeDelete(pRoot);
+}
+
+uint MyBenchmark::CountLeafs(MyOctant* a_pOctant, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	if (!a_pOctant->IsColliding(a_v3Min, a_v3Max)) return 0;
+	if (a_pOctant->IsLeaf()) return 1;
+
+	uint nLeafs = 0;
+	for (uint i = 0; i < 8; i++)
+	{
+		nLeafs += CountLeafs(a_pOctant->GetChild(i), a_v3Min, a_v3Max);
+	}
+	return nLeafs;
+}
+
+void MyBenchmark::LinearOctree(void)
+{
+	const uint uIdealCount = 5;
+	const uint uQueries = 100000;
+	uint lCount[] = { 1000, 10000, 100000, 1000000 };
+
+	std::cout << "Pointer vs linear octree benchmark (" << uQueries << " box queries)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+		uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(8.0f)));
+
+		Clock::time_point tStart = Clock::now();
+		MyOctant* pPointer = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+		double dPointerBuild = ElapsedMs(tStart);
+
+		tStart = Clock::now();
+		MyLinearOctree* pLinear = new MyLinearOctree(lMin, lMax, uLevels, uIdealCount);
+		double dLinearBuild = ElapsedMs(tStart);
+
+		//query with the boxes of the scene, spread over all of it
+		uint uStep = std::max(1u, uCount / uQueries);
+		uint nPointerLeafs = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i += uStep)
+		{
+			nPointerLeafs += CountLeafs(pPointer, lMin[i], lMax[i]);
+		}
+		double dPointerQuery = ElapsedMs(tStart);
+
+		uint nLinearLeafs = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i += uStep)
+		{
+			nLinearLeafs += pLinear->CountLeafs(lMin[i], lMax[i]);
+		}
+		double dLinearQuery = ElapsedMs(tStart);
+
+		std::cout << "  N: " << uCount << " levels: " << uLevels << std::endl
+			<< "    pointer octants: " << pPointer->GetOctantCount() << " build: " << dPointerBuild
+			<< " ms query: " << dPointerQuery << " ms (" << nPointerLeafs << " leafs)" << std::endl
+			<< "    linear  octants: " << pLinear->GetOctantCount() << " build: " << dLinearBuild
+			<< " ms query: " << dLinearQuery << " ms (" << nLinearLeafs << " leafs)" << std::endl;
+
+		SafeDelete(pPointer);
+		SafeDelete(pLinear);
+	}
+}
+
+void MyBenchmark::LooseOctree(void)
+{
+	const uint uCount = 1849;
+	const uint uIdealCount = 5;
+	float lLooseness[] = { 0.0f, 1.25f, 2.0f };
+
+	std::vector<vector3> lMin;
+	std::vector<vector3> lMax;
+	GenerateBoxes(uCount, lMin, lMax, 0, true);
+
+	std::cout << "Loose octree benchmark (N: " << uCount << ")" << std::endl;
+	for (uint uLevels = 1; uLevels <= 4; uLevels++)
+	{
+		std::cout << "  levels: " << uLevels << std::endl;
+		for (float fLooseness : lLooseness)
+		{
+			Clock::time_point tStart = Clock::now();
+			MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount, fLooseness);
+			double dBuild = ElapsedMs(tStart);
+
+			//the dimensions a linked tree would give to each cube, sorted as the entities keep them
+			std::vector<std::vector<uint>> lDimension(uCount);
+			uint nDimensions = 0;
+			for (uint i = 0; i < uCount; i++)
+			{
+				pRoot->GetDimensions(lMin[i], lMax[i], lDimension[i]);
+				std::sort(lDimension[i].begin(), lDimension[i].end());
+				nDimensions += lDimension[i].size();
+			}
+
+			//go through the pairs the same way the entity manager does
+			uint nPairs = 0;
+			unsigned long long nComparisons = 0;
+			for (uint i = 0; i < uCount - 1; i++)
+			{
+				for (uint j = i + 1; j < uCount; j++)
+				{
+					bool bShared = false;
+					for (uint a = 0; a < lDimension[i].size() && !bShared; a++)
+					{
+						for (uint b = 0; b < lDimension[j].size() && !bShared; b++)
+						{
+							nComparisons++;
+							bShared = lDimension[i][a] == lDimension[j][b];
+						}
+					}
+					if (bShared)
+						nPairs++;
+				}
+			}
+
+			if (fLooseness > 0.0f)
+				std::cout << "    loose x" << fLooseness << ":";
+			else
+				std::cout << "    regular:   ";
+			std::cout << " build: " << dBuild << " ms duplication: " << pRoot->GetDuplicationFactor()
+				<< " dimensions per cube: " << nDimensions / static_cast<float>(uCount)
+				<< " pairs sharing a dimension: " << nPairs << " dimension comparisons: " << nComparisons << std::endl;
+
+			SafeDelete(pRoot);
+		}
+	}
+}
+
+void MyBenchmark::OctreePairs(void)
+{
+	const uint uIdealCount = 5;
+	const uint uRuns = 5;
+	const uint uBruteForceLimit = 20000;
+	uint lCount[] = { 1849, 5000, 20000, 100000 };
+
+	std::cout << "Octree pairs benchmark (best of " << uRuns << " runs, cubes on a sphere)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax, 0, true);
+
+		//a surface takes 4 times the leafs on each level
+		uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(4.0f)));
+
+		MyOctant* pRegular = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+		MyOctant* pLoose = new MyOctant(lMin, lMax, uLevels, uIdealCount, 2.0f);
+		MyLinearOctree* pLinear = new MyLinearOctree(lMin, lMax, uLevels, uIdealCount);
+
+		std::vector<std::pair<uint, uint>> lPair;
+		double lBest[3] = { -1.0, -1.0, -1.0 };
+		uint lPairs[3] = { 0, 0, 0 };
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			for (uint uTree = 0; uTree < 3; uTree++)
+			{
+				lPair.clear();
+				Clock::time_point tStart = Clock::now();
+				if (uTree == 0)
+					pRegular->GetPairs(lPair);
+				else if (uTree == 1)
+					pLoose->GetPairs(lPair);
+				else
+					pLinear->GetPairs(lPair);
+				double dTime = ElapsedMs(tStart);
+
+				lPairs[uTree] = lPair.size();
+				if (lBest[uTree] < 0.0 || dTime < lBest[uTree])
+					lBest[uTree] = dTime;
+			}
+		}
+
+		std::cout << "  N: " << uCount << " levels: " << uLevels << " pairs: " << lPairs[0] << std::endl
+			<< "    regular: " << lBest[0] << " ms (" << lBest[0] * 1000000.0 / uCount << " ns per cube)" << std::endl
+			<< "    loose:   " << lBest[1] << " ms (" << lBest[1] * 1000000.0 / uCount << " ns per cube)" << std::endl
+			<< "    linear:  " << lBest[2] << " ms (" << lBest[2] * 1000000.0 / uCount << " ns per cube)" << std::endl;
+		if (lPairs[1] != lPairs[0] || lPairs[2] != lPairs[0])
+			std::cout << "    pair counts differ, loose: " << lPairs[1] << " linear: " << lPairs[2] << std::endl;
+
+		//the loop of the entity manager, only where it finishes in reasonable time
+		if (uCount <= uBruteForceLimit)
+		{
+			uint nPairs = 0;
+			Clock::time_point tStart = Clock::now();
+			for (uint i = 0; i < uCount - 1; i++)
+			{
+				for (uint j = i + 1; j < uCount; j++)
+				{
+					if (lMax[i].x < lMin[j].x || lMin[i].x > lMax[j].x) continue;
+					if (lMax[i].y < lMin[j].y || lMin[i].y > lMax[j].y) continue;
+					if (lMax[i].z < lMin[j].z || lMin[i].z > lMax[j].z) continue;
+					nPairs++;
+				}
+			}
+			double dTime = ElapsedMs(tStart);
+			std::cout << "    all pairs: " << dTime << " ms (" << dTime * 1000000.0 / uCount << " ns per cube, "
+				<< nPairs << " pairs)" << std::endl;
+		}
+
+		SafeDelete(pRegular);
+		SafeDelete(pLoose);
+		SafeDelete(pLinear);
+	}
+}
+
+void MyBenchmark::OctreePool(void)
+{
+	const uint uCount = 1849;
+	const uint uIdealCount = 5;
+	const uint uRuns = 100;
+
+	std::vector<vector3> lMin;
+	std::vector<vector3> lMax;
+	GenerateBoxes(uCount, lMin, lMax, 0, true);
+
+	std::cout << "Octree node pool benchmark (N: " << uCount << ", average of " << uRuns << " runs)" << std::endl;
+	for (uint uLevels = 1; uLevels <= 4; uLevels++)
+	{
+		//a new tree allocates its pool, a level change deletes the tree and creates another one
+		uint uOctants = 0;
+		uint uChunks = 0;
+		size_t uAllocationsBefore = uAllocationCount;
+		Clock::time_point tStart = Clock::now();
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+			uOctants = pRoot->GetOctantCount();
+			uChunks = pRoot->GetPoolAllocationCount();
+			SafeDelete(pRoot);
+		}
+		double dNew = ElapsedMs(tStart) / uRuns;
+		size_t uNewAllocations = (uAllocationCount - uAllocationsBefore) / uRuns;
+
+		//a rebuild hands the octants back to the pool at once and takes them again
+		MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount);
+		uAllocationsBefore = uAllocationCount;
+		tStart = Clock::now();
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			pRoot->Rebuild(uLevels, uIdealCount);
+		}
+		double dRebuild = ElapsedMs(tStart) / uRuns;
+		size_t uRebuildAllocations = (uAllocationCount - uAllocationsBefore) / uRuns;
+
+		//the same octants allocated and deleted one by one, in the root volume of the tree
+		HeapOctant root;
+		root.v3Center = pRoot->GetCenterGlobal();
+		root.v3Min = pRoot->GetMinGlobal();
+		root.v3Max = pRoot->GetMaxGlobal();
+		root.fSize = pRoot->GetSize();
+		SafeDelete(pRoot);
+
+		uint uHeapOctants = 0;
+		uAllocationsBefore = uAllocationCount;
+		tStart = Clock::now();
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			root.lEntity.resize(uCount);
+			for (uint i = 0; i < uCount; i++)
+			{
+				root.lEntity[i] = i;
+			}
+			uHeapOctants = 1 + SubdivideHeapOctant(&root, lMin, lMax, uLevels, uIdealCount);
+			for (uint i = 0; i < 8; i++)
+			{
+				if (root.pChild[i] != nullptr)
+					DeleteHeapOctant(root.pChild[i]);
+				root.pChild[i] = nullptr;
+			}
+			std::vector<uint>().swap(root.lEntity);
+		}
+		double dHeap = ElapsedMs(tStart) / uRuns;
+		size_t uHeapAllocations = (uAllocationCount - uAllocationsBefore) / uRuns;
+
+		std::cout << "  levels: " << uLevels << " octants: " << uOctants << std::endl
+			<< "    new/delete: " << dHeap << " ms, " << uHeapAllocations << " allocations per build ("
+			<< uHeapOctants << " octants)" << std::endl
+			<< "    new tree:   " << dNew << " ms, " << uNewAllocations << " allocations per build ("
+			<< uChunks << " node pool chunks)" << std::endl
+			<< "    rebuild:    " << dRebuild << " ms, " << uRebuildAllocations << " allocations per build" << std::endl;
+	}
+}
+void MyBenchmark::ParallelBuild(void)
+{
+	const uint uCount = 1000000;
+	const uint uIdealCount = 5;
+	const uint uRuns = 3;
+
+	std::vector<vector3> lMin;
+	std::vector<vector3> lMax;
+	GenerateBoxes(uCount, lMin, lMax);
+	uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(8.0f)));
+
+	//1, 2, 4... threads and then one per core
+	uint uCores = std::max(std::thread::hardware_concurrency(), 1u);
+	std::vector<uint> lThreads;
+	for (uint uThreads = 1; uThreads < uCores; uThreads *= 2)
+	{
+		lThreads.push_back(uThreads);
+	}
+	lThreads.push_back(uCores);
+
+	std::cout << "Parallel octree build benchmark (N: " << uCount << ", levels: " << uLevels
+		<< ", cores: " << uCores << ", best of " << uRuns << " runs)" << std::endl;
+
+	uint uSerialOctants = 0;
+	double dSerial = 0.0;
+	std::vector<uint> lSerialDimension; //dimensions of every cube one after the other
+	std::vector<uint> lDimension;
+	for (uint uThreads : lThreads)
+	{
+		double dBest = -1.0;
+		MyOctant* pRoot = nullptr;
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			SafeDelete(pRoot);
+			Clock::time_point tStart = Clock::now();
+			pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount, 0.0f, false, uThreads);
+			double dTime = ElapsedMs(tStart);
+			if (dBest < 0.0 || dTime < dBest)
+				dBest = dTime;
+		}
+
+		//the octants a cube gets as dimensions, in the order the tree gives them
+		uint uOctants = pRoot->GetOctantCount();
+		lDimension.clear();
+		for (uint i = 0; i < uCount; i++)
+		{
+			pRoot->GetDimensions(lMin[i], lMax[i], lDimension);
+		}
+		SafeDelete(pRoot);
+
+		if (uThreads == 1)
+		{
+			uSerialOctants = uOctants;
+			dSerial = dBest;
+			lSerialDimension.swap(lDimension);
+		}
+		bool bSame = uOctants == uSerialOctants && (uThreads == 1 || lDimension == lSerialDimension);
+
+		std::cout << "  threads: " << uThreads << " build: " << dBest << " ms speed up: " << dSerial / dBest
+			<< " octants: " << uOctants << (bSame ? " (same as serial)" : " (DIFFERENT FROM SERIAL)") << std::endl;
+	}
+}
+
+void MyBenchmark::RayCast(void)
+{
+	const uint uIdealCount = 5;
+	const uint uRays = 10000;
+	uint lCount[] = { 1849, 100000 };
+
+	std::cout << "Ray cast benchmark (" << uRays << " rays from outside of the scene)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		//the application scene for 1849, a ball for the large one
+		bool bSurface = uCount == 1849;
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax, 0, bSurface);
+		float fRadius = bSurface ? 34.0f : 34.0f * std::cbrt(uCount / 1849.0f);
+		uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(8.0f)));
+
+		//rays start out of the scene and go through a point inside of it
+		std::mt19937 generator(2);
+		std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+		std::vector<vector3> lOrigin(uRays);
+		std::vector<vector3> lDirection(uRays);
+		for (uint i = 0; i < uRays; i++)
+		{
+			vector3 v3Out;
+			do
+			{
+				v3Out = vector3(distribution(generator), distribution(generator), distribution(generator));
+			} while (glm::length(v3Out) == 0.0f);
+			vector3 v3Target = vector3(distribution(generator), distribution(generator), distribution(generator)) * fRadius;
+			lOrigin[i] = glm::normalize(v3Out) * fRadius * 2.0f;
+			lDirection[i] = glm::normalize(v3Target - lOrigin[i]);
+		}
+
+		//every box against every ray, ties go to the smaller index as in the octree
+		Clock::time_point tStart = Clock::now();
+		std::vector<uint> lBrute(uRays);
+		uint nBruteHits = 0;
+		for (uint i = 0; i < uRays; i++)
+		{
+			float fNearest = FLT_MAX;
+			lBrute[i] = uCount;
+			for (uint j = 0; j < uCount; j++)
+			{
+				float fDistance;
+				if (MyOctant::IsRayHitting(lOrigin[i], lDirection[i], lMin[j], lMax[j], fNearest, fDistance) &&
+					(lBrute[i] == uCount || fDistance < fNearest))
+				{
+					fNearest = fDistance;
+					lBrute[i] = j;
+				}
+			}
+			if (lBrute[i] != uCount)
+				nBruteHits++;
+		}
+		double dBrute = ElapsedMs(tStart);
+
+		std::cout << "  N: " << uCount << " hits: " << nBruteHits << std::endl
+			<< "    all boxes:     nearest " << uRays / dBrute * 1000.0 << " rays/s" << std::endl;
+
+		for (float fLooseness : { 0.0f, 2.0f })
+		{
+			MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount, fLooseness);
+
+			tStart = Clock::now();
+			uint nDifferent = 0;
+			for (uint i = 0; i < uRays; i++)
+			{
+				uint uEntity = uCount;
+				float fDistance;
+				pRoot->GetNearestHit(lOrigin[i], lDirection[i], uEntity, fDistance);
+				if (uEntity != lBrute[i])
+					nDifferent++;
+			}
+			double dNearest = ElapsedMs(tStart);
+
+			tStart = Clock::now();
+			uint nAny = 0;
+			for (uint i = 0; i < uRays; i++)
+			{
+				if (pRoot->IsAnyHit(lOrigin[i], lDirection[i]))
+					nAny++;
+			}
+			double dAny = ElapsedMs(tStart);
+			SafeDelete(pRoot);
+
+			std::cout << (fLooseness > 0.0f ? "    loose octree:  " : "    octree:        ")
+				<< "nearest " << uRays / dNearest * 1000.0 << " rays/s (" << dBrute / dNearest << "x, "
+				<< nDifferent << " different), any hit " << uRays / dAny * 1000.0 << " rays/s ("
+				<< nAny << " hits)" << std::endl;
+		}
+	}
+}
+
+void MyBenchmark::SlicedBuild(void)
+{
+	const uint uCount = 1000000;
+	const uint uIdealCount = 5;
+	const double lBudget[] = { 1.0, 2.0, 4.0 };
+	const uint uSliceEntities = 1024; //cubes linked between two looks at the clock, as the link does
+
+	std::vector<vector3> lMin;
+	std::vector<vector3> lMax;
+	GenerateBoxes(uCount, lMin, lMax);
+	uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(8.0f)));
+
+	std::cout << "Sliced octree build benchmark (N: " << uCount << ", levels: " << uLevels << ")" << std::endl;
+
+	std::vector<uint> lFullDimension;
+	std::vector<uint> lDimension;
+	std::vector<uint> lLinkDimension;
+	std::vector<MyDimensionSet> lSet(uCount);
+	for (float fLooseness : { 0.0f, 2.0f })
+	{
+		//the whole tree at once, what a frame would wait for without slicing
+		Clock::time_point tStart = Clock::now();
+		MyOctant* pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount, fLooseness);
+		pRoot->PrepareLink();
+		double dFull = ElapsedMs(tStart);
+		uint uFullOctants = pRoot->GetOctantCount();
+		lFullDimension.clear();
+		for (uint i = 0; i < uCount; i++)
+		{
+			pRoot->GetDimensions(lMin[i], lMax[i], lFullDimension);
+		}
+		SafeDelete(pRoot);
+
+		std::cout << (fLooseness > 0.0f ? "  loose" : "  regular") << " at once: " << dFull << " ms octants: "
+			<< uFullOctants << std::endl;
+
+		for (double dBudget : lBudget)
+		{
+			tStart = Clock::now();
+			pRoot = new MyOctant(lMin, lMax, uLevels, uIdealCount, fLooseness, true);
+			double dSetup = ElapsedMs(tStart);
+
+			uint uFrames = 0;
+			double dLongest = 0.0;
+			double dTotal = dSetup;
+			bool bDone = false;
+			while (!bDone)
+			{
+				tStart = Clock::now();
+				bDone = pRoot->ContinueBuild(dBudget);
+				double dSlice = ElapsedMs(tStart);
+				dLongest = std::max(dLongest, dSlice);
+				dTotal += dSlice;
+				uFrames++;
+			}
+
+			//the link on the main thread: the dimensions of every cube are replaced and then every
+			//cube is checked against its box, sets of its own stand in for the ones of the Entity Manager
+			uint uLinkFrames = 0;
+			double dLinkLongest = 0.0;
+			double dLinkTotal = 0.0;
+			uint uNext = 0;
+			while (uNext < uCount * 2)
+			{
+				tStart = Clock::now();
+				do
+				{
+					uint uEnd = std::min(uNext + uSliceEntities, uNext < uCount ? uCount : uCount * 2);
+					for (; uNext < uEnd; uNext++)
+					{
+						if (uNext >= uCount)
+						{
+							pRoot->UpdateEntity(uNext - uCount, lMin[uNext - uCount], lMax[uNext - uCount]);
+							continue;
+						}
+						lLinkDimension.clear();
+						pRoot->GetLinkDimensions(uNext, lLinkDimension);
+						lSet[uNext].Clear();
+						for (uint uDimension : lLinkDimension)
+							lSet[uNext].Add(uDimension);
+					}
+				} while (uNext < uCount * 2 && ElapsedMs(tStart) < dBudget);
+				double dSlice = ElapsedMs(tStart);
+				dLinkLongest = std::max(dLinkLongest, dSlice);
+				dLinkTotal += dSlice;
+				uLinkFrames++;
+			}
+
+			uint uOctants = pRoot->GetOctantCount();
+			lDimension.clear();
+			for (uint i = 0; i < uCount; i++)
+			{
+				pRoot->GetDimensions(lMin[i], lMax[i], lDimension);
+			}
+			SafeDelete(pRoot);
+			bool bSame = uOctants == uFullOctants && lDimension == lFullDimension;
+
+			std::cout << "    budget: " << dBudget << " ms setup: " << dSetup << " ms frames: " << uFrames
+				<< " longest slice: " << dLongest << " ms total: " << dTotal << " ms"
+				<< (bSame ? " (same as at once)" : " (DIFFERENT FROM AT ONCE)") << std::endl;
+			std::cout << "      link frames: " << uLinkFrames << " longest slice: " << dLinkLongest
+				<< " ms total: " << dLinkTotal << " ms" << std::endl;
+		}
+	}
+}
+
+void MyBenchmark::Broadphases(void)
+{
+	const uint uFrames = 20;
+	const uint uBruteForceLimit = 20000;
+	const float fStep = 0.05f;
+	uint lCount[] = { 1849, 10000, 50000 };
+
+	std::cout << "Broadphase benchmark (" << uFrames << " frames, every cube moves up to " << fStep << " per frame)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lStartMin;
+		std::vector<vector3> lStartMax;
+		GenerateBoxes(uCount, lStartMin, lStartMax);
+		std::vector<uint> lMoved(uCount);
+		for (uint i = 0; i < uCount; i++)
+			lMoved[i] = i;
+
+		std::cout << "  N: " << uCount << std::endl;
+		uint uExpected = 0;
+		for (uint uType = 0; uType < BROADPHASE_COUNT; uType++)
+		{
+			if (uType == BROADPHASE_ALLPAIRS && uCount > uBruteForceLimit)
+				continue;
+
+			//every broadphase sees the same motion
+			std::vector<vector3> lMin = lStartMin;
+			std::vector<vector3> lMax = lStartMax;
+			std::mt19937 generator(uCount);
+			std::uniform_real_distribution<float> distribution(-fStep, fStep);
+
+			MyBroadphase* pBroadphase = MyBroadphase::Create(static_cast<eBROADPHASE>(uType));
+			std::vector<std::pair<uint, uint>> lPair;
+			Clock::time_point tStart = Clock::now();
+			pBroadphase->Build(lMin, lMax);
+			pBroadphase->GetPairs(lPair);
+			double dBuild = ElapsedMs(tStart);
+
+			double dFrames = 0.0;
+			uint uSwaps = 0;
+			for (uint uFrame = 0; uFrame < uFrames; uFrame++)
+			{
+				for (uint i = 0; i < uCount; i++)
+				{
+					vector3 v3Step(distribution(generator), distribution(generator), distribution(generator));
+					lMin[i] += v3Step;
+					lMax[i] += v3Step;
+				}
+
+				lPair.clear();
+				tStart = Clock::now();
+				pBroadphase->Update(lMin, lMax, lMoved);
+				pBroadphase->GetPairs(lPair);
+				dFrames += ElapsedMs(tStart);
+
+				MySweepAndPruneBroadphase* pSweep = dynamic_cast<MySweepAndPruneBroadphase*>(pBroadphase);
+				if (pSweep != nullptr)
+					uSwaps += pSweep->GetSwapCount();
+			}
+
+			std::cout << "    " << pBroadphase->GetName() << ": build " << dBuild << " ms, frame "
+				<< dFrames / uFrames << " ms, pairs " << lPair.size();
+			if (uSwaps > 0)
+				std::cout << ", swaps per frame " << uSwaps / uFrames;
+			std::cout << std::endl;
+
+			if (uExpected == 0)
+				uExpected = lPair.size();
+			else if (lPair.size() != uExpected)
+				std::cout << "    pair count differs from " << uExpected << std::endl;
+			SafeDelete(pBroadphase);
+		}
+	}
+}
+
+void MyBenchmark::HashGrid(void)
+{
+	const uint uIdealCount = 5;
+	const uint uRuns = 5;
+	uint lCount[] = { 1849, 20000, 100000 };
+
+	std::cout << "Hash grid vs octree benchmark (best of " << uRuns << " runs, build and pairs, cubes on a sphere)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax, 0, true);
+
+		//a surface takes 4 times the leafs on each level
+		uint uLevels = static_cast<uint>(std::ceil(std::log(uCount / static_cast<float>(uIdealCount)) / std::log(4.0f)));
+
+		MyHashGridBroadphase serialGrid;
+		MyHashGridBroadphase parallelGrid;
+		parallelGrid.SetThreadCount(0, 1);
+
+		std::vector<std::pair<uint, uint>> lPair;
+		double lBest[3] = { -1.0, -1.0, -1.0 };
+		uint lPairs[3] = { 0, 0, 0 };
+		for (uint uRun = 0; uRun < uRuns; uRun++)
+		{
+			for (uint uMethod = 0; uMethod < 3; uMethod++)
+			{
+				lPair.clear();
+				Clock::time_point tStart = Clock::now();
+				if (uMethod == 0)
+				{
+					MyOctant octree(lMin, lMax, uLevels, uIdealCount);
+					octree.GetPairs(lPair);
+				}
+				else
+				{
+					MyHashGridBroadphase& grid = uMethod == 1 ? serialGrid : parallelGrid;
+					grid.Build(lMin, lMax);
+					grid.GetPairs(lPair);
+				}
+				double dTime = ElapsedMs(tStart);
+
+				lPairs[uMethod] = lPair.size();
+				if (lBest[uMethod] < 0.0 || dTime < lBest[uMethod])
+					lBest[uMethod] = dTime;
+			}
+		}
+
+		const char* lName[] = { "octree:       ", "grid:         ", "grid threads: " };
+		std::cout << "  N: " << uCount << " levels: " << uLevels << " cell: " << serialGrid.GetCellSize()
+			<< " cells: " << serialGrid.GetCellCount() << " pairs: " << lPairs[0] << std::endl;
+		for (uint uMethod = 0; uMethod < 3; uMethod++)
+		{
+			std::cout << "    " << lName[uMethod] << lBest[uMethod] << " ms ("
+				<< lPairs[uMethod] * 1000.0 / lBest[uMethod] << " pairs per second)" << std::endl;
+		}
+		if (lPairs[1] != lPairs[0] || lPairs[2] != lPairs[0])
+			std::cout << "    pair counts differ, grid: " << lPairs[1] << " grid threads: " << lPairs[2] << std::endl;
+	}
+}
+
+void MyBenchmark::MixedSizes(void)
+{
+	const uint uCount = 20000;
+	const uint uFrames = 20;
+	const float fStep = 0.05f;
+
+	//most boxes go from 0.1 to 2 evenly in the exponent, one in a hundred from 10 to 40
+	std::vector<vector3> lStartMin;
+	std::vector<vector3> lStartMax;
+	GenerateBoxes(uCount, lStartMin, lStartMax);
+	std::mt19937 sizeGenerator(1);
+	std::uniform_real_distribution<float> smallExponent(std::log(0.1f), std::log(2.0f));
+	std::uniform_real_distribution<float> largeExponent(std::log(10.0f), std::log(40.0f));
+	for (uint i = 0; i < uCount; i++)
+	{
+		vector3 v3Center = (lStartMin[i] + lStartMax[i]) * 0.5f;
+		float fExponent = i % 100 == 0 ? largeExponent(sizeGenerator) : smallExponent(sizeGenerator);
+		vector3 v3Half = vector3(std::exp(fExponent) * 0.5f);
+		lStartMin[i] = v3Center - v3Half;
+		lStartMax[i] = v3Center + v3Half;
+	}
+
+	std::cout << "Mixed size benchmark (" << uCount << " boxes from 0.1 to 40, a tenth moves up to " << fStep
+		<< " per frame, " << uFrames << " frames)" << std::endl;
+	uint uExpected = 0;
+	for (uint uType = 0; uType < BROADPHASE_COUNT; uType++)
+	{
+		if (uType == BROADPHASE_ALLPAIRS)
+			continue;
+
+		//every broadphase sees the same motion
+		std::vector<vector3> lMin = lStartMin;
+		std::vector<vector3> lMax = lStartMax;
+		std::mt19937 generator(uCount);
+		std::uniform_real_distribution<float> distribution(-fStep, fStep);
+		std::vector<uint> lMoved;
+
+		MyBroadphase* pBroadphase = MyBroadphase::Create(static_cast<eBROADPHASE>(uType));
+		std::vector<std::pair<uint, uint>> lPair;
+		Clock::time_point tStart = Clock::now();
+		pBroadphase->Build(lMin, lMax);
+		pBroadphase->GetPairs(lPair);
+		double dBuild = ElapsedMs(tStart);
+
+		double dFrames = 0.0;
+		uint uReinserts = 0;
+		for (uint uFrame = 0; uFrame < uFrames; uFrame++)
+		{
+			lMoved.clear();
+			for (uint i = uFrame % 10; i < uCount; i += 10)
+			{
+				vector3 v3Step(distribution(generator), distribution(generator), distribution(generator));
+				lMin[i] += v3Step;
+				lMax[i] += v3Step;
+				lMoved.push_back(i);
+			}
+
+			lPair.clear();
+			tStart = Clock::now();
+			pBroadphase->Update(lMin, lMax, lMoved);
+			pBroadphase->GetPairs(lPair);
+			dFrames += ElapsedMs(tStart);
+
+			MyAABBTreeBroadphase* pTree = dynamic_cast<MyAABBTreeBroadphase*>(pBroadphase);
+			if (pTree != nullptr)
+				uReinserts += pTree->GetReinsertCount();
+		}
+
+		std::cout << "  " << pBroadphase->GetName() << ": build " << dBuild << " ms, frame "
+			<< dFrames / uFrames << " ms, pairs " << lPair.size();
+		if (uType == BROADPHASE_AABB_TREE)
+			std::cout << ", reinserted per frame " << uReinserts / uFrames << " of " << lMoved.size();
+		std::cout << std::endl;
+
+		if (uExpected == 0)
+			uExpected = lPair.size();
+		else if (lPair.size() != uExpected)
+			std::cout << "  pair count differs from " << uExpected << std::endl;
+		SafeDelete(pBroadphase);
+	}
+}
+
+void MyBenchmark::BoxKernels(void)
+{
+	const uint lCount[] = { 1849, 5000, 10000 };
+
+	std::cout << "Box kernel benchmark (" << MyBoxArray::GetSimdWidth() << " boxes per instruction)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+		MyBoxArray boxes;
+		boxes.Resize(uCount);
+		for (uint i = 0; i < uCount; i++)
+			boxes.Set(i, lMin[i], lMax[i]);
+		std::vector<uint> lHit(uCount);
+		double dTests = uCount * (uCount - 1.0) / 2.0;
+
+		//the loop the manager used before, one box after the other out of the list of corners
+		uint uPairs = 0;
+		Clock::time_point tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+		{
+			for (uint j = i + 1; j < uCount; j++)
+			{
+				if (lMin[i].x <= lMax[j].x && lMax[i].x >= lMin[j].x &&
+					lMin[i].y <= lMax[j].y && lMax[i].y >= lMin[j].y &&
+					lMin[i].z <= lMax[j].z && lMax[i].z >= lMin[j].z)
+					uPairs++;
+			}
+		}
+		double dList = ElapsedMs(tStart);
+
+		uint uScalarPairs = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+			uScalarPairs += boxes.OverlapScalar(lMin[i], lMax[i], i + 1, uCount, lHit.data());
+		double dScalar = ElapsedMs(tStart);
+
+		uint uSimdPairs = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+			uSimdPairs += boxes.Overlap(lMin[i], lMax[i], i + 1, uCount, lHit.data());
+		double dSimd = ElapsedMs(tStart);
+
+		uint uScalarSpheres = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+		{
+			vector3 v3Center = (lMin[i] + lMax[i]) * 0.5f;
+			float fRadius = glm::length(lMax[i] - lMin[i]) * 0.5f;
+			uScalarSpheres += boxes.OverlapSphereScalar(v3Center, fRadius, i + 1, uCount, lHit.data());
+		}
+		double dSphereScalar = ElapsedMs(tStart);
+
+		uint uSimdSpheres = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+		{
+			vector3 v3Center = (lMin[i] + lMax[i]) * 0.5f;
+			float fRadius = glm::length(lMax[i] - lMin[i]) * 0.5f;
+			uSimdSpheres += boxes.OverlapSphere(v3Center, fRadius, i + 1, uCount, lHit.data());
+		}
+		double dSphereSimd = ElapsedMs(tStart);
+
+		//millions of tests per second
+		std::cout << "  " << uCount << " cubes, " << dTests / 1000000.0 << "M tests: boxes from the list "
+			<< dTests / dList / 1000.0 << " M/s, side by side " << dTests / dScalar / 1000.0 << " M/s, SIMD "
+			<< dTests / dSimd / 1000.0 << " M/s (x" << dScalar / dSimd << "), spheres "
+			<< dTests / dSphereScalar / 1000.0 << " M/s, SIMD " << dTests / dSphereSimd / 1000.0 << " M/s (x"
+			<< dSphereScalar / dSphereSimd << ")" << std::endl;
+		if (uScalarPairs != uPairs || uSimdPairs != uPairs)
+			std::cout << "  box pair counts differ: " << uPairs << ", " << uScalarPairs << ", " << uSimdPairs << std::endl;
+		if (uSimdSpheres != uScalarSpheres)
+			std::cout << "  sphere pair counts differ: " << uScalarSpheres << ", " << uSimdSpheres << std::endl;
+	}
+}
+
+void MyBenchmark::EntityLoad(void)
+{
+	const uint lCount[] = { 1849, 10000, 50000 };
+
+	//a manager of its own keeps the Entities of the application out of it, the model is loaded
+	//before the timings as the application already has it
+	MyEntityManager* pEntityMngr = new MyEntityManager();
+	pEntityMngr->LoadAsset("Minecraft\\Cube.obj");
+
+	std::cout << "Entity load benchmark (cubes added to an empty Entity Manager)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+		std::vector<matrix4> lToWorld(uCount);
+		for (uint i = 0; i < uCount; i++)
+			lToWorld[i] = glm::translate((lMin[i] + lMax[i]) * 0.5f);
+
+		//the list growing one entry at a time, copying every pointer each time, as AddEntity used to;
+		//it grows with the square of the count so the largest scene skips it
+		double dCopy = -1.0;
+		Clock::time_point tStart = Clock::now();
+		if (uCount <= 10000)
+		{
+			MyEntity** pArray = nullptr;
+			for (uint i = 0; i < uCount; i++)
+			{
+				MyEntity** pTemp = new MyEntity*[i + 1];
+				for (uint j = 0; j < i; j++)
+					pTemp[j] = pArray[j];
+				pTemp[i] = nullptr;
+				delete[] pArray;
+				pArray = pTemp;
+			}
+			delete[] pArray;
+			dCopy = ElapsedMs(tStart);
+		}
+
+		tStart = Clock::now();
+		for (uint i = 0; i < uCount; i++)
+		{
+			pEntityMngr->AddEntity("Minecraft\\Cube.obj");
+			pEntityMngr->SetModelMatrix(lToWorld[i]);
+		}
+		double dSingle = ElapsedMs(tStart);
+
+		//removing from random places swaps the last Entity in
+		std::mt19937 generator(uCount);
+		tStart = Clock::now();
+		while (pEntityMngr->GetEntityCount() > 0)
+			pEntityMngr->RemoveEntity(generator() % pEntityMngr->GetEntityCount());
+		double dRemove = ElapsedMs(tStart);
+
+		tStart = Clock::now();
+		uint uAdded = pEntityMngr->AddEntities("Minecraft\\Cube.obj", uCount, lToWorld);
+		double dBulk = ElapsedMs(tStart);
+		while (pEntityMngr->GetEntityCount() > 0)
+			pEntityMngr->RemoveEntity(pEntityMngr->GetEntityCount() - 1);
+		pEntityMngr->ClearMovedList();
+
+		std::cout << "  " << uCount << " cubes: one at a time " << dSingle << " ms, all at once " << dBulk
+			<< " ms (" << uAdded << " added, " << pEntityMngr->GetAssetCount() << " models loaded), removed "
+			<< dRemove << " ms";
+		if (dCopy >= 0.0)
+			std::cout << "; growing by one entry took " << dCopy << " ms for the list alone";
+		std::cout << std::endl;
+	}
+
+	delete pEntityMngr;
+}
+
+void MyBenchmark::EntityLookup(void)
+{
+	const uint lCount[] = { 1849, 10000, 50000 };
+	const uint uLookups = 100000;
+	const uint uLinearLookups = 1000;
+
+	//a manager of its own keeps the Entities of the application out of it and out of the lookups
+	MyEntityManager* pEntityMngr = new MyEntityManager();
+
+	std::cout << "Entity lookup benchmark (" << uLookups << " lookups of random Entities)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		pEntityMngr->AddEntities("Minecraft\\Cube.obj", uCount, std::vector<matrix4>(), "Lookup");
+		std::vector<String> lName(uCount);
+		std::vector<EntityHandle> lHandle(uCount);
+		std::map<String, uint> nameMap;
+		for (uint i = 0; i < uCount; i++)
+		{
+			lName[i] = pEntityMngr->GetUniqueID(i);
+			lHandle[i] = pEntityMngr->GetHandle(i);
+			nameMap[lName[i]] = i;
+		}
+		std::mt19937 generator(uCount);
+		std::vector<uint> lQuery(uLookups);
+		for (uint i = 0; i < uLookups; i++)
+			lQuery[i] = generator() % uCount;
+
+		//the sum of the indices found keeps the lookups from being optimized out and checks them
+		uint64_t uExpected = 0;
+		uint64_t uLinearExpected = 0;
+		for (uint i = 0; i < uLookups; i++)
+		{
+			uExpected += lQuery[i];
+			if (i < uLinearLookups)
+				uLinearExpected += lQuery[i];
+		}
+
+		//comparing every name, as GetEntityIndex used to; it is slow so it does less lookups
+		uint64_t uLinearSum = 0;
+		Clock::time_point tStart = Clock::now();
+		for (uint i = 0; i < uLinearLookups; i++)
+		{
+			for (uint uIndex = 0; uIndex < pEntityMngr->GetEntityCount(); uIndex++)
+			{
+				if (lName[lQuery[i]] == pEntityMngr->GetEntity(uIndex)->GetUniqueID())
+				{
+					uLinearSum += uIndex;
+					break;
+				}
+			}
+		}
+		double dLinear = ElapsedMs(tStart) * 1000000.0 / uLinearLookups;
+
+		uint64_t uMapSum = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uLookups; i++)
+			uMapSum += nameMap.find(lName[lQuery[i]])->second;
+		double dMap = ElapsedMs(tStart) * 1000000.0 / uLookups;
+
+		uint64_t uTableSum = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uLookups; i++)
+			uTableSum += pEntityMngr->GetEntityIndex(lName[lQuery[i]]);
+		double dTable = ElapsedMs(tStart) * 1000000.0 / uLookups;
+
+		uint64_t uHandleSum = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uLookups; i++)
+			uHandleSum += pEntityMngr->GetEntityIndex(lHandle[lQuery[i]]);
+		double dHandle = ElapsedMs(tStart) * 1000000.0 / uLookups;
+
+		std::cout << "  " << uCount << " Entities: every name " << dLinear << " ns, sorted map " << dMap
+			<< " ns, hash table " << dTable << " ns, handle " << dHandle << " ns" << std::endl;
+		if (uLinearSum != uLinearExpected || uMapSum != uExpected || uTableSum != uExpected || uHandleSum != uExpected)
+			std::cout << "  lookups found the wrong Entities" << std::endl;
+
+		while (pEntityMngr->GetEntityCount() > 0)
+			pEntityMngr->RemoveEntity(pEntityMngr->GetEntityCount() - 1);
+		pEntityMngr->ClearMovedList();
+	}
+
+	delete pEntityMngr;
+}
+
+void MyBenchmark::EntityLayout(void)
+{
+	const uint lCount[] = { 1849, 10000, 50000 };
+	const uint uFrames = 20;
+
+	//a manager of its own for each layout keeps the Entities, the layout and the collisions of the
+	//application out of it
+	MyEntityManager* lEntityMngr[2] = { new MyEntityManager(), new MyEntityManager() };
+	lEntityMngr[1]->SetDataOriented(true);
+
+	std::cout << "Entity layout benchmark (" << uFrames << " frames, a tenth of the cubes moving)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+		std::vector<matrix4> lToWorld(uCount);
+		for (uint i = 0; i < uCount; i++)
+			lToWorld[i] = glm::translate((lMin[i] + lMax[i]) * 0.5f);
+		for (uint uLayout = 0; uLayout < 2; uLayout++)
+			lEntityMngr[uLayout]->AddEntities("Minecraft\\Cube.obj", uCount, lToWorld);
+
+		//the pairs overlapping at the start stand in for a broadphase so the frames measure the passes
+		//over the Entities and not the search for pairs
+		MyBoxArray& boxes = lEntityMngr[0]->GetBoxes();
+		std::vector<uint> lHit(uCount);
+		std::vector<std::pair<uint, uint>> lPair;
+		for (uint i = 0; i < uCount; i++)
+		{
+			uint nHits = boxes.Overlap(boxes.GetMin(i), boxes.GetMax(i), i + 1, uCount, lHit.data());
+			for (uint j = 0; j < nHits; j++)
+				lPair.push_back(std::make_pair(i, lHit[j]));
+		}
+
+		//both layouts make the same moves so they end up with the same collisions
+		double dMoveMs[2];
+		double dUpdateMs[2];
+		uint uColliding[2];
+		for (uint uLayout = 0; uLayout < 2; uLayout++)
+		{
+			MyEntityManager* pEntityMngr = lEntityMngr[uLayout];
+			std::mt19937 generator(uCount);
+			dMoveMs[uLayout] = 0.0;
+			dUpdateMs[uLayout] = 0.0;
+			for (uint uFrame = 0; uFrame < uFrames; uFrame++)
+			{
+				Clock::time_point tStart = Clock::now();
+				for (uint i = 0; i < uCount / 10; i++)
+				{
+					uint uEntity = generator() % uCount;
+					pEntityMngr->SetModelMatrix(glm::translate(lToWorld[uEntity], vector3(0.1f * (uFrame + 1))), uEntity);
+				}
+				dMoveMs[uLayout] += ElapsedMs(tStart);
+
+				tStart = Clock::now();
+				pEntityMngr->Update(lPair);
+				dUpdateMs[uLayout] += ElapsedMs(tStart);
+			}
+
+			uColliding[uLayout] = 0;
+			for (uint i = 0; i < uCount; i++)
+			{
+				if (pEntityMngr->IsColliding(i))
+					uColliding[uLayout]++;
+			}
+		}
+
+		std::cout << "  " << uCount << " cubes, " << lPair.size() << " pairs, per frame: Entity objects move " << dMoveMs[0] / uFrames << " ms, update "
+			<< dUpdateMs[0] / uFrames << " ms; data oriented move " << dMoveMs[1] / uFrames << " ms, update "
+			<< dUpdateMs[1] / uFrames << " ms (x" << (dMoveMs[0] + dUpdateMs[0]) / (dMoveMs[1] + dUpdateMs[1])
+			<< ")" << std::endl;
+		if (uColliding[0] != uColliding[1])
+			std::cout << "  colliding cubes differ: " << uColliding[0] << ", " << uColliding[1] << std::endl;
+
+		for (uint uLayout = 0; uLayout < 2; uLayout++)
+		{
+			while (lEntityMngr[uLayout]->GetEntityCount() > 0)
+				lEntityMngr[uLayout]->RemoveEntity(lEntityMngr[uLayout]->GetEntityCount() - 1);
+			lEntityMngr[uLayout]->ClearMovedList();
+		}
+	}
+
+	delete lEntityMngr[0];
+	delete lEntityMngr[1];
+}
+
+void MyBenchmark::DimensionSets(void)
+{
+	const uint lDimensions[] = { 1, 4, 8, 16 };
+	const uint uSets = 10000;
+	const uint uQueries = 1000000;
+
+	std::cout << "Dimension set benchmark (" << uSets << " sets, " << uQueries << " queries)" << std::endl;
+	for (uint uDimensions : lDimensions)
+	{
+		//each set takes its octants from a window of 64 IDs so nearby sets share some
+		std::mt19937 generator(uDimensions);
+		std::vector<uint> lValue(uSets * uDimensions);
+		for (uint i = 0; i < uSets; i++)
+		{
+			uint uBase = generator() % 1024;
+			for (uint j = 0; j < uDimensions; j++)
+				lValue[i * uDimensions + j] = uBase + generator() % 64;
+		}
+		std::vector<std::pair<uint, uint>> lQuery(uQueries);
+		for (uint i = 0; i < uQueries; i++)
+			lQuery[i] = std::make_pair(generator() % uSets, generator() % uSets);
+
+		//an array one entry larger for every insert, sorted each time, as MyEntity::AddDimension used to
+		std::vector<uint*> lArray(uSets, nullptr);
+		std::vector<uint> lArrayCount(uSets, 0);
+		Clock::time_point tStart = Clock::now();
+		for (uint i = 0; i < uSets; i++)
+		{
+			for (uint j = 0; j < uDimensions; j++)
+			{
+				uint uValue = lValue[i * uDimensions + j];
+				uint nCount = lArrayCount[i];
+				if (std::find(lArray[i], lArray[i] + nCount, uValue) != lArray[i] + nCount)
+					continue;
+				uint* pTemp = new uint[nCount + 1];
+				if (lArray[i])
+				{
+					memcpy(pTemp, lArray[i], sizeof(uint) * nCount);
+					delete[] lArray[i];
+				}
+				pTemp[nCount] = uValue;
+				lArray[i] = pTemp;
+				lArrayCount[i] = nCount + 1;
+				std::sort(lArray[i], lArray[i] + nCount + 1);
+			}
+		}
+		double dArrayAdd = ElapsedMs(tStart);
+
+		std::vector<MyDimensionSet> lSet(uSets);
+		tStart = Clock::now();
+		for (uint i = 0; i < uSets; i++)
+		{
+			for (uint j = 0; j < uDimensions; j++)
+				lSet[i].Add(lValue[i * uDimensions + j]);
+		}
+		double dSetAdd = ElapsedMs(tStart);
+
+		uint uArrayShared = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uQueries; i++)
+		{
+			uint* pA = lArray[lQuery[i].first];
+			uint* pB = lArray[lQuery[i].second];
+			uint nA = lArrayCount[lQuery[i].first];
+			uint nB = lArrayCount[lQuery[i].second];
+			bool bShared = false;
+			for (uint a = 0; a < nA && !bShared; a++)
+			{
+				for (uint b = 0; b < nB; b++)
+				{
+					if (pA[a] == pB[b])
+					{
+						bShared = true;
+						break;
+					}
+				}
+			}
+			if (bShared)
+				uArrayShared++;
+		}
+		double dArrayShare = ElapsedMs(tStart);
+
+		uint uSetShared = 0;
+		tStart = Clock::now();
+		for (uint i = 0; i < uQueries; i++)
+		{
+			if (lSet[lQuery[i].first].Intersects(lSet[lQuery[i].second]))
+				uSetShared++;
+		}
+		double dSetShare = ElapsedMs(tStart);
+
+		uint uAllocated = 0;
+		for (uint i = 0; i < uSets; i++)
+		{
+			if (lSet[i].IsAllocated())
+				uAllocated++;
+			delete[] lArray[i];
+		}
+
+		double dInserts = static_cast<double>(uSets) * uDimensions;
+		std::cout << "  " << uDimensions << " dimensions: insert " << dArrayAdd * 1000000.0 / dInserts << " ns growing the array, "
+			<< dSetAdd * 1000000.0 / dInserts << " ns in the set (" << uAllocated << " sets allocated); shares "
+			<< uQueries / dArrayShare / 1000.0 << " M/s nested loops, " << uQueries / dSetShare / 1000.0 << " M/s sorted walk (x"
+			<< dArrayShare / dSetShare << ", " << uSetShared << " shared)" << std::endl;
+		if (uArrayShared != uSetShared)
+			std::cout << "  shared counts differ: " << uArrayShared << ", " << uSetShared << std::endl;
+	}
+}
+
+void MyBenchmark::ContactBuffer(void)
+{
+	const uint lCount[] = { 1849, 10000, 25000 };
+	const uint uFrames = 20;
+
+	std::cout << "Contact buffer benchmark (" << uFrames << " frames, cubes three times their size)" << std::endl;
+	for (uint uCount : lCount)
+	{
+		std::vector<vector3> lMin;
+		std::vector<vector3> lMax;
+		GenerateBoxes(uCount, lMin, lMax);
+		MyBoxArray boxes;
+		boxes.Resize(uCount);
+		for (uint i = 0; i < uCount; i++)
+		{
+			vector3 v3Center = (lMin[i] + lMax[i]) * 0.5f;
+			boxes.Set(i, v3Center + (lMin[i] - v3Center) * 3.0f, v3Center + (lMax[i] - v3Center) * 3.0f);
+		}
+		std::vector<uint> lHit(uCount);
+		std::vector<std::pair<uint, uint>> lPair;
+		for (uint i = 0; i < uCount; i++)
+		{
+			uint nHits = boxes.Overlap(boxes.GetMin(i), boxes.GetMax(i), i + 1, uCount, lHit.data());
+			for (uint j = 0; j < nHits; j++)
+				lPair.push_back(std::make_pair(i, lHit[j]));
+		}
+
+		//an array per body one entry larger for every contact, looked through first and deleted every
+		//frame, as the colliding list of the Rigid Body used to
+		std::vector<uint*> lArray(uCount, nullptr);
+		std::vector<uint> lArrayCount(uCount, 0);
+		uint64_t uArrayAllocations = 0;
+		uint64_t uArrayContacts = 0;
+		Clock::time_point tStart = Clock::now();
+		for (uint uFrame = 0; uFrame < uFrames; uFrame++)
+		{
+			for (uint i = 0; i < uCount; i++)
+			{
+				delete[] lArray[i];
+				lArray[i] = nullptr;
+				lArrayCount[i] = 0;
+			}
+			for (std::pair<uint, uint> const& pair : lPair)
+			{
+				uint lBody[2] = { pair.first, pair.second };
+				uint lOther[2] = { pair.second, pair.first };
+				for (uint k = 0; k < 2; k++)
+				{
+					uint uBody = lBody[k];
+					uint nCount = lArrayCount[uBody];
+					if (std::find(lArray[uBody], lArray[uBody] + nCount, lOther[k]) != lArray[uBody] + nCount)
+						continue;
+					uint* pTemp = new uint[nCount + 1];
+					if (lArray[uBody])
+					{
+						memcpy(pTemp, lArray[uBody], sizeof(uint) * nCount);
+						delete[] lArray[uBody];
+					}
+					pTemp[nCount] = lOther[k];
+					lArray[uBody] = pTemp;
+					lArrayCount[uBody] = nCount + 1;
+					uArrayAllocations++;
+				}
+			}
+		}
+		double dArray = ElapsedMs(tStart) / uFrames;
+		for (uint i = 0; i < uCount; i++)
+		{
+			uArrayContacts += lArrayCount[i];
+			delete[] lArray[i];
+		}
+
+		//the buffer keeps its room, it only allocates while it grows in the first frame
+		MyContactBuffer contacts;
+		uint uBufferGrowths = 0;
+		uint64_t uBufferContacts = 0;
+		tStart = Clock::now();
+		for (uint uFrame = 0; uFrame < uFrames; uFrame++)
+		{
+			contacts.Clear();
+			for (std::pair<uint, uint> const& pair : lPair)
+			{
+				uint uCapacity = contacts.GetCapacity();
+				contacts.Add(pair.first, pair.second);
+				if (contacts.GetCapacity() != uCapacity)
+					uBufferGrowths++;
+			}
+			contacts.Build(uCount);
+		}
+		double dBuffer = ElapsedMs(tStart) / uFrames;
+		for (uint i = 0; i < uCount; i++)
+			uBufferContacts += contacts.GetContactCount(i);
+
+		std::cout << "  " << uCount << " cubes, " << lPair.size() << " pairs, per frame: arrays per body " << dArray
+			<< " ms (" << uArrayAllocations / uFrames << " allocations), contact buffer " << dBuffer << " ms (x"
+			<< dArray / dBuffer << ", " << uBufferGrowths << " growths in " << uFrames << " frames)" << std::endl;
+		if (uArrayContacts != uBufferContacts)
+			std::cout << "  contact counts differ: " << uArrayContacts << ", " << uBufferContacts << std::endl;
+	}
+}
@@ -0,0 +1,209 @@
+#ifndef __MYBENCHMARKCLASS_H_
+#define __MYBENCHMARKCLASS_H_
+
+#include "MyOctant.h"
+#include "MyLinearOctree.h"
+#include "MySweepAndPruneBroadphase.h"
+#include "MyHashGridBroadphase.h"
+#include "MyAABBTreeBroadphase.h"
+#include "MyBoxArray.h"
+#include "MyDimensionSet.h"
+#include "MyContactBuffer.h"
+
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <new>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyBenchmark
+	{
+		typedef std::chrono::high_resolution_clock Clock; //clock used for all the timings
+
+	public:
+		/*
+		USAGE: Builds octrees over synthetic scenes of 1k to 1M unit cubes at constant density and
+		prints the build time to the console, the max level grows with the count so that leafs hold
+		about the same number of boxes and the time should scale close to N log N
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void OctreeBuild(void);
+		/*
+		USAGE: Moves a growing number of boxes of a 100k box tree through the incremental update
+		and prints the time next to a full rebuild of the same tree
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void OctreeUpdate(void);
+		/*
+		USAGE: Builds the pointer and the linear octree over the same synthetic scenes and prints
+		build time and the time to walk each of them with a box query
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void LinearOctree(void);
+		/*
+		USAGE: Builds the octree of the 1849 cube scene at every level the application allows and
+		prints the build time and the allocations (counted by operator new) of a tree allocating each
+		octant with new and delete, of a new tree and of a rebuild that reuses the octants of the node pool
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void OctreePool(void);
+		/*
+		USAGE: Builds the regular and the loose octree of the 1849 cube scene and prints how many
+		octants each cube is stored in, how many dimensions it gets, how many pairs share one and
+		how many dimension comparisons SharesDimension goes through in a frame
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void LooseOctree(void);
+		/*
+		USAGE: Finds the overlapping pairs of growing scenes of cubes on a sphere, at the density of
+		the application, with the octrees and with the loop over all pairs and prints the times, the
+		time per cube of the octrees should stay about flat
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void OctreePairs(void);
+		/*
+		USAGE: Builds the octree of a 1M cube scene with 1 thread and then with more up to one per
+		core, prints the build time and speed up of each and checks that the octant count and the
+		dimensions of every cube match the serial build
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ParallelBuild(void);
+		/*
+		USAGE: Casts rays from outside of the 1849 cube scene and a 100k cube scene through the
+		regular and the loose octree and through every box and prints the rays per second of the
+		nearest hit and any hit queries, and how many nearest hits differ from the loop over all boxes
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void RayCast(void);
+		/*
+		USAGE: Builds the regular and the loose octree of a 1M cube scene (and the octants of every
+		cube) at once and then a slice per frame with a few budgets, prints the setup time, the frames
+		and the longest slice of each, then links it a slice per frame the same way and prints those
+		of the link, and checks that the octant count and the dimensions of every cube match the build at once
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void SlicedBuild(void);
+		/*
+		USAGE: Moves every cube of growing scenes a little each frame, as most of them do between
+		frames, and prints the milliseconds per frame of each broadphase updating and finding the
+		pairs, with the endpoint swaps of sweep and prune; the pair counts are checked against the
+		first broadphase
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void Broadphases(void);
+		/*
+		USAGE: Builds the pointer octree and the hash grid, serial and on every core, over the cubes
+		on a sphere of the application and larger ones, finds the pairs with each and prints the
+		milliseconds and the pairs per second of building and finding together
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void HashGrid(void);
+		/*
+		USAGE: Resizes the cubes of a 20k scene to sizes from 0.1 to 2 with 1 in 100 from 10 to 40,
+		moves a tenth of them a little each frame and prints the build and frame milliseconds of each
+		broadphase, with how many leafs the AABB tree inserted again
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void MixedSizes(void);
+		/*
+		USAGE: Tests every cube of growing scenes against the cubes after it, box against box and
+		sphere against sphere, one at a time and with the SIMD kernels of MyBoxArray, and prints the
+		tests per second of each
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void BoxKernels(void);
+		/*
+		USAGE: Adds growing numbers of cube Entities to an Entity Manager of its own one at a time and
+		all at once, removes them from random places and prints the milliseconds of each, next to the
+		time growing the list one entry at a time used to take; the manager of the application is not touched
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void EntityLoad(void);
+		/*
+		USAGE: Adds growing numbers of named cube Entities to an Entity Manager of its own and looks
+		them up by unique ID the way GetEntityIndex used to (comparing every name, and through a sorted
+		map) and through the hash table and the handles, printing the nanoseconds of each lookup; the
+		manager of the application is not touched
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void EntityLookup(void);
+		/*
+		USAGE: Adds growing numbers of cube Entities to two Entity Managers of its own and runs the same
+		frames, moving a tenth of them and updating the pairs that overlapped at the start, with the
+		MyEntity objects as the storage and with the data oriented lists of the manager, printing the
+		milliseconds of each; the layout and the collisions of the application are not touched
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void EntityLayout(void);
+		/*
+		USAGE: Fills sets of 1 to 16 dimensions (octant IDs near each other, as the leafs of an Entity
+		are) growing an array by one entry and sorting it on every insert, as MyEntity used to, and
+		with MyDimensionSet, then asks random pairs of sets if they share one with the nested loops
+		and with the sorted walk, printing the nanoseconds per insert and the queries per second
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void DimensionSets(void);
+		/*
+		USAGE: Finds the colliding pairs of dense scenes (cubes three times their size) and records
+		them every frame in an array per body grown one entry at a time, as the Rigid Body used to, and
+		in MyContactBuffer, printing the milliseconds per frame and the allocations of each
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		static void ContactBuffer(void);
+		/*
+		USAGE: Generates unit cubes spread uniformly inside a ball whose volume grows with the
+		count so the density matches the 1849 cube scene
+		ARGUMENTS:
+		- uint a_uCount -> number of cubes to generate
+		- std::vector<vector3>& a_lMin -> output minimum corner of each cube
+		- std::vector<vector3>& a_lMax -> output maximum corner of each cube
+		- uint a_uSeed = 0 -> seed of the generator, same seed same scene
+		- bool a_bSurface = false -> place the cubes on the surface of a sphere instead, as the
+		application does (radius 34 for 1849 cubes, larger for more to keep the density)
+		OUTPUT: ---
+		*/
+		static void GenerateBoxes(uint a_uCount, std::vector<vector3>& a_lMin,
+			std::vector<vector3>& a_lMax, uint a_uSeed = 0, bool a_bSurface = false);
+		/*
+		USAGE: Gets the milliseconds elapsed since the time point specified
+		ARGUMENTS: Clock::time_point a_tStart -> starting point
+		OUTPUT: elapsed milliseconds
+		*/
+		static double ElapsedMs(Clock::time_point a_tStart);
+
+	private:
+		/*
+		USAGE: Counts the leafs of the pointer octree that overlap the box specified
+		ARGUMENTS:
+		- MyOctant* a_pOctant -> octant to start from
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		OUTPUT: number of leafs
+		*/
+		static uint CountLeafs(MyOctant* a_pOctant, vector3 const& a_v3Min, vector3 const& a_v3Max);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYBENCHMARKCLASS_H_
@@ -0,0 +1,220 @@
+#include "MyBoxArray.h"
+using namespace Simplex;
+
+//the widest instruction set the build targets, picked when compiling (/arch:AVX or -mavx for 8 wide)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define MY_BOX_ARRAY_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MY_BOX_ARRAY_SSE
+#endif
+
+uint MyBoxArray::GetCount(void) { return m_lMinX.size(); }
+
+void MyBoxArray::Resize(uint a_uCount)
+{
+	m_lMinX.resize(a_uCount);
+	m_lMinY.resize(a_uCount);
+	m_lMinZ.resize(a_uCount);
+	m_lMaxX.resize(a_uCount);
+	m_lMaxY.resize(a_uCount);
+	m_lMaxZ.resize(a_uCount);
+	m_lCenterX.resize(a_uCount);
+	m_lCenterY.resize(a_uCount);
+	m_lCenterZ.resize(a_uCount);
+	m_lRadius.resize(a_uCount);
+}
+
+void MyBoxArray::Reserve(uint a_uCapacity)
+{
+	m_lMinX.reserve(a_uCapacity);
+	m_lMinY.reserve(a_uCapacity);
+	m_lMinZ.reserve(a_uCapacity);
+	m_lMaxX.reserve(a_uCapacity);
+	m_lMaxY.reserve(a_uCapacity);
+	m_lMaxZ.reserve(a_uCapacity);
+	m_lCenterX.reserve(a_uCapacity);
+	m_lCenterY.reserve(a_uCapacity);
+	m_lCenterZ.reserve(a_uCapacity);
+	m_lRadius.reserve(a_uCapacity);
+}
+
+void MyBoxArray::Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max, vector3 const& a_v3Center, float a_fRadius)
+{
+	m_lMinX[a_uIndex] = a_v3Min.x;
+	m_lMinY[a_uIndex] = a_v3Min.y;
+	m_lMinZ[a_uIndex] = a_v3Min.z;
+	m_lMaxX[a_uIndex] = a_v3Max.x;
+	m_lMaxY[a_uIndex] = a_v3Max.y;
+	m_lMaxZ[a_uIndex] = a_v3Max.z;
+	m_lCenterX[a_uIndex] = a_v3Center.x;
+	m_lCenterY[a_uIndex] = a_v3Center.y;
+	m_lCenterZ[a_uIndex] = a_v3Center.z;
+	m_lRadius[a_uIndex] = a_fRadius;
+}
+
+void MyBoxArray::Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	Set(a_uIndex, a_v3Min, a_v3Max, (a_v3Min + a_v3Max) * 0.5f, glm::length(a_v3Max - a_v3Min) * 0.5f);
+}
+
+void MyBoxArray::Gather(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax, std::vector<uint> const& a_lIndex)
+{
+	uint nCount = a_lIndex.size();
+	Resize(nCount);
+	for (uint i = 0; i < nCount; i++)
+		Set(i, a_lMin[a_lIndex[i]], a_lMax[a_lIndex[i]]);
+}
+
+vector3 MyBoxArray::GetMin(uint a_uIndex)
+{
+	return vector3(m_lMinX[a_uIndex], m_lMinY[a_uIndex], m_lMinZ[a_uIndex]);
+}
+
+vector3 MyBoxArray::GetMax(uint a_uIndex)
+{
+	return vector3(m_lMaxX[a_uIndex], m_lMaxY[a_uIndex], m_lMaxZ[a_uIndex]);
+}
+
+uint MyBoxArray::Overlap(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uFirst, uint a_uEnd, uint* a_pOutput)
+{
+	uint nCount = 0;
+	uint i = a_uFirst;
+#if defined(MY_BOX_ARRAY_AVX)
+	__m256 vMinX = _mm256_set1_ps(a_v3Min.x);
+	__m256 vMinY = _mm256_set1_ps(a_v3Min.y);
+	__m256 vMinZ = _mm256_set1_ps(a_v3Min.z);
+	__m256 vMaxX = _mm256_set1_ps(a_v3Max.x);
+	__m256 vMaxY = _mm256_set1_ps(a_v3Max.y);
+	__m256 vMaxZ = _mm256_set1_ps(a_v3Max.z);
+	for (; i + 8 <= a_uEnd; i += 8)
+	{
+		//a lane is apart if the other box ends before this one starts or starts after it ends on any axis
+		__m256 vApart = _mm256_or_ps(
+			_mm256_or_ps(
+				_mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_lMaxX[i]), vMinX, _CMP_LT_OQ),
+					_mm256_cmp_ps(_mm256_loadu_ps(&m_lMinX[i]), vMaxX, _CMP_GT_OQ)),
+				_mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_lMaxY[i]), vMinY, _CMP_LT_OQ),
+					_mm256_cmp_ps(_mm256_loadu_ps(&m_lMinY[i]), vMaxY, _CMP_GT_OQ))),
+			_mm256_or_ps(_mm256_cmp_ps(_mm256_loadu_ps(&m_lMaxZ[i]), vMinZ, _CMP_LT_OQ),
+				_mm256_cmp_ps(_mm256_loadu_ps(&m_lMinZ[i]), vMaxZ, _CMP_GT_OQ)));
+		int nMask = ~_mm256_movemask_ps(vApart) & 0xFF;
+		for (uint uLane = 0; nMask != 0; uLane++, nMask >>= 1)
+		{
+			if (nMask & 1)
+				a_pOutput[nCount++] = i + uLane;
+		}
+	}
+#elif defined(MY_BOX_ARRAY_SSE)
+	__m128 vMinX = _mm_set1_ps(a_v3Min.x);
+	__m128 vMinY = _mm_set1_ps(a_v3Min.y);
+	__m128 vMinZ = _mm_set1_ps(a_v3Min.z);
+	__m128 vMaxX = _mm_set1_ps(a_v3Max.x);
+	__m128 vMaxY = _mm_set1_ps(a_v3Max.y);
+	__m128 vMaxZ = _mm_set1_ps(a_v3Max.z);
+	for (; i + 4 <= a_uEnd; i += 4)
+	{
+		//a lane is apart if the other box ends before this one starts or starts after it ends on any axis
+		__m128 vApart = _mm_or_ps(
+			_mm_or_ps(
+				_mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_lMaxX[i]), vMinX), _mm_cmpgt_ps(_mm_loadu_ps(&m_lMinX[i]), vMaxX)),
+				_mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_lMaxY[i]), vMinY), _mm_cmpgt_ps(_mm_loadu_ps(&m_lMinY[i]), vMaxY))),
+			_mm_or_ps(_mm_cmplt_ps(_mm_loadu_ps(&m_lMaxZ[i]), vMinZ), _mm_cmpgt_ps(_mm_loadu_ps(&m_lMinZ[i]), vMaxZ)));
+		int nMask = ~_mm_movemask_ps(vApart) & 0xF;
+		for (uint uLane = 0; nMask != 0; uLane++, nMask >>= 1)
+		{
+			if (nMask & 1)
+				a_pOutput[nCount++] = i + uLane;
+		}
+	}
+#endif
+	//the boxes left over after the last full group
+	return nCount + OverlapScalar(a_v3Min, a_v3Max, i, a_uEnd, a_pOutput + nCount);
+}
+
+uint MyBoxArray::OverlapScalar(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uFirst, uint a_uEnd, uint* a_pOutput)
+{
+	uint nCount = 0;
+	for (uint i = a_uFirst; i < a_uEnd; i++)
+	{
+		if (m_lMaxX[i] < a_v3Min.x || m_lMinX[i] > a_v3Max.x ||
+			m_lMaxY[i] < a_v3Min.y || m_lMinY[i] > a_v3Max.y ||
+			m_lMaxZ[i] < a_v3Min.z || m_lMinZ[i] > a_v3Max.z)
+			continue;
+		a_pOutput[nCount++] = i;
+	}
+	return nCount;
+}
+
+uint MyBoxArray::OverlapSphere(vector3 const& a_v3Center, float a_fRadius, uint a_uFirst, uint a_uEnd, uint* a_pOutput)
+{
+	uint nCount = 0;
+	uint i = a_uFirst;
+#if defined(MY_BOX_ARRAY_AVX)
+	__m256 vCenterX = _mm256_set1_ps(a_v3Center.x);
+	__m256 vCenterY = _mm256_set1_ps(a_v3Center.y);
+	__m256 vCenterZ = _mm256_set1_ps(a_v3Center.z);
+	__m256 vRadius = _mm256_set1_ps(a_fRadius);
+	for (; i + 8 <= a_uEnd; i += 8)
+	{
+		__m256 vX = _mm256_sub_ps(_mm256_loadu_ps(&m_lCenterX[i]), vCenterX);
+		__m256 vY = _mm256_sub_ps(_mm256_loadu_ps(&m_lCenterY[i]), vCenterY);
+		__m256 vZ = _mm256_sub_ps(_mm256_loadu_ps(&m_lCenterZ[i]), vCenterZ);
+		__m256 vDistance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vX, vX), _mm256_mul_ps(vY, vY)), _mm256_mul_ps(vZ, vZ));
+		__m256 vSum = _mm256_add_ps(_mm256_loadu_ps(&m_lRadius[i]), vRadius);
+		int nMask = _mm256_movemask_ps(_mm256_cmp_ps(vDistance, _mm256_mul_ps(vSum, vSum), _CMP_LE_OQ));
+		for (uint uLane = 0; nMask != 0; uLane++, nMask >>= 1)
+		{
+			if (nMask & 1)
+				a_pOutput[nCount++] = i + uLane;
+		}
+	}
+#elif defined(MY_BOX_ARRAY_SSE)
+	__m128 vCenterX = _mm_set1_ps(a_v3Center.x);
+	__m128 vCenterY = _mm_set1_ps(a_v3Center.y);
+	__m128 vCenterZ = _mm_set1_ps(a_v3Center.z);
+	__m128 vRadius = _mm_set1_ps(a_fRadius);
+	for (; i + 4 <= a_uEnd; i += 4)
+	{
+		__m128 vX = _mm_sub_ps(_mm_loadu_ps(&m_lCenterX[i]), vCenterX);
+		__m128 vY = _mm_sub_ps(_mm_loadu_ps(&m_lCenterY[i]), vCenterY);
+		__m128 vZ = _mm_sub_ps(_mm_loadu_ps(&m_lCenterZ[i]), vCenterZ);
+		__m128 vDistance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vX, vX), _mm_mul_ps(vY, vY)), _mm_mul_ps(vZ, vZ));
+		__m128 vSum = _mm_add_ps(_mm_loadu_ps(&m_lRadius[i]), vRadius);
+		int nMask = _mm_movemask_ps(_mm_cmple_ps(vDistance, _mm_mul_ps(vSum, vSum)));
+		for (uint uLane = 0; nMask != 0; uLane++, nMask >>= 1)
+		{
+			if (nMask & 1)
+				a_pOutput[nCount++] = i + uLane;
+		}
+	}
+#endif
+	return nCount + OverlapSphereScalar(a_v3Center, a_fRadius, i, a_uEnd, a_pOutput + nCount);
+}
+
+uint MyBoxArray::OverlapSphereScalar(vector3 const& a_v3Center, float a_fRadius, uint a_uFirst, uint a_uEnd, uint* a_pOutput)
+{
+	uint nCount = 0;
+	for (uint i = a_uFirst; i < a_uEnd; i++)
+	{
+		float fX = m_lCenterX[i] - a_v3Center.x;
+		float fY = m_lCenterY[i] - a_v3Center.y;
+		float fZ = m_lCenterZ[i] - a_v3Center.z;
+		float fSum = m_lRadius[i] + a_fRadius;
+		if (fX * fX + fY * fY + fZ * fZ <= fSum * fSum)
+			a_pOutput[nCount++] = i;
+	}
+	return nCount;
+}
+
+uint MyBoxArray::GetSimdWidth(void)
+{
+#if defined(MY_BOX_ARRAY_AVX)
+	return 8;
+#elif defined(MY_BOX_ARRAY_SSE)
+	return 4;
+#else
+	return 1;
+#endif
+}
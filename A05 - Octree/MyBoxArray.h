@@ -0,0 +1,130 @@
+#ifndef __MYBOXARRAYCLASS_H_
+#define __MYBOXARRAYCLASS_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyBoxArray
+	{
+		//each component in its own list so 4 (SSE) or 8 (AVX) boxes load at once
+		std::vector<float> m_lMinX; //minimum x of each box
+		std::vector<float> m_lMinY; //minimum y of each box
+		std::vector<float> m_lMinZ; //minimum z of each box
+		std::vector<float> m_lMaxX; //maximum x of each box
+		std::vector<float> m_lMaxY; //maximum y of each box
+		std::vector<float> m_lMaxZ; //maximum z of each box
+		std::vector<float> m_lCenterX; //x of the center of the bounding sphere of each box
+		std::vector<float> m_lCenterY; //y of the center of the bounding sphere of each box
+		std::vector<float> m_lCenterZ; //z of the center of the bounding sphere of each box
+		std::vector<float> m_lRadius; //radius of the bounding sphere of each box
+
+	public:
+		/*
+		USAGE: Gets the number of boxes
+		ARGUMENTS: ---
+		OUTPUT: box count
+		*/
+		uint GetCount(void);
+		/*
+		USAGE: Sets the number of boxes, new ones are empty
+		ARGUMENTS: uint a_uCount -> number of boxes
+		OUTPUT: ---
+		*/
+		void Resize(uint a_uCount);
+		/*
+		USAGE: Makes room for a number of boxes so resizing up to that many does not move them
+		ARGUMENTS: uint a_uCapacity -> number of boxes
+		OUTPUT: ---
+		*/
+		void Reserve(uint a_uCapacity);
+		/*
+		USAGE: Sets a box and its bounding sphere
+		ARGUMENTS:
+		- uint a_uIndex -> index of the box
+		- vector3 const& a_v3Min -> minimum corner
+		- vector3 const& a_v3Max -> maximum corner
+		- vector3 const& a_v3Center -> center of the bounding sphere
+		- float a_fRadius -> radius of the bounding sphere
+		OUTPUT: ---
+		*/
+		void Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max, vector3 const& a_v3Center, float a_fRadius);
+		/*
+		USAGE: Sets a box, the bounding sphere goes through its corners
+		ARGUMENTS:
+		- uint a_uIndex -> index of the box
+		- vector3 const& a_v3Min -> minimum corner
+		- vector3 const& a_v3Max -> maximum corner
+		OUTPUT: ---
+		*/
+		void Set(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Copies the boxes of some Entities one after the other, the box at i is the one of the
+		i-th index of the list
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lIndex -> Entities to copy
+		OUTPUT: ---
+		*/
+		void Gather(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax, std::vector<uint> const& a_lIndex);
+		/*
+		USAGE: Gets the minimum corner of a box
+		ARGUMENTS: uint a_uIndex -> index of the box
+		OUTPUT: minimum corner
+		*/
+		vector3 GetMin(uint a_uIndex);
+		/*
+		USAGE: Gets the maximum corner of a box
+		ARGUMENTS: uint a_uIndex -> index of the box
+		OUTPUT: maximum corner
+		*/
+		vector3 GetMax(uint a_uIndex);
+		/*
+		USAGE: Finds the boxes in a range that overlap a box, touching counts; tests 8 boxes per
+		instruction with AVX, 4 with SSE and one at a time without either
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		- uint a_uFirst -> first box of the range
+		- uint a_uEnd -> one past the last box of the range
+		- uint* a_pOutput -> indices of the boxes overlapping, room for the whole range
+		OUTPUT: number of boxes overlapping
+		*/
+		uint Overlap(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uFirst, uint a_uEnd, uint* a_pOutput);
+		/*
+		USAGE: Same as Overlap, one box at a time
+		ARGUMENTS: see Overlap
+		OUTPUT: number of boxes overlapping
+		*/
+		uint OverlapScalar(vector3 const& a_v3Min, vector3 const& a_v3Max, uint a_uFirst, uint a_uEnd, uint* a_pOutput);
+		/*
+		USAGE: Finds the bounding spheres in a range that overlap a sphere, touching counts
+		ARGUMENTS:
+		- vector3 const& a_v3Center -> center of the sphere
+		- float a_fRadius -> radius of the sphere
+		- uint a_uFirst -> first sphere of the range
+		- uint a_uEnd -> one past the last sphere of the range
+		- uint* a_pOutput -> indices of the spheres overlapping, room for the whole range
+		OUTPUT: number of spheres overlapping
+		*/
+		uint OverlapSphere(vector3 const& a_v3Center, float a_fRadius, uint a_uFirst, uint a_uEnd, uint* a_pOutput);
+		/*
+		USAGE: Same as OverlapSphere, one sphere at a time
+		ARGUMENTS: see OverlapSphere
+		OUTPUT: number of spheres overlapping
+		*/
+		uint OverlapSphereScalar(vector3 const& a_v3Center, float a_fRadius, uint a_uFirst, uint a_uEnd, uint* a_pOutput);
+		/*
+		USAGE: Gets how many boxes the kernels test per instruction in this build
+		ARGUMENTS: ---
+		OUTPUT: 8 with AVX, 4 with SSE, 1 without
+		*/
+		static uint GetSimdWidth(void);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYBOXARRAYCLASS_H_
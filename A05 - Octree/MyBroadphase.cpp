@@ -0,0 +1,71 @@
+#include "MyBroadphase.h"
+#include "MyAllPairsBroadphase.h"
+#include "MyOctreeBroadphase.h"
+#include "MySweepAndPruneBroadphase.h"
+#include "MyHashGridBroadphase.h"
+#include "MyAABBTreeBroadphase.h"
+using namespace Simplex;
+
+MyBroadphase::~MyBroadphase(void) {}
+
+void MyBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& /*a_lMoved*/)
+{
+	//broadphases without an incremental update build again over every box
+	Build(a_lMin, a_lMax);
+}
+
+MyBroadphase* MyBroadphase::Create(eBROADPHASE a_eType)
+{
+	switch (a_eType)
+	{
+	case BROADPHASE_OCTREE:
+	case BROADPHASE_LOOSE_OCTREE:
+	case BROADPHASE_LINEAR_OCTREE:
+		return new MyOctreeBroadphase(a_eType);
+	case BROADPHASE_SAP:
+		return new MySweepAndPruneBroadphase(3);
+	case BROADPHASE_SAP_X:
+		return new MySweepAndPruneBroadphase(1);
+	case BROADPHASE_HASH_GRID:
+		return new MyHashGridBroadphase();
+	case BROADPHASE_AABB_TREE:
+		return new MyAABBTreeBroadphase();
+	default:
+		return new MyAllPairsBroadphase();
+	}
+}
+
+const char* MyBroadphase::GetTypeName(eBROADPHASE a_eType)
+{
+	switch (a_eType)
+	{
+	case BROADPHASE_ALLPAIRS:
+		return "All pairs";
+	case BROADPHASE_OCTREE:
+		return "Octree";
+	case BROADPHASE_LOOSE_OCTREE:
+		return "Loose octree";
+	case BROADPHASE_LINEAR_OCTREE:
+		return "Linear octree";
+	case BROADPHASE_SAP:
+		return "Sweep and prune (3 axes)";
+	case BROADPHASE_SAP_X:
+		return "Sweep and prune (x)";
+	case BROADPHASE_HASH_GRID:
+		return "Hash grid";
+	case BROADPHASE_AABB_TREE:
+		return "AABB tree";
+	default:
+		return "Unknown";
+	}
+}
+
+bool MyBroadphase::IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+	vector3 const& a_v3MinB, vector3 const& a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x) return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y) return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z) return false;
+	return true;
+}
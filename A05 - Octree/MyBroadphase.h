@@ -0,0 +1,93 @@
+#ifndef __MYBROADPHASECLASS_H_
+#define __MYBROADPHASECLASS_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+	//Broadphases the Entity Manager can use
+	enum eBROADPHASE
+	{
+		BROADPHASE_ALLPAIRS, //every box against every other
+		BROADPHASE_OCTREE, //regular pointer octree
+		BROADPHASE_LOOSE_OCTREE, //loose pointer octree
+		BROADPHASE_LINEAR_OCTREE, //linear octree, rebuilt when something moves
+		BROADPHASE_SAP, //sweep and prune sorting the three axes, overlaps tracked from the swaps
+		BROADPHASE_SAP_X, //sweep and prune sorting x, the sweep tests the other axes
+		BROADPHASE_HASH_GRID, //hash grid of cells about the size of the boxes, filled again every frame
+		BROADPHASE_AABB_TREE, //dynamic tree of fat boxes, a box is inserted again once it leaves its fat box
+		BROADPHASE_COUNT //number of broadphases
+	};
+
+	//System Class
+	class MyBroadphase
+	{
+	public:
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		virtual ~MyBroadphase(void);
+		/*
+		USAGE: Gets the name of the broadphase, to show it
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		virtual String GetName(void) = 0;
+		/*
+		USAGE: Throws away what the broadphase knows and builds it again around the boxes
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		virtual void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) = 0;
+		/*
+		USAGE: Brings the broadphase up to date after some boxes moved or Entities were added past the
+		ones it knows; builds it again unless the broadphase has something better
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new since the
+		last call, each once and in increasing order
+		OUTPUT: ---
+		*/
+		virtual void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved);
+		/*
+		USAGE: Finds the pairs of Entities whose boxes overlap, each pair once with the smaller index first
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		virtual void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) = 0;
+
+		/*
+		USAGE: Creates a broadphase of the type specified
+		ARGUMENTS: eBROADPHASE a_eType -> type of broadphase
+		OUTPUT: new broadphase, owned by the caller
+		*/
+		static MyBroadphase* Create(eBROADPHASE a_eType);
+		/*
+		USAGE: Gets the name of a type of broadphase without creating one
+		ARGUMENTS: eBROADPHASE a_eType -> type of broadphase
+		OUTPUT: name
+		*/
+		static const char* GetTypeName(eBROADPHASE a_eType);
+		/*
+		USAGE: Asks if two boxes overlap, touching counts
+		ARGUMENTS:
+		- vector3 const& a_v3MinA -> minimum corner of the first box
+		- vector3 const& a_v3MaxA -> maximum corner of the first box
+		- vector3 const& a_v3MinB -> minimum corner of the second box
+		- vector3 const& a_v3MaxB -> maximum corner of the second box
+		OUTPUT: do they overlap?
+		*/
+		static bool IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+			vector3 const& a_v3MinB, vector3 const& a_v3MaxB);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYBROADPHASECLASS_H_
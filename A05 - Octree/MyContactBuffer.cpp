@@ -0,0 +1,57 @@
+#include "MyContactBuffer.h"
+using namespace Simplex;
+
+void MyContactBuffer::Clear(void)
+{
+	m_lPair.clear();
+	m_lStart.clear();
+	m_lContact.clear();
+}
+
+void MyContactBuffer::Add(uint a_uA, uint a_uB) { m_lPair.push_back(std::make_pair(a_uA, a_uB)); }
+
+void MyContactBuffer::Build(uint a_uBodyCount)
+{
+	//count the contacts of each body, turn the counts into starts and place each pair on both sides
+	m_lStart.assign(a_uBodyCount + 1, 0);
+	for (std::pair<uint, uint> const& pair : m_lPair)
+	{
+		m_lStart[pair.first + 1]++;
+		m_lStart[pair.second + 1]++;
+	}
+	for (uint i = 0; i < a_uBodyCount; i++)
+	{
+		m_lStart[i + 1] += m_lStart[i];
+	}
+
+	m_lContact.resize(m_lPair.size() * 2);
+	for (std::pair<uint, uint> const& pair : m_lPair)
+	{
+		//the start moves forward as the body is filled and is moved back after
+		m_lContact[m_lStart[pair.first]++] = pair.second;
+		m_lContact[m_lStart[pair.second]++] = pair.first;
+	}
+	for (uint i = a_uBodyCount; i > 0; i--)
+	{
+		m_lStart[i] = m_lStart[i - 1];
+	}
+	m_lStart[0] = 0;
+}
+
+std::vector<std::pair<uint, uint>> const& MyContactBuffer::GetPairs(void) { return m_lPair; }
+
+uint MyContactBuffer::GetContactCount(uint a_uBody)
+{
+	if (a_uBody + 1 >= m_lStart.size())
+		return 0;
+	return m_lStart[a_uBody + 1] - m_lStart[a_uBody];
+}
+
+uint const* MyContactBuffer::GetContacts(uint a_uBody)
+{
+	if (a_uBody + 1 >= m_lStart.size())
+		return nullptr;
+	return m_lContact.data() + m_lStart[a_uBody];
+}
+
+uint MyContactBuffer::GetCapacity(void) { return m_lPair.capacity(); }
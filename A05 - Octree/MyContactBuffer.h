@@ -0,0 +1,66 @@
+#ifndef __MYCONTACTBUFFERCLASS_H_
+#define __MYCONTACTBUFFERCLASS_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyContactBuffer
+	{
+		//the lists are cleared every frame and keep their room, after the first frames nothing is allocated
+		std::vector<std::pair<uint, uint>> m_lPair; //pairs of bodies in contact this frame
+		std::vector<uint> m_lStart; //first entry of each body in the contact list, one more than the bodies
+		std::vector<uint> m_lContact; //bodies each body is in contact with, one after the other
+
+	public:
+		/*
+		USAGE: Takes the contacts of the last frame out, the room is kept
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Clear(void);
+		/*
+		USAGE: Adds a contact between two bodies, each pair is added once
+		ARGUMENTS:
+		- uint a_uA -> index of a body
+		- uint a_uB -> index of the other body
+		OUTPUT: ---
+		*/
+		void Add(uint a_uA, uint a_uB);
+		/*
+		USAGE: Sorts the pairs added by body so the contacts of each one can be asked for
+		ARGUMENTS: uint a_uBodyCount -> number of bodies, larger than every index added
+		OUTPUT: ---
+		*/
+		void Build(uint a_uBodyCount);
+		/*
+		USAGE: Gets the pairs added since the buffer was cleared
+		ARGUMENTS: ---
+		OUTPUT: pairs of body indices
+		*/
+		std::vector<std::pair<uint, uint>> const& GetPairs(void);
+		/*
+		USAGE: Gets the number of bodies a body is in contact with, after Build
+		ARGUMENTS: uint a_uBody -> index of the body
+		OUTPUT: contact count
+		*/
+		uint GetContactCount(uint a_uBody);
+		/*
+		USAGE: Gets the bodies a body is in contact with, after Build; valid until the next Build
+		ARGUMENTS: uint a_uBody -> index of the body
+		OUTPUT: first of GetContactCount body indices
+		*/
+		uint const* GetContacts(uint a_uBody);
+		/*
+		USAGE: Gets the number of pairs the buffer has room for without allocating
+		ARGUMENTS: ---
+		OUTPUT: capacity
+		*/
+		uint GetCapacity(void);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYCONTACTBUFFERCLASS_H_
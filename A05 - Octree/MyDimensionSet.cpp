@@ -0,0 +1,121 @@
+#include "MyDimensionSet.h"
+using namespace Simplex;
+const uint MyDimensionSet::m_uInlineCount;
+
+MyDimensionSet::MyDimensionSet(void) {}
+
+MyDimensionSet::MyDimensionSet(MyDimensionSet const& a_Other)
+{
+	if (a_Other.m_uCount > m_uInlineCount)
+	{
+		m_pHeap = new uint[a_Other.m_uCount];
+		m_uCapacity = a_Other.m_uCount;
+	}
+	std::copy(a_Other.GetData(), a_Other.GetData() + a_Other.m_uCount, GetData());
+	m_uCount = a_Other.m_uCount;
+}
+
+MyDimensionSet& MyDimensionSet::operator=(MyDimensionSet const& a_Other)
+{
+	if (this != &a_Other)
+	{
+		MyDimensionSet temp(a_Other);
+		Swap(temp);
+	}
+	return *this;
+}
+
+MyDimensionSet::~MyDimensionSet(void)
+{
+	delete[] m_pHeap;
+	m_pHeap = nullptr;
+}
+
+void MyDimensionSet::Swap(MyDimensionSet& a_Other)
+{
+	//the inline dimensions are copied, the allocated ones only change hands
+	std::swap(m_lInline, a_Other.m_lInline);
+	std::swap(m_pHeap, a_Other.m_pHeap);
+	std::swap(m_uCount, a_Other.m_uCount);
+	std::swap(m_uCapacity, a_Other.m_uCapacity);
+}
+
+bool MyDimensionSet::Add(uint a_uDimension)
+{
+	uint* pData = GetData();
+	uint* pPlace = std::lower_bound(pData, pData + m_uCount, a_uDimension);
+	if (pPlace != pData + m_uCount && *pPlace == a_uDimension)
+		return false;
+
+	uint uPlace = static_cast<uint>(pPlace - pData);
+	if (m_uCount == m_uCapacity)
+	{
+		//double the room so adding n dimensions allocates about log n times
+		uint* pTemp = new uint[m_uCapacity * 2];
+		std::copy(pData, pData + m_uCount, pTemp);
+		delete[] m_pHeap;
+		m_pHeap = pTemp;
+		m_uCapacity *= 2;
+		pData = m_pHeap;
+	}
+	std::copy_backward(pData + uPlace, pData + m_uCount, pData + m_uCount + 1);
+	pData[uPlace] = a_uDimension;
+	++m_uCount;
+	return true;
+}
+
+bool MyDimensionSet::Remove(uint a_uDimension)
+{
+	uint* pData = GetData();
+	uint* pPlace = std::lower_bound(pData, pData + m_uCount, a_uDimension);
+	if (pPlace == pData + m_uCount || *pPlace != a_uDimension)
+		return false;
+
+	std::copy(pPlace + 1, pData + m_uCount, pPlace);
+	--m_uCount;
+	return true;
+}
+
+void MyDimensionSet::Clear(void) { m_uCount = 0; }
+
+bool MyDimensionSet::Contains(uint a_uDimension) const
+{
+	uint const* pData = GetData();
+	return std::binary_search(pData, pData + m_uCount, a_uDimension);
+}
+
+bool MyDimensionSet::Intersects(MyDimensionSet const& a_Other) const
+{
+	if (m_uCount == 0 || a_Other.m_uCount == 0)
+		return false;
+
+	uint const* pA = GetData();
+	uint const* pB = a_Other.GetData();
+	uint nA = m_uCount;
+	uint nB = a_Other.m_uCount;
+
+	//the smaller one steps forward without a branch, which side moves is a coin toss for the predictor
+	uint i = 0;
+	uint j = 0;
+	while (i < nA && j < nB)
+	{
+		uint uA = pA[i];
+		uint uB = pB[j];
+		if (uA == uB)
+			return true;
+		uint uStep = uA < uB;
+		i += uStep;
+		j += 1 - uStep;
+	}
+	return false;
+}
+
+uint MyDimensionSet::GetCount(void) const { return m_uCount; }
+
+uint MyDimensionSet::Get(uint a_uIndex) const { return GetData()[a_uIndex]; }
+
+bool MyDimensionSet::IsAllocated(void) const { return m_pHeap != nullptr; }
+
+uint* MyDimensionSet::GetData(void) { return m_pHeap != nullptr ? m_pHeap : m_lInline; }
+
+uint const* MyDimensionSet::GetData(void) const { return m_pHeap != nullptr ? m_pHeap : m_lInline; }
@@ -0,0 +1,117 @@
+#ifndef __MYDIMENSIONSETCLASS_H_
+#define __MYDIMENSIONSETCLASS_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyDimensionSet
+	{
+		static const uint m_uInlineCount = 8; //dimensions kept inside the set before it allocates
+
+		uint m_uCount = 0; //number of dimensions in the set
+		uint m_uCapacity = m_uInlineCount; //room of the storage in use
+		uint m_lInline[m_uInlineCount]; //dimensions, sorted, while they fit
+		uint* m_pHeap = nullptr; //dimensions, sorted, once they do not fit; kept when the set is cleared
+
+	public:
+		/*
+		Usage: Constructor, the set is empty
+		Arguments: ---
+		Output: class object instance
+		*/
+		MyDimensionSet(void);
+		/*
+		Usage: Copy Constructor
+		Arguments: class object to copy
+		Output: class object instance
+		*/
+		MyDimensionSet(MyDimensionSet const& a_Other);
+		/*
+		Usage: Copy Assignment Operator
+		Arguments: class object to copy
+		Output: ---
+		*/
+		MyDimensionSet& operator=(MyDimensionSet const& a_Other);
+		/*
+		Usage: Destructor
+		Arguments: ---
+		Output: ---
+		*/
+		~MyDimensionSet(void);
+		/*
+		USAGE: Changes the content of the set with the one of another
+		ARGUMENTS: MyDimensionSet& a_Other -> set to swap content with
+		OUTPUT: ---
+		*/
+		void Swap(MyDimensionSet& a_Other);
+		/*
+		USAGE: Adds a dimension, the ones after it move one place so the set stays sorted
+		ARGUMENTS: uint a_uDimension -> dimension to add
+		OUTPUT: was it added? false if it was already in the set
+		*/
+		bool Add(uint a_uDimension);
+		/*
+		USAGE: Takes a dimension out of the set
+		ARGUMENTS: uint a_uDimension -> dimension to remove
+		OUTPUT: was it removed? false if it was not in the set
+		*/
+		bool Remove(uint a_uDimension);
+		/*
+		USAGE: Takes every dimension out, the room is kept for the next ones
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Clear(void);
+		/*
+		USAGE: Asks if a dimension is in the set
+		ARGUMENTS: uint a_uDimension -> dimension queried
+		OUTPUT: is it?
+		*/
+		bool Contains(uint a_uDimension) const;
+		/*
+		USAGE: Asks if the set has a dimension in common with another, walking both sorted lists
+		once side by side
+		ARGUMENTS: MyDimensionSet const& a_Other -> other set
+		OUTPUT: do they share one?
+		*/
+		bool Intersects(MyDimensionSet const& a_Other) const;
+		/*
+		USAGE: Gets the number of dimensions in the set
+		ARGUMENTS: ---
+		OUTPUT: dimension count
+		*/
+		uint GetCount(void) const;
+		/*
+		USAGE: Gets a dimension of the set, they go from the smallest to the largest
+		ARGUMENTS: uint a_uIndex -> index of the dimension, less than the count
+		OUTPUT: dimension
+		*/
+		uint Get(uint a_uIndex) const;
+		/*
+		USAGE: Asks if the dimensions no longer fit inside the set and were allocated
+		ARGUMENTS: ---
+		OUTPUT: are they?
+		*/
+		bool IsAllocated(void) const;
+
+	private:
+		/*
+		USAGE: Gets the storage in use
+		ARGUMENTS: ---
+		OUTPUT: first dimension
+		*/
+		uint* GetData(void);
+		/*
+		USAGE: Gets the storage in use
+		ARGUMENTS: ---
+		OUTPUT: first dimension
+		*/
+		uint const* GetData(void) const;
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYDIMENSIONSETCLASS_H_
@@ -1,6 +1,6 @@
 #include "MyEntity.h"
 using namespace Simplex;
-std::map<String, MyEntity*> MyEntity::m_IDMap;
+MyIDTable MyEntity::m_IDTable;
 //  Accessors
 matrix4 Simplex::MyEntity::GetModelMatrix(void){ return m_m4ToWorld; }
 void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
@@ -9,13 +9,14 @@ void Simplex::MyEntity::SetModelMatrix(matrix4 a_m4ToWorld)
 		return;
 
 	m_m4ToWorld = a_m4ToWorld;
-	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pRigidBody->SetModelMatrix(m_m4ToWorld);
 }
 Model* Simplex::MyEntity::GetModel(void){return m_pModel;}
 MyRigidBody* Simplex::MyEntity::GetRigidBody(void){	return m_pRigidBody; }
 bool Simplex::MyEntity::IsInitialized(void){ return m_bInMemory; }
 String Simplex::MyEntity::GetUniqueID(void) { return m_sUniqueID; }
+EntityHandle Simplex::MyEntity::GetHandle(void) { return m_Handle; }
+void Simplex::MyEntity::SetHandle(EntityHandle a_Handle) { m_Handle = a_Handle; }
 void Simplex::MyEntity::SetAxisVisible(bool a_bSetAxis) { m_bSetAxis = a_bSetAxis; }
 //  MyEntity
 void Simplex::MyEntity::Init(void)
@@ -25,10 +26,10 @@ void Simplex::MyEntity::Init(void)
 	m_bSetAxis = false;
 	m_pModel = nullptr;
 	m_pRigidBody = nullptr;
-	m_DimensionArray = nullptr;
 	m_m4ToWorld = IDENTITY_M4;
 	m_sUniqueID = "";
-	m_nDimensionCount = 0;
+	m_Handle = EntityHandle();
+	m_DimensionSet.Clear();
 }
 void Simplex::MyEntity::Swap(MyEntity& other)
 {
@@ -39,9 +40,9 @@ void Simplex::MyEntity::Swap(MyEntity& other)
 	std::swap(m_pMeshMngr, other.m_pMeshMngr);
 	std::swap(m_bInMemory, other.m_bInMemory);
 	std::swap(m_sUniqueID, other.m_sUniqueID);
+	std::swap(m_Handle, other.m_Handle);
 	std::swap(m_bSetAxis, other.m_bSetAxis);
-	std::swap(m_nDimensionCount, other.m_nDimensionCount);
-	std::swap(m_DimensionArray, other.m_DimensionArray);
+	m_DimensionSet.Swap(other.m_DimensionSet);
 }
 void Simplex::MyEntity::Release(void)
 {
@@ -49,13 +50,11 @@ void Simplex::MyEntity::Release(void)
 	//it is not the job of the entity to release the model, 
 	//it is for the mesh manager to do so.
 	m_pModel = nullptr;
-	if (m_DimensionArray)
-	{
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
-	}
+	m_DimensionSet.Clear();
 	SafeDelete(m_pRigidBody);
-	m_IDMap.erase(m_sUniqueID);
+	//a copy shares the unique ID, only the entity it points to takes it out
+	if (m_IDTable.Find(m_sUniqueID) == this)
+		m_IDTable.Erase(m_sUniqueID);
 }
 //The big 3
 Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
@@ -68,11 +67,25 @@ Simplex::MyEntity::MyEntity(String a_sFileName, String a_sUniqueID)
 	{
 		GenUniqueID(a_sUniqueID);
 		m_sUniqueID = a_sUniqueID;
-		m_IDMap[a_sUniqueID] = this;
+		m_IDTable.Insert(a_sUniqueID, this);
 		m_pRigidBody = new MyRigidBody(m_pModel->GetVertexList()); //generate a rigid body
 		m_bInMemory = true; //mark this entity as viable
 	}
 }
+Simplex::MyEntity::MyEntity(Model* a_pModel, MyRigidBody* const a_pShape, String a_sUniqueID)
+{
+	Init();
+	m_pModel = a_pModel;
+	//if the model is loaded
+	if (m_pModel != nullptr && m_pModel->GetName() != "")
+	{
+		GenUniqueID(a_sUniqueID);
+		m_sUniqueID = a_sUniqueID;
+		m_IDTable.Insert(a_sUniqueID, this);
+		m_pRigidBody = new MyRigidBody(a_pShape); //take the shape, the vertices are not read again
+		m_bInMemory = true; //mark this entity as viable
+	}
+}
 Simplex::MyEntity::MyEntity(MyEntity const& other)
 {
 	m_bInMemory = other.m_bInMemory;
@@ -83,8 +96,7 @@ Simplex::MyEntity::MyEntity(MyEntity const& other)
 	m_pMeshMngr = other.m_pMeshMngr;
 	m_sUniqueID = other.m_sUniqueID;
 	m_bSetAxis = other.m_bSetAxis;
-	m_nDimensionCount = other.m_nDimensionCount;
-	m_DimensionArray = other.m_DimensionArray;
+	m_DimensionSet = other.m_DimensionSet;
 
 }
 MyEntity& Simplex::MyEntity::operator=(MyEntity const& other)
@@ -106,7 +118,8 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 	if (!m_bInMemory)
 		return;
 
-	//draw model
+	//draw model, other entities can share it so it is placed right before
+	m_pModel->SetModelMatrix(m_m4ToWorld);
 	m_pModel->AddToRenderList();
 	
 	//draw rigid body
@@ -119,9 +132,7 @@ void Simplex::MyEntity::AddToRenderList(bool a_bDrawRigidBody)
 MyEntity* Simplex::MyEntity::GetEntity(String a_sUniqueID)
 {
 	//look the entity based on the unique id
-	auto entity = m_IDMap.find(a_sUniqueID);
-	//if not found return nullptr, if found return it
-	return entity == m_IDMap.end() ? nullptr : entity->second;
+	return m_IDTable.Find(a_sUniqueID);
 }
 void Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
 {
@@ -139,100 +150,38 @@ void Simplex::MyEntity::GenUniqueID(String& a_sUniqueID)
 }
 void Simplex::MyEntity::AddDimension(uint a_uDimension)
 {
-	//we need to check that this dimension is not already allocated in the list
-	if (IsInDimension(a_uDimension))
-		return;//it is, so there is no need to add
-
-	//insert the entry
-	uint* pTemp;
-	pTemp = new uint[m_nDimensionCount + 1];
-	if(m_DimensionArray)
-	{
-		memcpy(pTemp, m_DimensionArray, sizeof(uint) * m_nDimensionCount);
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
-	}
-	pTemp[m_nDimensionCount] = a_uDimension;
-	m_DimensionArray = pTemp;
-
-	++m_nDimensionCount;
-
-	SortDimensions();
+	//the set ignores a dimension it already has and keeps them sorted
+	m_DimensionSet.Add(a_uDimension);
 }
 void Simplex::MyEntity::RemoveDimension(uint a_uDimension)
 {
-	//if there are no dimensions return
-	if (m_nDimensionCount == 0)
-		return;
-
-	//we look one by one if its the one wanted
-	for (uint i = 0; i < m_nDimensionCount; i++)
-	{
-		if (m_DimensionArray[i] == a_uDimension)
-		{
-			//if it is, then we swap it with the last one and then we pop
-			std::swap(m_DimensionArray[i], m_DimensionArray[m_nDimensionCount - 1]);
-			uint* pTemp;
-			pTemp = new uint[m_nDimensionCount - 1];
-			if (m_DimensionArray)
-			{
-				memcpy(pTemp, m_DimensionArray, sizeof(uint) * (m_nDimensionCount-1));
-				delete[] m_DimensionArray;
-				m_DimensionArray = nullptr;
-			}
-			m_DimensionArray = pTemp;
-			
-			--m_nDimensionCount;
-			SortDimensions();
-			return;
-		}
-	}
+	m_DimensionSet.Remove(a_uDimension);
 }
 void Simplex::MyEntity::ClearDimensionSet(void)
 {
-	if (m_DimensionArray)
-	{
-		delete[] m_DimensionArray;
-		m_DimensionArray = nullptr;
-	}
-	m_nDimensionCount = 0;
+	m_DimensionSet.Clear();
 }
 bool Simplex::MyEntity::IsInDimension(uint a_uDimension)
 {
 	//see if the entry is in the set
-	for (uint i = 0; i < m_nDimensionCount; i++)
-	{
-		if (m_DimensionArray[i] == a_uDimension)
-			return true;
-	}
-	return false;
+	return m_DimensionSet.Contains(a_uDimension);
 }
 bool Simplex::MyEntity::SharesDimension(MyEntity* const a_pOther)
 {
-	
 	//special case: if there are no dimensions on either MyEntity
 	//then they live in the special global dimension
-	if (0 == m_nDimensionCount)
+	if (0 == m_DimensionSet.GetCount())
 	{
 		//if no spatial optimization all cases should fall here as every 
 		//entity is by default, under the special global dimension only
-		if(0 == a_pOther->m_nDimensionCount)
+		if (0 == a_pOther->m_DimensionSet.GetCount())
 			return true;
 	}
 
-	//for each dimension on both Entities we check if there is a common dimension
-	for (uint i = 0; i < m_nDimensionCount; ++i)
-	{
-		for (uint j = 0; j < a_pOther->m_nDimensionCount; j++)
-		{
-			if (m_DimensionArray[i] == a_pOther->m_DimensionArray[j])
-				return true; //as soon as we find one we know they share dimensionality
-		}
-	}
-
-	//could not find a common dimension
-	return false;
+	//both sets are sorted so they are walked once side by side
+	return m_DimensionSet.Intersects(a_pOther->m_DimensionSet);
 }
+uint Simplex::MyEntity::GetDimensionCount(void) { return m_DimensionSet.GetCount(); }
 bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 {
 	//if not in memory return
@@ -249,8 +198,4 @@ bool Simplex::MyEntity::IsColliding(MyEntity* const other)
 void Simplex::MyEntity::ClearCollisionList(void)
 {
 	m_pRigidBody->ClearCollidingList();
-}
-void Simplex::MyEntity::SortDimensions(void)
-{
-	std::sort(m_DimensionArray, m_DimensionArray + m_nDimensionCount);
 }
\ No newline at end of file
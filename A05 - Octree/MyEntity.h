@@ -6,10 +6,19 @@ Date: 2017/07
 #define __MYENTITY_H_
 
 #include "MyRigidBody.h"
+#include "MyIDTable.h"
+#include "MyDimensionSet.h"
 
 namespace Simplex
 {
 
+//reference to an entity of the Entity Manager that stays valid while other entities are removed
+struct EntityHandle
+{
+	uint uSlot = 0; //slot in the handle table of the Entity Manager
+	uint uGeneration = 0; //generation of the slot when the handle was given, 0 for no entity
+};
+
 //System Class
 class MyEntity
 {
@@ -17,8 +26,7 @@ class MyEntity
 	bool m_bSetAxis = false; //render axis flag
 	String m_sUniqueID = ""; //Unique identifier name
 
-	uint m_nDimensionCount = 0; //tells how many dimensions this entity lives in
-	uint* m_DimensionArray = nullptr; //Dimensions on which this entity is located
+	MyDimensionSet m_DimensionSet; //Dimensions on which this entity is located, sorted
 
 	Model* m_pModel = nullptr; //Model associated with this MyEntity
 	MyRigidBody* m_pRigidBody = nullptr; //Rigid Body associated with this MyEntity
@@ -26,7 +34,9 @@ class MyEntity
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Model matrix associated with this MyEntity
 	MeshManager* m_pMeshMngr = nullptr; //For rendering shapes
 
-	static std::map<String, MyEntity*> m_IDMap; //a map of the unique ID's
+	EntityHandle m_Handle; //handle the Entity Manager gave this entity, none if it is not in the manager
+
+	static MyIDTable m_IDTable; //a hash table of the unique ID's
 
 public:
 	/*
@@ -38,6 +48,15 @@ public:
 	*/
 	MyEntity(String a_sFileName, String a_sUniqueID = "NA");
 	/*
+	Usage: Constructor that uses a model already loaded, shared with other entities
+	Arguments:
+	-	Model* a_pModel -> loaded model, the entity does not own it
+	-	MyRigidBody* const a_pShape -> Rigid Body of the model in local space, its shape is copied
+	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	Output: class object instance
+	*/
+	MyEntity(Model* a_pModel, MyRigidBody* const a_pShape, String a_sUniqueID = "NA");
+	/*
 	Usage: Copy Constructor
 	Arguments: class object to copy
 	Output: class object instance
@@ -122,6 +141,18 @@ public:
 	*/
 	String GetUniqueID(void);
 	/*
+	USAGE: Gets the handle the Entity Manager gave this entity
+	ARGUMENTS: ---
+	OUTPUT: handle, generation 0 if the entity is not in the manager
+	*/
+	EntityHandle GetHandle(void);
+	/*
+	USAGE: Sets the handle of this entity, done by the Entity Manager
+	ARGUMENTS: EntityHandle a_Handle -> handle
+	OUTPUT: ---
+	*/
+	void SetHandle(EntityHandle a_Handle);
+	/*
 	USAGE: Sets the visibility of the axis of this MyEntity
 	ARGUMENTS: bool a_bSetAxis = true -> axis visible?
 	OUTPUT: ---
@@ -157,20 +188,19 @@ public:
 	OUTPUT: shares at least one dimension?
 	*/
 	bool SharesDimension(MyEntity* const a_pOther);
-
 	/*
-	USAGE: Clears the collision list of this entity
+	USAGE: Gets how many dimensions this entity lives in
 	ARGUMENTS: ---
-	OUTPUT: ---
+	OUTPUT: dimension count
 	*/
-	void ClearCollisionList(void);
+	uint GetDimensionCount(void);
 
 	/*
-	USAGE: Will sort the array of dimensions
+	USAGE: Clears the collision list of this entity
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
-	void SortDimensions(void);
+	void ClearCollisionList(void);
 
 private:
 	/*
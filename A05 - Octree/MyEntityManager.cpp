@@ -5,7 +5,9 @@ Simplex::MyEntityManager* Simplex::MyEntityManager::m_pInstance = nullptr;
 void Simplex::MyEntityManager::Init(void)
 {
 	m_uEntityCount = 0;
+	m_uEntityCapacity = 0;
 	m_mEntityArray = nullptr;
+	m_lMovedList.clear();
 }
 void Simplex::MyEntityManager::Release(void)
 {
@@ -15,7 +17,180 @@ void Simplex::MyEntityManager::Release(void)
 		SafeDelete(pEntity);
 	}
 	m_uEntityCount = 0;
-	m_mEntityArray = nullptr;
+	m_uEntityCapacity = 0;
+	if (m_mEntityArray)
+	{
+		delete[] m_mEntityArray;
+		m_mEntityArray = nullptr;
+	}
+	m_lMovedList.clear();
+	//the models are left to the mesh manager like the entities always did, only the shapes are ours
+	for (auto& asset : m_AssetMap)
+	{
+		SafeDelete(asset.second.pShape);
+	}
+	m_AssetMap.clear();
+	m_lHandleIndex.clear();
+	m_lHandleGeneration.clear();
+	m_uFreeHandle = static_cast<uint>(-1);
+	SafeDelete(m_pBroadphase);
+	m_bBroadphaseBuilt = false;
+	m_lBroadphaseMin.clear();
+	m_lBroadphaseMax.clear();
+	m_lBroadphasePair.clear();
+	m_Boxes.Resize(0);
+	m_lToWorld.clear();
+	m_lLocalMin.clear();
+	m_lLocalMax.clear();
+	m_lLocalCenter.clear();
+	m_lRadius.clear();
+	m_lModel.clear();
+	m_lFlags.clear();
+	m_Contacts.Clear();
+	m_lContactBody.clear();
+}
+void Simplex::MyEntityManager::RefreshBox(uint a_uIndex)
+{
+	MyRigidBody* pRigidBody = m_mEntityArray[a_uIndex]->GetRigidBody();
+	m_Boxes.Set(a_uIndex, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal(),
+		pRigidBody->GetCenterGlobal(), pRigidBody->GetRadius());
+}
+void Simplex::MyEntityManager::TransformBox(uint a_uIndex)
+{
+	matrix4 const& m4ToWorld = m_lToWorld[a_uIndex];
+	vector3 const& v3MinL = m_lLocalMin[a_uIndex];
+	vector3 const& v3MaxL = m_lLocalMax[a_uIndex];
+
+	//the corners go through the same operations as in the Rigid Body so both give the same box
+	vector3 v3Corner[8];
+	v3Corner[0] = v3MinL;
+	v3Corner[1] = vector3(v3MaxL.x, v3MinL.y, v3MinL.z);
+	v3Corner[2] = vector3(v3MinL.x, v3MaxL.y, v3MinL.z);
+	v3Corner[3] = vector3(v3MaxL.x, v3MaxL.y, v3MinL.z);
+	v3Corner[4] = vector3(v3MinL.x, v3MinL.y, v3MaxL.z);
+	v3Corner[5] = vector3(v3MaxL.x, v3MinL.y, v3MaxL.z);
+	v3Corner[6] = vector3(v3MinL.x, v3MaxL.y, v3MaxL.z);
+	v3Corner[7] = v3MaxL;
+	for (uint i = 0; i < 8; ++i)
+	{
+		v3Corner[i] = vector3(m4ToWorld * vector4(v3Corner[i], 1.0f));
+	}
+
+	vector3 v3Min = v3Corner[0];
+	vector3 v3Max = v3Corner[0];
+	for (uint i = 1; i < 8; ++i)
+	{
+		if (v3Max.x < v3Corner[i].x) v3Max.x = v3Corner[i].x;
+		else if (v3Min.x > v3Corner[i].x) v3Min.x = v3Corner[i].x;
+
+		if (v3Max.y < v3Corner[i].y) v3Max.y = v3Corner[i].y;
+		else if (v3Min.y > v3Corner[i].y) v3Min.y = v3Corner[i].y;
+
+		if (v3Max.z < v3Corner[i].z) v3Max.z = v3Corner[i].z;
+		else if (v3Min.z > v3Corner[i].z) v3Min.z = v3Corner[i].z;
+	}
+	m_Boxes.Set(a_uIndex, v3Min, v3Max, vector3(m4ToWorld * vector4(m_lLocalCenter[a_uIndex], 1.0f)), m_lRadius[a_uIndex]);
+}
+void Simplex::MyEntityManager::RefreshEntity(uint a_uIndex)
+{
+	if (m_lFlags[a_uIndex] & ENTITY_STALE)
+	{
+		m_mEntityArray[a_uIndex]->SetModelMatrix(m_lToWorld[a_uIndex]);
+		m_lFlags[a_uIndex] &= ~ENTITY_STALE;
+	}
+}
+void Simplex::MyEntityManager::PushEntityData(uint a_uIndex)
+{
+	MyEntity* pEntity = m_mEntityArray[a_uIndex];
+	MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+	m_lToWorld.push_back(pEntity->GetModelMatrix());
+	m_lLocalMin.push_back(pRigidBody->GetMinLocal());
+	m_lLocalMax.push_back(pRigidBody->GetMaxLocal());
+	m_lLocalCenter.push_back(pRigidBody->GetCenterLocal());
+	m_lRadius.push_back(pRigidBody->GetRadius());
+	m_lModel.push_back(pEntity->GetModel());
+	m_lFlags.push_back(0);
+}
+void Simplex::MyEntityManager::ClearCollisions(void)
+{
+	//with the lists as the entities only the ones that collided have something to clear
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		if (!m_bDataOriented || (m_lFlags[i] & ENTITY_COLLIDING))
+			m_mEntityArray[i]->ClearCollisionList();
+		m_lFlags[i] &= ~ENTITY_COLLIDING;
+	}
+	m_Contacts.Clear();
+}
+void Simplex::MyEntityManager::AddCollision(uint a_uA, uint a_uB)
+{
+	m_Contacts.Add(a_uA, a_uB);
+	m_lFlags[a_uA] |= ENTITY_COLLIDING;
+	m_lFlags[a_uB] |= ENTITY_COLLIDING;
+}
+void Simplex::MyEntityManager::PublishContacts(void)
+{
+	m_Contacts.Build(m_uEntityCount);
+
+	//room for every contact first so the views handed out do not move while the list fills
+	m_lContactBody.clear();
+	m_lContactBody.reserve(m_Contacts.GetPairs().size() * 2);
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		if (!(m_lFlags[i] & ENTITY_COLLIDING))
+			continue;
+
+		uint nContacts = m_Contacts.GetContactCount(i);
+		uint const* pContact = m_Contacts.GetContacts(i);
+		uint uFirst = m_lContactBody.size();
+		for (uint j = 0; j < nContacts; j++)
+		{
+			m_lContactBody.push_back(m_mEntityArray[pContact[j]]->GetRigidBody());
+		}
+		m_mEntityArray[i]->GetRigidBody()->SetCollidingView(m_lContactBody.data() + uFirst, nContacts);
+	}
+}
+void Simplex::MyEntityManager::CollidePairs(std::vector<std::pair<uint, uint>> const& a_lPair)
+{
+	//check collisions of the candidates only, the broadphase already did the work of the dimensions
+	uint nPairs = a_lPair.size();
+	for (uint i = 0; i < nPairs; i++)
+	{
+		uint uA = a_lPair[i].first;
+		uint uB = a_lPair[i].second;
+		if (uA >= m_uEntityCount || uB >= m_uEntityCount)
+			continue;
+
+		vector3 v3MinA = m_Boxes.GetMin(uA);
+		vector3 v3MaxA = m_Boxes.GetMax(uA);
+		vector3 v3MinB = m_Boxes.GetMin(uB);
+		vector3 v3MaxB = m_Boxes.GetMax(uB);
+		if (v3MaxA.x >= v3MinB.x && v3MinA.x <= v3MaxB.x &&
+			v3MaxA.y >= v3MinB.y && v3MinA.y <= v3MaxB.y &&
+			v3MaxA.z >= v3MinB.z && v3MinA.z <= v3MaxB.z)
+			AddCollision(uA, uB);
+	}
+	PublishContacts();
+}
+Simplex::MyEntityManager::Asset* Simplex::MyEntityManager::LoadAsset(String a_sFileName)
+{
+	auto asset = m_AssetMap.find(a_sFileName);
+	if (asset != m_AssetMap.end())
+		return &asset->second;
+
+	Model* pModel = new Model();
+	pModel->Load(a_sFileName);
+	//if the model is not loaded do not keep it, the next entity will try again
+	if (pModel->GetName() == "")
+	{
+		SafeDelete(pModel);
+		return nullptr;
+	}
+
+	Asset& newAsset = m_AssetMap[a_sFileName];
+	newAsset.pModel = pModel;
+	newAsset.pShape = new MyRigidBody(pModel->GetVertexList());
+	return &newAsset;
 }
 Simplex::MyEntityManager* Simplex::MyEntityManager::GetInstance()
 {
@@ -35,17 +210,81 @@ void Simplex::MyEntityManager::ReleaseInstance()
 }
 int Simplex::MyEntityManager::GetEntityIndex(String a_sUniqueID)
 {
-	//look one by one for the specified unique id
-	for (uint uIndex = 0; uIndex < m_uEntityCount; ++uIndex)
+	//the unique id finds the entity and its handle finds the index
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//if not found return -1
+	if (pTemp == nullptr)
+		return -1;
+	return GetEntityIndex(pTemp->GetHandle());
+}
+int Simplex::MyEntityManager::GetEntityIndex(EntityHandle a_Handle)
+{
+	if (!IsValid(a_Handle))
+		return -1;
+	return m_lHandleIndex[a_Handle.uSlot];
+}
+Simplex::EntityHandle Simplex::MyEntityManager::GetHandle(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return EntityHandle();
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return m_mEntityArray[a_uIndex]->GetHandle();
+}
+Simplex::EntityHandle Simplex::MyEntityManager::GetHandle(String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//if the entity exists
+	if (pTemp)
 	{
-		if (a_sUniqueID == m_mEntityArray[uIndex]->GetUniqueID())
-			return uIndex;
+		return pTemp->GetHandle();
 	}
-	//if not found return -1
-	return -1;
+	return EntityHandle();
+}
+bool Simplex::MyEntityManager::IsValid(EntityHandle a_Handle)
+{
+	return a_Handle.uGeneration != 0 && a_Handle.uSlot < m_lHandleGeneration.size() &&
+		m_lHandleGeneration[a_Handle.uSlot] == a_Handle.uGeneration;
+}
+void Simplex::MyEntityManager::NewHandle(uint a_uIndex)
+{
+	uint uSlot = m_uFreeHandle;
+	if (uSlot != static_cast<uint>(-1))
+	{
+		m_uFreeHandle = m_lHandleIndex[uSlot];
+	}
+	else
+	{
+		uSlot = m_lHandleIndex.size();
+		m_lHandleIndex.push_back(0);
+		m_lHandleGeneration.push_back(1);
+	}
+	m_lHandleIndex[uSlot] = a_uIndex;
+
+	EntityHandle handle;
+	handle.uSlot = uSlot;
+	handle.uGeneration = m_lHandleGeneration[uSlot];
+	m_mEntityArray[a_uIndex]->SetHandle(handle);
+}
+void Simplex::MyEntityManager::FreeHandle(uint a_uIndex)
+{
+	uint uSlot = m_mEntityArray[a_uIndex]->GetHandle().uSlot;
+	//generation 0 is no entity, skip it when wrapping around
+	if (++m_lHandleGeneration[uSlot] == 0)
+		m_lHandleGeneration[uSlot] = 1;
+	m_lHandleIndex[uSlot] = m_uFreeHandle;
+	m_uFreeHandle = uSlot;
+	m_mEntityArray[a_uIndex]->SetHandle(EntityHandle());
 }
 //Accessors
 Simplex::uint Simplex::MyEntityManager::GetEntityCount(void) {	return m_uEntityCount; }
+std::vector<Simplex::uint>& Simplex::MyEntityManager::GetMovedList(void) { return m_lMovedList; }
+void Simplex::MyEntityManager::ClearMovedList(void) { m_lMovedList.clear(); }
 Simplex::Model* Simplex::MyEntityManager::GetModel(uint a_uIndex)
 {
 	//if the list is empty return
@@ -79,19 +318,27 @@ Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	RefreshEntity(a_uIndex);
 	return m_mEntityArray[a_uIndex]->GetRigidBody();
 }
 Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//the index is needed to bring the entity up to date
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		return pTemp->GetRigidBody();
+		return GetRigidBody(static_cast<uint>(nIndex));
 	}
 	return nullptr;
 }
+Simplex::MyRigidBody* Simplex::MyEntityManager::GetRigidBody(EntityHandle a_Handle)
+{
+	int nIndex = GetEntityIndex(a_Handle);
+	if (nIndex < 0)
+		return nullptr;
+	return GetRigidBody(static_cast<uint>(nIndex));
+}
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 {
 	//if the list is empty return
@@ -102,27 +349,44 @@ Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	if (m_bDataOriented)
+		return m_lToWorld[a_uIndex];
 	return m_mEntityArray[a_uIndex]->GetModelMatrix();
 }
 Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//Get the index of the entity, the matrix can be in the lists
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		return pTemp->GetModelMatrix();
+		return GetModelMatrix(static_cast<uint>(nIndex));
 	}
 	return IDENTITY_M4;
 }
+Simplex::matrix4 Simplex::MyEntityManager::GetModelMatrix(EntityHandle a_Handle)
+{
+	int nIndex = GetEntityIndex(a_Handle);
+	if (nIndex < 0)
+		return IDENTITY_M4;
+	return GetModelMatrix(static_cast<uint>(nIndex));
+}
+void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, EntityHandle a_Handle)
+{
+	int nIndex = GetEntityIndex(a_Handle);
+	if (nIndex >= 0)
+	{
+		SetModelMatrix(a_m4ToWorld, static_cast<uint>(nIndex));
+	}
+}
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//Get the index of the entity so the move can be tracked
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetModelMatrix(a_m4ToWorld);
+		SetModelMatrix(a_m4ToWorld, static_cast<uint>(nIndex));
 	}
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uIndex)
@@ -135,16 +399,20 @@ void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, uint a_uInd
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	if (a_bVisibility)
+		m_lFlags[a_uIndex] |= ENTITY_AXIS;
+	else
+		m_lFlags[a_uIndex] &= ~ENTITY_AXIS;
 	return m_mEntityArray[a_uIndex]->SetAxisVisible(a_bVisibility);
 }
 void Simplex::MyEntityManager::SetAxisVisibility(bool a_bVisibility, String a_sUniqueID)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//Get the index of the entity, the flag is kept in the lists
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->SetAxisVisible(a_bVisibility);
+		SetAxisVisibility(a_bVisibility, static_cast<uint>(nIndex));
 	}
 }
 void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex)
@@ -157,7 +425,19 @@ void Simplex::MyEntityManager::SetModelMatrix(matrix4 a_m4ToWorld, uint a_uIndex
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
-	m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+	//with the data oriented storage the MyEntity is given the matrix when it is asked for
+	m_lToWorld[a_uIndex] = a_m4ToWorld;
+	if (m_bDataOriented)
+	{
+		TransformBox(a_uIndex);
+		m_lFlags[a_uIndex] |= ENTITY_STALE;
+	}
+	else
+	{
+		m_mEntityArray[a_uIndex]->SetModelMatrix(a_m4ToWorld);
+		RefreshBox(a_uIndex);
+	}
+	m_lMovedList.push_back(a_uIndex);
 }
 //The big 3
 Simplex::MyEntityManager::MyEntityManager(){Init();}
@@ -168,48 +448,241 @@ Simplex::MyEntityManager::~MyEntityManager(){Release();};
 void Simplex::MyEntityManager::Update(void)
 {
 	//Clear all collisions
-	for (uint i = 0; i < m_uEntityCount; i++)
+	ClearCollisions();
+
+	//entities can also be moved through GetEntity, the boxes are taken again before testing; the
+	//data oriented boxes are made when the matrix is set
+	if (!m_bDataOriented)
+	{
+		for (uint i = 0; i < m_uEntityCount; i++)
+		{
+			RefreshBox(i);
+		}
+	}
+
+	//check collisions, the boxes after each one are tested a few at a time and only the overlapping
+	//ones go through the dimensions and the rigid body
+	m_lCandidate.resize(m_uEntityCount);
+	for (uint i = 0; i + 1 < m_uEntityCount; i++)
 	{
-		m_mEntityArray[i]->ClearCollisionList();
+		uint nCandidates = m_Boxes.Overlap(m_Boxes.GetMin(i), m_Boxes.GetMax(i), i + 1, m_uEntityCount, m_lCandidate.data());
+		for (uint j = 0; j < nCandidates; j++)
+		{
+			//the boxes overlap, only the dimensions are left to know it is a collision
+			if (m_mEntityArray[i]->SharesDimension(m_mEntityArray[m_lCandidate[j]]))
+				AddCollision(i, m_lCandidate[j]);
+		}
 	}
+	PublishContacts();
+}
+void Simplex::MyEntityManager::Update(std::vector<std::pair<uint, uint>> const& a_lPair)
+{
+	//Clear all collisions
+	ClearCollisions();
 
-	//check collisions
-	for (uint i = 0; i < m_uEntityCount - 1; i++)
+	//the pairs are tested with the boxes, taken again from the Rigid Bodies unless the lists have them
+	if (!m_bDataOriented)
 	{
-		for (uint j = i + 1; j < m_uEntityCount; j++)
+		for (uint i = 0; i < m_uEntityCount; i++)
 		{
-			m_mEntityArray[i]->IsColliding(m_mEntityArray[j]);
+			RefreshBox(i);
 		}
 	}
+	CollidePairs(a_lPair);
 }
-void Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
+void Simplex::MyEntityManager::SetBroadphase(MyBroadphase* a_pBroadphase)
 {
+	if (m_pBroadphase == a_pBroadphase)
+		return;
+
+	SafeDelete(m_pBroadphase);
+	m_pBroadphase = a_pBroadphase;
+	m_bBroadphaseBuilt = false;
+	m_lBroadphasePair.clear();
+}
+Simplex::MyBroadphase* Simplex::MyEntityManager::GetBroadphase(void) { return m_pBroadphase; }
+std::vector<std::pair<Simplex::uint, Simplex::uint>>& Simplex::MyEntityManager::GetBroadphasePairs(void) { return m_lBroadphasePair; }
+Simplex::MyBoxArray& Simplex::MyEntityManager::GetBoxes(void) { return m_Boxes; }
+bool Simplex::MyEntityManager::IsColliding(uint a_uIndex)
+{
+	if (a_uIndex >= m_uEntityCount)
+		return false;
+	return (m_lFlags[a_uIndex] & ENTITY_COLLIDING) != 0;
+}
+Simplex::MyContactBuffer& Simplex::MyEntityManager::GetContacts(void) { return m_Contacts; }
+bool Simplex::MyEntityManager::IsDataOriented(void) { return m_bDataOriented; }
+void Simplex::MyEntityManager::SetDataOriented(bool a_bDataOriented)
+{
+	if (m_bDataOriented == a_bDataOriented)
+		return;
+
+	if (a_bDataOriented)
+	{
+		//entities could have been moved or collided through their objects, start from what they have
+		for (uint i = 0; i < m_uEntityCount; i++)
+		{
+			m_mEntityArray[i]->ClearCollisionList();
+			m_lToWorld[i] = m_mEntityArray[i]->GetModelMatrix();
+			m_lFlags[i] &= ~(ENTITY_STALE | ENTITY_COLLIDING);
+			RefreshBox(i);
+		}
+	}
+	else
+	{
+		for (uint i = 0; i < m_uEntityCount; i++)
+		{
+			RefreshEntity(i);
+		}
+	}
+	m_bDataOriented = a_bDataOriented;
+}
+void Simplex::MyEntityManager::UpdateBroadphase(void)
+{
+	if (m_pBroadphase == nullptr)
+	{
+		Update();
+		return;
+	}
+
+	//removing entities shifts the indices, the broadphase has to start over
+	uint uKnown = m_lBroadphaseMin.size();
+	if (uKnown > m_uEntityCount)
+	{
+		m_bBroadphaseBuilt = false;
+		uKnown = m_uEntityCount;
+	}
+	m_lBroadphaseMin.resize(m_uEntityCount);
+	m_lBroadphaseMax.resize(m_uEntityCount);
+
+	//the boxes are compared instead of using the moved list, it also holds entities that did not move
+	m_lBroadphaseMoved.clear();
+	m_Boxes.Resize(m_uEntityCount);
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		if (!m_bDataOriented)
+			RefreshBox(i);
+		vector3 v3Min = m_Boxes.GetMin(i);
+		vector3 v3Max = m_Boxes.GetMax(i);
+		if (i < uKnown &&
+			v3Min.x == m_lBroadphaseMin[i].x && v3Min.y == m_lBroadphaseMin[i].y && v3Min.z == m_lBroadphaseMin[i].z &&
+			v3Max.x == m_lBroadphaseMax[i].x && v3Max.y == m_lBroadphaseMax[i].y && v3Max.z == m_lBroadphaseMax[i].z)
+			continue;
+
+		m_lBroadphaseMin[i] = v3Min;
+		m_lBroadphaseMax[i] = v3Max;
+		m_lBroadphaseMoved.push_back(i);
+	}
+
+	if (!m_bBroadphaseBuilt)
+	{
+		m_pBroadphase->Build(m_lBroadphaseMin, m_lBroadphaseMax);
+		m_bBroadphaseBuilt = true;
+	}
+	else if (!m_lBroadphaseMoved.empty())
+		m_pBroadphase->Update(m_lBroadphaseMin, m_lBroadphaseMax, m_lBroadphaseMoved);
+
+	m_lBroadphasePair.clear();
+	m_pBroadphase->GetPairs(m_lBroadphasePair);
+	//the boxes were just taken
+	ClearCollisions();
+	CollidePairs(m_lBroadphasePair);
+}
+Simplex::EntityHandle Simplex::MyEntityManager::AddEntity(String a_sFileName, String a_sUniqueID)
+{
+	//the model is loaded once per file and shared
+	Asset* pAsset = LoadAsset(a_sFileName);
+	if (pAsset == nullptr)
+		return EntityHandle();
+
 	//Create a temporal entity to store the object
-	MyEntity* pTemp = new MyEntity(a_sFileName, a_sUniqueID);
+	MyEntity* pTemp = new MyEntity(pAsset->pModel, pAsset->pShape, a_sUniqueID);
 	//if I was able to generate it add it to the list
 	if (pTemp->IsInitialized())
 	{
-		//create a new temp array with one extra entry
-		PEntity* tempArray = new PEntity[m_uEntityCount + 1];
-		//start from 0 to the current count
-		uint uCount = 0;
-		for (uint i = 0; i < m_uEntityCount; ++i)
+		//double the room when full so adding n entities copies the list about n times in total
+		if (m_uEntityCount == m_uEntityCapacity)
+			Reserve(std::max(m_uEntityCapacity * 2, 16u));
+		m_mEntityArray[m_uEntityCount] = pTemp;
+		//add one entity to the count
+		++m_uEntityCount;
+		NewHandle(m_uEntityCount - 1);
+		PushEntityData(m_uEntityCount - 1);
+		m_Boxes.Resize(m_uEntityCount);
+		RefreshBox(m_uEntityCount - 1);
+		return pTemp->GetHandle();
+	}
+	SafeDelete(pTemp);
+	return EntityHandle();
+}
+Simplex::uint Simplex::MyEntityManager::AddEntities(String a_sFileName, uint a_uCount, std::vector<matrix4> const& a_lToWorld,
+	String a_sUniqueID)
+{
+	//the model is loaded once per file and shared
+	Asset* pAsset = LoadAsset(a_sFileName);
+	if (pAsset == nullptr)
+		return 0;
+
+	Reserve(m_uEntityCount + a_uCount);
+
+	uint uFirst = m_uEntityCount;
+	for (uint i = 0; i < a_uCount; ++i)
+	{
+		MyEntity* pTemp = new MyEntity(pAsset->pModel, pAsset->pShape, a_sUniqueID);
+		if (!pTemp->IsInitialized())
 		{
-			tempArray[uCount] = m_mEntityArray[i];
-			++uCount;
+			SafeDelete(pTemp);
+			break;
 		}
-		tempArray[uCount] = pTemp;
-		//if there was an older array delete
-		if (m_mEntityArray)
+		if (i < a_lToWorld.size())
 		{
-			delete[] m_mEntityArray;
+			pTemp->SetModelMatrix(a_lToWorld[i]);
 		}
-		//make the member pointer the temp pointer
-		m_mEntityArray = tempArray;
-		//add one entity to the count
+		m_mEntityArray[m_uEntityCount] = pTemp;
 		++m_uEntityCount;
+		NewHandle(m_uEntityCount - 1);
+		PushEntityData(m_uEntityCount - 1);
+	}
+
+	//the new entities count as moved so the spatial structures pick them up
+	m_Boxes.Resize(m_uEntityCount);
+	for (uint i = uFirst; i < m_uEntityCount; ++i)
+	{
+		RefreshBox(i);
+		m_lMovedList.push_back(i);
 	}
+	return m_uEntityCount - uFirst;
 }
+void Simplex::MyEntityManager::Reserve(uint a_uCapacity)
+{
+	if (a_uCapacity <= m_uEntityCapacity)
+		return;
+
+	//create a new array with the room asked for and move the pointers over
+	PEntity* tempArray = new PEntity[a_uCapacity];
+	for (uint i = 0; i < m_uEntityCount; ++i)
+	{
+		tempArray[i] = m_mEntityArray[i];
+	}
+	//if there was an older array delete
+	if (m_mEntityArray)
+	{
+		delete[] m_mEntityArray;
+	}
+	//make the member pointer the temp pointer
+	m_mEntityArray = tempArray;
+	m_uEntityCapacity = a_uCapacity;
+
+	m_Boxes.Reserve(a_uCapacity);
+	m_lToWorld.reserve(a_uCapacity);
+	m_lLocalMin.reserve(a_uCapacity);
+	m_lLocalMax.reserve(a_uCapacity);
+	m_lLocalCenter.reserve(a_uCapacity);
+	m_lRadius.reserve(a_uCapacity);
+	m_lModel.reserve(a_uCapacity);
+	m_lFlags.reserve(a_uCapacity);
+}
+Simplex::uint Simplex::MyEntityManager::GetEntityCapacity(void) { return m_uEntityCapacity; }
+Simplex::uint Simplex::MyEntityManager::GetAssetCount(void) { return m_AssetMap.size(); }
 void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 {
 	//if the list is empty return
@@ -220,34 +693,60 @@ void Simplex::MyEntityManager::RemoveEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	//the handles of the entity stop being valid
+	FreeHandle(a_uIndex);
+
 	// if the entity is not the very last we swap it for the last one
 	if (a_uIndex != m_uEntityCount - 1)
 	{
-		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[m_uEntityCount - 1]);
+		uint uLast = m_uEntityCount - 1;
+		std::swap(m_mEntityArray[a_uIndex], m_mEntityArray[uLast]);
+		//the handle of the last one now leads to its new index
+		m_lHandleIndex[m_mEntityArray[a_uIndex]->GetHandle().uSlot] = a_uIndex;
+		m_lToWorld[a_uIndex] = m_lToWorld[uLast];
+		m_lLocalMin[a_uIndex] = m_lLocalMin[uLast];
+		m_lLocalMax[a_uIndex] = m_lLocalMax[uLast];
+		m_lLocalCenter[a_uIndex] = m_lLocalCenter[uLast];
+		m_lRadius[a_uIndex] = m_lRadius[uLast];
+		m_lModel[a_uIndex] = m_lModel[uLast];
+		m_lFlags[a_uIndex] = m_lFlags[uLast];
+		if (m_bDataOriented)
+			TransformBox(a_uIndex);
+		else
+			RefreshBox(a_uIndex);
+		m_lMovedList.push_back(a_uIndex);
 	}
-	
-	//and then pop the last one
-	//create a new temp array with one less entry
-	PEntity* tempArray = new PEntity[m_uEntityCount - 1];
-	//start from 0 to the current count
-	for (uint i = 0; i < m_uEntityCount - 1; ++i)
-	{
-		tempArray[i] = m_mEntityArray[i];
-	}
-	//if there was an older array delete
-	if (m_mEntityArray)
-	{
-		delete[] m_mEntityArray;
-	}
-	//make the member pointer the temp pointer
-	m_mEntityArray = tempArray;
-	//add one entity to the count
+
+	//and then pop the last one, the room is kept for the next entity added
+	MyEntity* pEntity = m_mEntityArray[m_uEntityCount - 1];
+	SafeDelete(pEntity);
+	m_mEntityArray[m_uEntityCount - 1] = nullptr;
 	--m_uEntityCount;
+	m_Boxes.Resize(m_uEntityCount);
+	m_lToWorld.pop_back();
+	m_lLocalMin.pop_back();
+	m_lLocalMax.pop_back();
+	m_lLocalCenter.pop_back();
+	m_lRadius.pop_back();
+	m_lModel.pop_back();
+	m_lFlags.pop_back();
 }
 void Simplex::MyEntityManager::RemoveEntity(String a_sUniqueID)
 {
 	int nIndex = GetEntityIndex(a_sUniqueID);
-	RemoveEntity((uint)nIndex);
+	//an unknown unique id removes nothing, not the last one
+	if (nIndex >= 0)
+	{
+		RemoveEntity((uint)nIndex);
+	}
+}
+void Simplex::MyEntityManager::RemoveEntity(EntityHandle a_Handle)
+{
+	int nIndex = GetEntityIndex(a_Handle);
+	if (nIndex >= 0)
+	{
+		RemoveEntity(static_cast<uint>(nIndex));
+	}
 }
 Simplex::String Simplex::MyEntityManager::GetUniqueID(uint a_uIndex)
 {
@@ -271,8 +770,16 @@ Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(uint a_uIndex)
 	if (a_uIndex >= m_uEntityCount)
 		a_uIndex = m_uEntityCount - 1;
 
+	RefreshEntity(a_uIndex);
 	return m_mEntityArray[a_uIndex];
 }
+Simplex::MyEntity* Simplex::MyEntityManager::GetEntity(EntityHandle a_Handle)
+{
+	int nIndex = GetEntityIndex(a_Handle);
+	if (nIndex < 0)
+		return nullptr;
+	return GetEntity(static_cast<uint>(nIndex));
+}
 void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigidBody)
 {
 	//if out of bounds will do it for all
@@ -281,22 +788,42 @@ void Simplex::MyEntityManager::AddEntityToRenderList(uint a_uIndex, bool a_bRigi
 		//add for each one in the entity list
 		for (a_uIndex = 0; a_uIndex < m_uEntityCount; ++a_uIndex)
 		{
-			m_mEntityArray[a_uIndex]->AddToRenderList(a_bRigidBody);
+			AddEntityToRenderList(a_uIndex, a_bRigidBody);
 		}
+		return;
 	}
-	else //do it for the specified one
+
+	if (!m_bDataOriented)
 	{
 		m_mEntityArray[a_uIndex]->AddToRenderList(a_bRigidBody);
+		return;
+	}
+
+	//draw from the lists, the same shapes the MyEntity and its Rigid Body draw by default
+	MeshManager* pMeshMngr = MeshManager::GetInstance();
+	matrix4 const& m4ToWorld = m_lToWorld[a_uIndex];
+	m_lModel[a_uIndex]->SetModelMatrix(m4ToWorld);
+	m_lModel[a_uIndex]->AddToRenderList();
+	if (a_bRigidBody)
+	{
+		vector3 v3Color = (m_lFlags[a_uIndex] & ENTITY_COLLIDING) ? C_RED : C_WHITE;
+		pMeshMngr->AddWireCubeToRenderList(glm::translate(m4ToWorld, m_lLocalCenter[a_uIndex]) *
+			glm::scale(m_lLocalMax[a_uIndex] - m_lLocalMin[a_uIndex]), v3Color);
+		vector3 v3Min = m_Boxes.GetMin(a_uIndex);
+		vector3 v3Max = m_Boxes.GetMax(a_uIndex);
+		pMeshMngr->AddWireCubeToRenderList(glm::translate((v3Min + v3Max) * 0.5f) * glm::scale(v3Max - v3Min), C_YELLOW);
 	}
+	if (m_lFlags[a_uIndex] & ENTITY_AXIS)
+		pMeshMngr->AddAxisToRenderList(m4ToWorld);
 }
 void Simplex::MyEntityManager::AddEntityToRenderList(String a_sUniqueID, bool a_bRigidBody)
 {
-	//Get the entity
-	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//Get the index of the entity, it can be drawn from the lists
+	int nIndex = GetEntityIndex(a_sUniqueID);
 	//if the entity exists
-	if (pTemp)
+	if (nIndex >= 0)
 	{
-		pTemp->AddToRenderList(a_bRigidBody);
+		AddEntityToRenderList(static_cast<uint>(nIndex), a_bRigidBody);
 	}
 }
 void Simplex::MyEntityManager::AddDimension(uint a_uIndex, uint a_uDimension)
@@ -417,4 +944,27 @@ bool Simplex::MyEntityManager::SharesDimension(String a_sUniqueID, MyEntity* con
 		return pTemp->SharesDimension(a_pOther);
 	}
 	return false;
+}
+uint Simplex::MyEntityManager::GetDimensionCount(uint a_uIndex)
+{
+	//if the list is empty return
+	if (m_uEntityCount == 0)
+		return 0;
+
+	//if the index is larger than the number of entries we are asking for the last one
+	if (a_uIndex >= m_uEntityCount)
+		a_uIndex = m_uEntityCount - 1;
+
+	return m_mEntityArray[a_uIndex]->GetDimensionCount();
+}
+uint Simplex::MyEntityManager::GetDimensionCount(String a_sUniqueID)
+{
+	//Get the entity
+	MyEntity* pTemp = MyEntity::GetEntity(a_sUniqueID);
+	//if the entity exists
+	if (pTemp)
+	{
+		return pTemp->GetDimensionCount();
+	}
+	return 0;
 }
\ No newline at end of file
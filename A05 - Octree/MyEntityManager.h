@@ -6,6 +6,9 @@ Date: 2017/07
 #define __MYENTITYMANAGER_H_
 
 #include "MyEntity.h"
+#include "MyBroadphase.h"
+#include "MyBoxArray.h"
+#include "MyContactBuffer.h"
 
 namespace Simplex
 {
@@ -14,9 +17,47 @@ namespace Simplex
 class MyEntityManager
 {
 	typedef MyEntity* PEntity; //MyEntity Pointer
+	//state of an entity kept next to its transform instead of in its objects
+	enum eENTITY_FLAG
+	{
+		ENTITY_STALE = 1, //the MyEntity has not been given the last model matrix set
+		ENTITY_COLLIDING = 2, //collided with another entity in the last update
+		ENTITY_AXIS = 4, //draws its axis
+	};
+	//model loaded from a file and the shape of its Rigid Body, shared by every entity of that file
+	struct Asset
+	{
+		Model* pModel = nullptr; //loaded model
+		MyRigidBody* pShape = nullptr; //Rigid Body made from the vertices of the model, in local space
+	};
 	uint m_uEntityCount = 0; //number of elements in the list
 	PEntity* m_mEntityArray = nullptr; //array of MyEntity pointers
+	uint m_uEntityCapacity = 0; //number of entities the array has room for, doubles when full
+	std::vector<uint> m_lMovedList; //indices of the entities whose model matrix was set since the list was cleared
+	MyBroadphase* m_pBroadphase = nullptr; //finds the pairs UpdateBroadphase checks, owned by the manager
+	bool m_bBroadphaseBuilt = false; //does the broadphase know the current entities
+	std::vector<vector3> m_lBroadphaseMin; //minimum corner of every entity the broadphase was last given
+	std::vector<vector3> m_lBroadphaseMax; //maximum corner of every entity the broadphase was last given
+	std::vector<uint> m_lBroadphaseMoved; //entities whose box changed since the broadphase was last given them
+	std::vector<std::pair<uint, uint>> m_lBroadphasePair; //pairs the broadphase found in the last update
+	MyBoxArray m_Boxes; //global box and bounding sphere of every entity, refreshed when its model matrix is set
+	std::vector<uint> m_lCandidate; //entities whose box overlaps the one being checked by Update
+	std::map<String, Asset> m_AssetMap; //assets loaded so far by file name
+	std::vector<uint> m_lHandleIndex; //index of the entity of each handle slot, next free slot while free
+	std::vector<uint> m_lHandleGeneration; //generation of each handle slot, goes up when its entity is removed
+	uint m_uFreeHandle = static_cast<uint>(-1); //first free handle slot
+	bool m_bDataOriented = false; //are the lists below the entities, the MyEntity objects only views of them
+	std::vector<matrix4> m_lToWorld; //model matrix of every entity
+	std::vector<vector3> m_lLocalMin; //minimum corner of the box of every entity in local space
+	std::vector<vector3> m_lLocalMax; //maximum corner of the box of every entity in local space
+	std::vector<vector3> m_lLocalCenter; //center of the bounding sphere of every entity in local space
+	std::vector<float> m_lRadius; //radius of the bounding sphere of every entity
+	std::vector<Model*> m_lModel; //model of every entity, shared by the ones of the same file
+	std::vector<uint8_t> m_lFlags; //eENTITY_FLAG bits of every entity
+	MyContactBuffer m_Contacts; //pairs of entities colliding in the last update
+	std::vector<MyRigidBody*> m_lContactBody; //Rigid Bodies of the contacts of each colliding entity, their colliding lists are views of it
 	static MyEntityManager* m_pInstance; // Singleton pointer
+	friend class MyBenchmark; //makes managers of its own so it never touches the entities of the application
 public:
 	/*
 	Usage: Gets the singleton pointer
@@ -37,15 +78,70 @@ public:
 	*/
 	int GetEntityIndex(String a_sUniqueID);
 	/*
-	USAGE: Will add an entity to the list
+	USAGE: Gets the index (from the list of entities) of the entity of a handle
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: index from the list of entities, -1 if the entity was removed
+	*/
+	int GetEntityIndex(EntityHandle a_Handle);
+	/*
+	USAGE: Gets the handle of an entity, it keeps pointing to the entity when others are removed
+	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
+	OUTPUT: handle, generation 0 if the list is empty
+	*/
+	EntityHandle GetHandle(uint a_uIndex = -1);
+	/*
+	USAGE: Gets the handle of the entity specified by unique ID
+	ARGUMENTS: String a_sUniqueID -> Unique Identifier
+	OUTPUT: handle, generation 0 if not found
+	*/
+	EntityHandle GetHandle(String a_sUniqueID);
+	/*
+	USAGE: Asks if the entity of a handle is still in the list
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: is it?
+	*/
+	bool IsValid(EntityHandle a_Handle);
+	/*
+	USAGE: Will add an entity to the list, the model of each file is loaded once and shared by its entities
 	ARGUMENTS:
 	-	String a_sFileName -> Name of the model to load
 	-	String a_sUniqueID -> Name wanted as identifier, if not available will generate one
+	OUTPUT: handle of the new entity, generation 0 if the model could not be loaded
+	*/
+	EntityHandle AddEntity(String a_sFileName, String a_sUniqueID = "NA");
+	/*
+	USAGE: Will add many entities of the same model to the list, making room for all of them at once
+	ARGUMENTS:
+	-	String a_sFileName -> Name of the model to load
+	-	uint a_uCount -> number of entities to add
+	-	std::vector<matrix4> const& a_lToWorld = std::vector<matrix4>() -> model matrix of each new
+		entity, the ones past the end of the list keep the identity
+	-	String a_sUniqueID -> Name wanted as identifier, a number is added to each
+	OUTPUT: number of entities added, 0 if the model could not be loaded
+	*/
+	uint AddEntities(String a_sFileName, uint a_uCount, std::vector<matrix4> const& a_lToWorld = std::vector<matrix4>(),
+		String a_sUniqueID = "NA");
+	/*
+	USAGE: Makes room for a number of entities so adding up to that many does not grow the list
+	ARGUMENTS: uint a_uCapacity -> number of entities
 	OUTPUT: ---
 	*/
-	void AddEntity(String a_sFileName, String a_sUniqueID = "NA");
+	void Reserve(uint a_uCapacity);
 	/*
-	USAGE: Deletes the MyEntity Specified by unique ID and removes it from the list
+	USAGE: Gets the number of entities the list has room for
+	ARGUMENTS: ---
+	OUTPUT: capacity
+	*/
+	uint GetEntityCapacity(void);
+	/*
+	USAGE: Gets the number of model files loaded, each one is loaded once however many entities use it
+	ARGUMENTS: ---
+	OUTPUT: number of assets
+	*/
+	uint GetAssetCount(void);
+	/*
+	USAGE: Deletes the MyEntity Specified by unique ID and removes it from the list, the last entity
+	takes its index
 	ARGUMENTS: uint a_uIndex -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: ---
 	*/
@@ -57,6 +153,12 @@ public:
 	*/
 	void RemoveEntity(String a_sUniqueID);
 	/*
+	USAGE: Deletes the MyEntity of a handle and removes it from the list, nothing if it was already removed
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: ---
+	*/
+	void RemoveEntity(EntityHandle a_Handle);
+	/*
 	USAGE: Gets the uniqueID name of the entity indexed
 	ARGUMENTS: uint a_uIndex = -1 -> index of the queried entry, if < 0 asks for the last one added
 	OUTPUT: UniqueID of the entity, if the list is empty will return blank
@@ -69,12 +171,85 @@ public:
 	*/
 	MyEntity* GetEntity(uint a_uIndex = -1);
 	/*
+	USAGE: Gets the entity of a handle
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: entity, nullptr if it was removed
+	*/
+	MyEntity* GetEntity(EntityHandle a_Handle);
+	/*
 	USAGE: Will update the MyEntity manager
 	ARGUMENTS: ---
 	OUTPUT: ---
 	*/
 	void Update(void);
 	/*
+	USAGE: Will update the MyEntity manager checking collisions only on the pairs provided
+	ARGUMENTS: std::vector<std::pair<uint, uint>> const& a_lPair -> candidate pairs of entity indices
+	OUTPUT: ---
+	*/
+	void Update(std::vector<std::pair<uint, uint>> const& a_lPair);
+	/*
+	USAGE: Sets the broadphase UpdateBroadphase uses, the manager owns it from then on and deletes
+	the one it had; it is built with every entity on the next update
+	ARGUMENTS: MyBroadphase* a_pBroadphase -> new broadphase, nullptr to go back to every pair
+	OUTPUT: ---
+	*/
+	void SetBroadphase(MyBroadphase* a_pBroadphase);
+	/*
+	USAGE: Gets the broadphase UpdateBroadphase uses
+	ARGUMENTS: ---
+	OUTPUT: broadphase, nullptr if none is set
+	*/
+	MyBroadphase* GetBroadphase(void);
+	/*
+	USAGE: Will update the MyEntity manager checking collisions on the pairs the broadphase finds:
+	the boxes of the entities are compared with the ones the broadphase has and the ones that
+	changed are handed to it; without a broadphase every pair is checked
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void UpdateBroadphase(void);
+	/*
+	USAGE: Gets the pairs the broadphase found in the last UpdateBroadphase
+	ARGUMENTS: ---
+	OUTPUT: pairs of entity indices, the smaller index first
+	*/
+	std::vector<std::pair<uint, uint>>& GetBroadphasePairs(void);
+	/*
+	USAGE: Gets the global box and bounding sphere of every entity, one list per component
+	ARGUMENTS: ---
+	OUTPUT: boxes, in the order of the entities
+	*/
+	MyBoxArray& GetBoxes(void);
+	/*
+	USAGE: Asks if the entity collided with another one in the last update
+	ARGUMENTS: uint a_uIndex -> index in the list of entities
+	OUTPUT: did it?
+	*/
+	bool IsColliding(uint a_uIndex);
+	/*
+	USAGE: Gets the pairs of entities found colliding in the last update, the Rigid Body of each
+	entity has a view of its part
+	ARGUMENTS: ---
+	OUTPUT: contact buffer
+	*/
+	MyContactBuffer& GetContacts(void);
+	/*
+	USAGE: Switches to the data oriented storage and back. While on, setting a model matrix only writes
+	the lists of the manager and the updates and the render list read them one entity after the other;
+	the MyEntity and its Rigid Body are refreshed when asked for through the manager, so move entities
+	through the manager and not through the MyEntity. The rigid bodies are drawn with the default look.
+	ARGUMENTS: bool a_bDataOriented -> use the lists of the manager?
+	OUTPUT: ---
+	*/
+	void SetDataOriented(bool a_bDataOriented);
+	/*
+	USAGE: Asks if the data oriented storage is on
+	ARGUMENTS: ---
+	OUTPUT: is it?
+	*/
+	bool IsDataOriented(void);
+	/*
 	USAGE: Gets the model associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: Model
@@ -99,6 +274,12 @@ public:
 	*/
 	MyRigidBody* GetRigidBody(String a_sUniqueID);
 	/*
+	USAGE: Gets the Rigid Body of the entity of a handle
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: Rigid Body, nullptr if the entity was removed
+	*/
+	MyRigidBody* GetRigidBody(EntityHandle a_Handle);
+	/*
 	USAGE: Gets the model matrix associated with this entity
 	ARGUMENTS: uint a_uIndex = -1 -> index in the list of entities; if less than 0 it will add it to the last in the list
 	OUTPUT: model to world matrix
@@ -111,6 +292,12 @@ public:
 	*/
 	matrix4 GetModelMatrix(String a_sUniqueID);
 	/*
+	USAGE: Gets the model matrix of the entity of a handle
+	ARGUMENTS: EntityHandle a_Handle -> handle of the entity
+	OUTPUT: model to world matrix, identity if the entity was removed
+	*/
+	matrix4 GetModelMatrix(EntityHandle a_Handle);
+	/*
 	USAGE: Sets the model matrix associated to the entity specified in the ID
 	ARGUMENTS:
 	-	matrix4 a_m4ToWorld -> model matrix to set
@@ -127,6 +314,14 @@ public:
 	*/
 	void SetModelMatrix(matrix4 a_m4ToWorld, String a_sUniqueID);
 	/*
+	USAGE: Sets the model matrix of the entity of a handle
+	ARGUMENTS:
+	-	matrix4 a_m4ToWorld -> model matrix to set
+	-	EntityHandle a_Handle -> handle of the entity
+	OUTPUT: ---
+	*/
+	void SetModelMatrix(matrix4 a_m4ToWorld, EntityHandle a_Handle);
+	/*
 	USAGE: Sets the axis visibility associated to the entity specified in the ID
 	ARGUMENTS: 
 	-	bool a_bVisibility -> visibility of the axis
@@ -241,11 +436,36 @@ public:
 	*/
 	bool SharesDimension(String a_sUniqueID, MyEntity* const a_pOther);
 	/*
+	USAGE: Gets how many dimensions the entity lives in
+	ARGUMENTS: uint a_uIndex -> index (from the list) of the entity queried if < 0 will use the last one
+	OUTPUT: dimension count
+	*/
+	uint GetDimensionCount(uint a_uIndex);
+	/*
+	USAGE: Gets how many dimensions the entity lives in
+	ARGUMENTS: String a_sUniqueID -> unique identifier of the entity queried
+	OUTPUT: dimension count
+	*/
+	uint GetDimensionCount(String a_sUniqueID);
+	/*
 	USAGE: Will return the count of Entities in the system
 	ARGUMENTS: ---
 	OUTPUT: MyEntity count
 	*/
 	uint GetEntityCount(void);
+	/*
+	USAGE: Gets the indices of the entities whose model matrix was set since the last time the
+	list was cleared, an index can show more than once
+	ARGUMENTS: ---
+	OUTPUT: list of moved entities
+	*/
+	std::vector<uint>& GetMovedList(void);
+	/*
+	USAGE: Clears the list of moved entities
+	ARGUMENTS: ---
+	OUTPUT: ---
+	*/
+	void ClearMovedList(void);
 private:
 	/*
 	Usage: constructor
@@ -283,6 +503,77 @@ private:
 	Output: ---
 	*/
 	void Init(void);
+	/*
+	Usage: Copies the global box and bounding sphere of an entity from its rigid body
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void RefreshBox(uint a_uIndex);
+	/*
+	Usage: Makes the global box and bounding sphere of an entity from its local box and model
+	matrix in the lists of the manager, the same way the Rigid Body does
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void TransformBox(uint a_uIndex);
+	/*
+	Usage: Gives the MyEntity of an index the last model matrix set, if it does not have it
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void RefreshEntity(uint a_uIndex);
+	/*
+	Usage: Fills the lists of the manager for an entity just placed at the end of the array
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void PushEntityData(uint a_uIndex);
+	/*
+	Usage: Clears the collisions of the last update, only the entities that had any are visited
+	Arguments: ---
+	Output: ---
+	*/
+	void ClearCollisions(void);
+	/*
+	Usage: Adds a collision between two entities to the contact buffer and flags them
+	Arguments:
+	-	uint a_uA -> index of an entity
+	-	uint a_uB -> index of the other entity
+	Output: ---
+	*/
+	void AddCollision(uint a_uA, uint a_uB);
+	/*
+	Usage: Sorts the contacts of the update by entity and gives the Rigid Body of each colliding
+	entity a view of its contacts
+	Arguments: ---
+	Output: ---
+	*/
+	void PublishContacts(void);
+	/*
+	Usage: Adds a collision for every pair whose boxes overlap and publishes them
+	Arguments: std::vector<std::pair<uint, uint>> const& a_lPair -> candidate pairs of entity indices
+	Output: ---
+	*/
+	void CollidePairs(std::vector<std::pair<uint, uint>> const& a_lPair);
+	/*
+	Usage: Gets the asset of a model file, loading it and making the shape of its Rigid Body the
+	first time it is asked for
+	Arguments: String a_sFileName -> Name of the model to load
+	Output: asset, nullptr if the model could not be loaded
+	*/
+	Asset* LoadAsset(String a_sFileName);
+	/*
+	Usage: Gives an entity a handle, reusing a free slot if there is one
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void NewHandle(uint a_uIndex);
+	/*
+	Usage: Frees the handle slot of an entity, the handles given for it stop being valid
+	Arguments: uint a_uIndex -> index of the entity
+	Output: ---
+	*/
+	void FreeHandle(uint a_uIndex);
 };//class
 
 } //namespace Simplex
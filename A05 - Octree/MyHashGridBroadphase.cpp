@@ -0,0 +1,298 @@
+#include "MyHashGridBroadphase.h"
+using namespace Simplex;
+const uint64_t MyHashGridBroadphase::m_uEmptyKey;
+const uint MyHashGridBroadphase::m_uMaxBoxCells;
+
+namespace
+{
+	//21 bits of each coordinate, far cells wrap around and share a slot with a near one
+	uint64_t PackCell(int a_nX, int a_nY, int a_nZ)
+	{
+		return (static_cast<uint64_t>(a_nX & 0x1FFFFF) << 42) |
+			(static_cast<uint64_t>(a_nY & 0x1FFFFF) << 21) | static_cast<uint64_t>(a_nZ & 0x1FFFFF);
+	}
+}
+
+MyHashGridBroadphase::MyHashGridBroadphase(void) {}
+
+MyHashGridBroadphase::~MyHashGridBroadphase(void) { SafeDelete(m_pPool); }
+
+String MyHashGridBroadphase::GetName(void) { return GetTypeName(BROADPHASE_HASH_GRID); }
+
+void MyHashGridBroadphase::SetThreadCount(uint a_uThreadCount, uint a_uCutoff)
+{
+	if (a_uThreadCount != m_uThreadCount)
+	{
+		SafeDelete(m_pPool);
+		if (a_uThreadCount != 1)
+			m_pPool = new MyTaskPool(a_uThreadCount);
+		m_uThreadCount = a_uThreadCount;
+	}
+	m_uParallelCutoff = std::max(a_uCutoff, 1u);
+}
+
+float MyHashGridBroadphase::GetCellSize(void) { return m_fCellSize; }
+
+uint MyHashGridBroadphase::GetCellCount(void)
+{
+	uint nCells = 0;
+	uint nSlots = m_lKey.size();
+	for (uint i = 0; i < nSlots; i++)
+	{
+		if (m_lFirst[i + 1] > m_lFirst[i])
+			nCells++;
+	}
+	return nCells;
+}
+
+void MyHashGridBroadphase::Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	m_lMin = a_lMin;
+	m_lMax = a_lMax;
+	m_uEntityCount = a_lMin.size();
+
+	//the cells fit the typical box, the few large ones go over more cells
+	std::vector<float> lExtent(m_uEntityCount);
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		vector3 v3Size = a_lMax[i] - a_lMin[i];
+		lExtent[i] = std::max(v3Size.x, std::max(v3Size.y, v3Size.z));
+	}
+	float fMedian = 0.0f;
+	if (m_uEntityCount > 0)
+	{
+		std::nth_element(lExtent.begin(), lExtent.begin() + m_uEntityCount / 2, lExtent.end());
+		fMedian = lExtent[m_uEntityCount / 2];
+	}
+	m_fCellSize = fMedian > 0.0f ? fMedian * m_fCellScale : 1.0f;
+	m_fInvCellSize = 1.0f / m_fCellSize;
+
+	Insert();
+}
+
+void MyHashGridBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& a_lMoved)
+{
+	if (m_lKey.empty())
+	{
+		Build(a_lMin, a_lMax);
+		return;
+	}
+	if (a_lMoved.empty() && a_lMin.size() == m_uEntityCount)
+		return;
+
+	//clearing and inserting again costs about what finding each moved box in its old cells would
+	m_uEntityCount = a_lMin.size();
+	m_lMin.resize(m_uEntityCount);
+	m_lMax.resize(m_uEntityCount);
+	uint nMoved = a_lMoved.size();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		m_lMin[a_lMoved[i]] = a_lMin[a_lMoved[i]];
+		m_lMax[a_lMoved[i]] = a_lMax[a_lMoved[i]];
+	}
+	Insert();
+}
+
+void MyHashGridBroadphase::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	uint nSlots = m_lKey.size();
+	for (uint uSlot = 0; uSlot < nSlots; uSlot++)
+	{
+		uint uFirst = m_lFirst[uSlot];
+		uint uEnd = m_lFirst[uSlot + 1];
+		if (uEnd - uFirst < 2)
+			continue;
+
+		uint64_t uKey = m_lKey[uSlot].load(std::memory_order_relaxed);
+		for (uint i = uFirst; i < uEnd - 1; i++)
+		{
+			uint uA = m_lCellEntity[i];
+			for (uint j = i + 1; j < uEnd; j++)
+			{
+				uint uB = m_lCellEntity[j];
+				if (!IsOverlapping(m_lMin[uA], m_lMax[uA], m_lMin[uB], m_lMax[uB]))
+					continue;
+
+				//both boxes are in the cell of the corner, it is the only one that keeps the pair
+				vector3 v3Corner(std::max(m_lMin[uA].x, m_lMin[uB].x), std::max(m_lMin[uA].y, m_lMin[uB].y),
+					std::max(m_lMin[uA].z, m_lMin[uB].z));
+				if (GetCellKey(v3Corner) != uKey)
+					continue;
+
+				a_lOutput.push_back(std::pair<uint, uint>(std::min(uA, uB), std::max(uA, uB)));
+			}
+		}
+	}
+
+	//the large boxes against everything, two large ones only once
+	uint nLarge = m_lLarge.size();
+	for (uint i = 0; i < nLarge; i++)
+	{
+		uint uLarge = m_lLarge[i];
+		for (uint uOther = 0; uOther < m_uEntityCount; uOther++)
+		{
+			bool bOtherLarge = m_lEntryFirst[uOther + 1] == m_lEntryFirst[uOther];
+			if (uOther == uLarge || (bOtherLarge && uOther < uLarge))
+				continue;
+			if (IsOverlapping(m_lMin[uLarge], m_lMax[uLarge], m_lMin[uOther], m_lMax[uOther]))
+				a_lOutput.push_back(std::pair<uint, uint>(std::min(uLarge, uOther), std::max(uLarge, uOther)));
+		}
+	}
+}
+
+void MyHashGridBroadphase::Insert(void)
+{
+	bool bParallel = m_pPool != nullptr && m_uEntityCount >= m_uParallelCutoff;
+
+	//count the cells of every box, then where the cells of each one go
+	m_lEntryFirst.resize(m_uEntityCount + 1);
+	ForEachRange(bParallel, [this](uint a_uFirst, uint a_uEnd)
+	{
+		int lCellMin[3];
+		int lCellMax[3];
+		for (uint i = a_uFirst; i < a_uEnd; i++)
+			m_lEntryFirst[i] = GetCellRange(i, lCellMin, lCellMax);
+	});
+	m_lLarge.clear();
+	uint nEntries = 0;
+	for (uint i = 0; i < m_uEntityCount; i++)
+	{
+		uint nCells = m_lEntryFirst[i];
+		if (nCells > m_uMaxBoxCells)
+		{
+			m_lLarge.push_back(i);
+			nCells = 0;
+		}
+		m_lEntryFirst[i] = nEntries;
+		nEntries += nCells;
+	}
+	m_lEntryFirst[m_uEntityCount] = nEntries;
+	m_lEntrySlot.resize(nEntries);
+
+	//at most half of the table is used, there are never more cells than entries
+	uint uSlotBits = 4;
+	while ((1u << uSlotBits) < nEntries * 2)
+		uSlotBits++;
+	uint nSlots = 1u << uSlotBits;
+	if (m_lKey.size() != nSlots)
+	{
+		m_lKey = std::vector<std::atomic<uint64_t>>(nSlots);
+		m_lCount = std::vector<std::atomic<uint>>(nSlots);
+		m_lFirst.resize(nSlots + 1);
+	}
+	for (uint i = 0; i < nSlots; i++)
+	{
+		m_lKey[i].store(m_uEmptyKey, std::memory_order_relaxed);
+		m_lCount[i].store(0, std::memory_order_relaxed);
+	}
+
+	//find the slot of every cell of every box
+	ForEachRange(bParallel, [this](uint a_uFirst, uint a_uEnd)
+	{
+		int lCellMin[3];
+		int lCellMax[3];
+		for (uint i = a_uFirst; i < a_uEnd; i++)
+		{
+			uint uEntry = m_lEntryFirst[i];
+			if (uEntry == m_lEntryFirst[i + 1])
+				continue;
+
+			GetCellRange(i, lCellMin, lCellMax);
+			for (int x = lCellMin[0]; x <= lCellMax[0]; x++)
+			{
+				for (int y = lCellMin[1]; y <= lCellMax[1]; y++)
+				{
+					for (int z = lCellMin[2]; z <= lCellMax[2]; z++)
+					{
+						uint uSlot = FindOrAddSlot(PackCell(x, y, z));
+						m_lCount[uSlot].fetch_add(1, std::memory_order_relaxed);
+						m_lEntrySlot[uEntry++] = uSlot;
+					}
+				}
+			}
+		}
+	});
+
+	//each cell gets its range, the count turns into the end of the range and is walked back while filling
+	uint uFirst = 0;
+	for (uint i = 0; i < nSlots; i++)
+	{
+		m_lFirst[i] = uFirst;
+		uFirst += m_lCount[i].load(std::memory_order_relaxed);
+		m_lCount[i].store(uFirst, std::memory_order_relaxed);
+	}
+	m_lFirst[nSlots] = uFirst;
+
+	m_lCellEntity.resize(nEntries);
+	ForEachRange(bParallel, [this](uint a_uFirst, uint a_uEnd)
+	{
+		for (uint i = a_uFirst; i < a_uEnd; i++)
+		{
+			for (uint uEntry = m_lEntryFirst[i]; uEntry < m_lEntryFirst[i + 1]; uEntry++)
+			{
+				uint uIndex = m_lCount[m_lEntrySlot[uEntry]].fetch_sub(1, std::memory_order_relaxed) - 1;
+				m_lCellEntity[uIndex] = i;
+			}
+		}
+	});
+}
+
+void MyHashGridBroadphase::ForEachRange(bool a_bParallel, std::function<void(uint, uint)> a_Function)
+{
+	if (!a_bParallel)
+	{
+		a_Function(0, m_uEntityCount);
+		return;
+	}
+
+	//a few ranges per thread so a slow one does not hold the rest
+	uint nRanges = m_pPool->GetThreadCount() * 4;
+	uint uRangeSize = (m_uEntityCount + nRanges - 1) / nRanges;
+	for (uint uFirst = 0; uFirst < m_uEntityCount; uFirst += uRangeSize)
+	{
+		uint uEnd = std::min(uFirst + uRangeSize, m_uEntityCount);
+		m_pPool->Push([a_Function, uFirst, uEnd] { a_Function(uFirst, uEnd); });
+	}
+	m_pPool->Wait();
+}
+
+uint MyHashGridBroadphase::FindOrAddSlot(uint64_t a_uKey)
+{
+	uint uMask = m_lKey.size() - 1;
+	uint uSlot = static_cast<uint>((a_uKey * 0x9E3779B97F4A7C15ull) >> 32) & uMask;
+	while (true)
+	{
+		uint64_t uFound = m_lKey[uSlot].load(std::memory_order_relaxed);
+		if (uFound == a_uKey)
+			return uSlot;
+		if (uFound == m_uEmptyKey)
+		{
+			//another thread may take the slot first, with this cell or another one
+			if (m_lKey[uSlot].compare_exchange_strong(uFound, a_uKey, std::memory_order_relaxed) || uFound == a_uKey)
+				return uSlot;
+			continue;
+		}
+		uSlot = (uSlot + 1) & uMask;
+	}
+}
+
+uint64_t MyHashGridBroadphase::GetCellKey(vector3 const& a_v3Point)
+{
+	int x = static_cast<int>(std::floor(a_v3Point.x * m_fInvCellSize));
+	int y = static_cast<int>(std::floor(a_v3Point.y * m_fInvCellSize));
+	int z = static_cast<int>(std::floor(a_v3Point.z * m_fInvCellSize));
+	return PackCell(x, y, z);
+}
+
+uint MyHashGridBroadphase::GetCellRange(uint a_uEntity, int* a_pCellMin, int* a_pCellMax)
+{
+	uint64_t nCells = 1;
+	for (uint k = 0; k < 3; k++)
+	{
+		a_pCellMin[k] = static_cast<int>(std::floor(m_lMin[a_uEntity][k] * m_fInvCellSize));
+		a_pCellMax[k] = static_cast<int>(std::floor(m_lMax[a_uEntity][k] * m_fInvCellSize));
+		nCells *= static_cast<uint64_t>(a_pCellMax[k] - a_pCellMin[k] + 1);
+	}
+	return static_cast<uint>(std::min<uint64_t>(nCells, m_uMaxBoxCells + 1));
+}
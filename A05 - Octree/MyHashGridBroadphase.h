@@ -0,0 +1,157 @@
+#ifndef __MYHASHGRIDBROADPHASECLASS_H_
+#define __MYHASHGRIDBROADPHASECLASS_H_
+
+#include "MyBroadphase.h"
+#include "MyTaskPool.h"
+
+#include <atomic>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyHashGridBroadphase : public MyBroadphase
+	{
+		static const uint64_t m_uEmptyKey = ~0ull; //key of a slot of the table with no cell
+		static const uint m_uMaxBoxCells = 64; //boxes over more cells than this are tested against every box instead
+
+		float m_fCellScale = 2.0f; //size of the cells over the median size of the boxes
+		float m_fCellSize = 1.0f; //size of the cells, set by Build
+		float m_fInvCellSize = 1.0f; //1 over the size of the cells
+		uint m_uEntityCount = 0; //number of Entities in the grid
+
+		//cells in a table with open addressing, each slot has its Entities in a range of m_lCellEntity
+		std::vector<std::atomic<uint64_t>> m_lKey; //packed coordinates of the cell of each slot, m_uEmptyKey if none
+		std::vector<std::atomic<uint>> m_lCount; //Entities in the cell of each slot, used as a cursor while filling
+		std::vector<uint> m_lFirst; //first index in m_lCellEntity of the cell of each slot
+		std::vector<uint> m_lCellEntity; //Entities of every cell, one cell after the other
+		std::vector<uint> m_lEntryFirst; //first entry of each Entity in m_lEntrySlot, one past the last Entity at the end
+		std::vector<uint> m_lEntrySlot; //slot of each cell an Entity is in
+		std::vector<uint> m_lLarge; //Entities over too many cells, kept out of the grid
+		std::vector<vector3> m_lMin; //minimum corner of each Entity in the grid
+		std::vector<vector3> m_lMax; //maximum corner of each Entity in the grid
+
+		uint m_uThreadCount = 1; //threads inserting, 0 for one per core and 1 for serial
+		uint m_uParallelCutoff = 4096; //grids of less Entities than this are built by a single thread
+		MyTaskPool* m_pPool = nullptr; //threads inserting, nullptr while serial
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		MyHashGridBroadphase(void);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyHashGridBroadphase(void);
+		/*
+		USAGE: Gets the name of the broadphase
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		String GetName(void) override;
+		/*
+		USAGE: Sets the size of the cells from the median size of the boxes and inserts them
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) override;
+		/*
+		USAGE: Inserts every box again keeping the size of the cells, clearing the table and
+		inserting is linear in the number of boxes
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new
+		OUTPUT: ---
+		*/
+		void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved) override;
+		/*
+		USAGE: Tests the boxes sharing each cell; a pair is kept only in the cell holding the minimum
+		corner of where they overlap, so it comes out once
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) override;
+		/*
+		USAGE: Sets how many threads insert the boxes
+		ARGUMENTS:
+		- uint a_uThreadCount -> threads, 0 for one per core and 1 for serial
+		- uint a_uCutoff = 4096 -> grids of less Entities than this are built by a single thread
+		OUTPUT: ---
+		*/
+		void SetThreadCount(uint a_uThreadCount, uint a_uCutoff = 4096);
+		/*
+		USAGE: Gets the size of the cells
+		ARGUMENTS: ---
+		OUTPUT: size of the side of each cell
+		*/
+		float GetCellSize(void);
+		/*
+		USAGE: Gets how many cells hold at least one box
+		ARGUMENTS: ---
+		OUTPUT: cell count
+		*/
+		uint GetCellCount(void);
+
+	private:
+		/*
+		USAGE: Copy Constructor, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyHashGridBroadphase(MyHashGridBroadphase const& other);
+		/*
+		USAGE: Copy Assignment Operator, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyHashGridBroadphase& operator=(MyHashGridBroadphase const& other);
+		/*
+		USAGE: Clears the table and inserts every box, on the threads if there are enough boxes
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Insert(void);
+		/*
+		USAGE: Runs a function over the Entities, split in ranges among the threads or at once
+		ARGUMENTS:
+		- bool a_bParallel -> use the threads?
+		- std::function<void(uint, uint)> a_Function -> function called with the first Entity and one past the last
+		OUTPUT: ---
+		*/
+		void ForEachRange(bool a_bParallel, std::function<void(uint, uint)> a_Function);
+		/*
+		USAGE: Finds the slot of a cell in the table, taking an empty one if the cell is not there;
+		threads can call it at the same time
+		ARGUMENTS: uint64_t a_uKey -> packed coordinates of the cell
+		OUTPUT: slot
+		*/
+		uint FindOrAddSlot(uint64_t a_uKey);
+		/*
+		USAGE: Gets the packed coordinates of the cell holding a point
+		ARGUMENTS: vector3 const& a_v3Point -> point
+		OUTPUT: key of the cell
+		*/
+		uint64_t GetCellKey(vector3 const& a_v3Point);
+		/*
+		USAGE: Gets the coordinates of the cells a box goes from and to
+		ARGUMENTS:
+		- uint a_uEntity -> Entity of the box
+		- int* a_pCellMin -> output first cell on each axis
+		- int* a_pCellMax -> output last cell on each axis
+		OUTPUT: number of cells the box is in
+		*/
+		uint GetCellRange(uint a_uEntity, int* a_pCellMin, int* a_pCellMax);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYHASHGRIDBROADPHASECLASS_H_
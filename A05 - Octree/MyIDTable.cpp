@@ -0,0 +1,97 @@
+#include "MyIDTable.h"
+using namespace Simplex;
+
+MyEntity* MyIDTable::Find(String const& a_sID)
+{
+	if (m_uCount == 0)
+		return nullptr;
+
+	return m_lEntry[FindSlot(a_sID, std::hash<String>()(a_sID))].pEntity;
+}
+
+void MyIDTable::Insert(String const& a_sID, MyEntity* a_pEntity)
+{
+	if (a_pEntity == nullptr)
+	{
+		Erase(a_sID);
+		return;
+	}
+	if ((m_uCount + 1) * 2 > m_lEntry.size())
+		Grow();
+
+	size_t uHash = std::hash<String>()(a_sID);
+	Entry& entry = m_lEntry[FindSlot(a_sID, uHash)];
+	if (entry.pEntity == nullptr)
+	{
+		entry.uHash = uHash;
+		entry.sID = a_sID;
+		m_uCount++;
+	}
+	entry.pEntity = a_pEntity;
+}
+
+void MyIDTable::Erase(String const& a_sID)
+{
+	if (m_uCount == 0)
+		return;
+
+	uint uMask = m_lEntry.size() - 1;
+	uint uSlot = FindSlot(a_sID, std::hash<String>()(a_sID));
+	if (m_lEntry[uSlot].pEntity == nullptr)
+		return;
+
+	//move back every ID of the run that would not be found past the hole
+	uint uNext = (uSlot + 1) & uMask;
+	while (m_lEntry[uNext].pEntity != nullptr)
+	{
+		uint uHome = static_cast<uint>(m_lEntry[uNext].uHash) & uMask;
+		if (((uNext - uHome) & uMask) >= ((uNext - uSlot) & uMask))
+		{
+			m_lEntry[uSlot] = std::move(m_lEntry[uNext]);
+			uSlot = uNext;
+		}
+		uNext = (uNext + 1) & uMask;
+	}
+	m_lEntry[uSlot].pEntity = nullptr;
+	m_lEntry[uSlot].sID.clear();
+	m_uCount--;
+}
+
+uint MyIDTable::GetCount(void) { return m_uCount; }
+
+void MyIDTable::Clear(void)
+{
+	m_lEntry.clear();
+	m_uCount = 0;
+}
+
+uint MyIDTable::FindSlot(String const& a_sID, size_t a_uHash)
+{
+	uint uMask = m_lEntry.size() - 1;
+	uint uSlot = static_cast<uint>(a_uHash) & uMask;
+	while (m_lEntry[uSlot].pEntity != nullptr &&
+		(m_lEntry[uSlot].uHash != a_uHash || m_lEntry[uSlot].sID != a_sID))
+	{
+		uSlot = (uSlot + 1) & uMask;
+	}
+	return uSlot;
+}
+
+void MyIDTable::Grow(void)
+{
+	std::vector<Entry> lOld;
+	lOld.swap(m_lEntry);
+	m_lEntry.resize(std::max<size_t>(lOld.size() * 2, 16));
+
+	uint uMask = m_lEntry.size() - 1;
+	for (Entry& entry : lOld)
+	{
+		if (entry.pEntity == nullptr)
+			continue;
+
+		uint uSlot = static_cast<uint>(entry.uHash) & uMask;
+		while (m_lEntry[uSlot].pEntity != nullptr)
+			uSlot = (uSlot + 1) & uMask;
+		m_lEntry[uSlot] = std::move(entry);
+	}
+}
@@ -0,0 +1,79 @@
+#ifndef __MYIDTABLECLASS_H_
+#define __MYIDTABLECLASS_H_
+
+#include "Simplex\Simplex.h"
+
+namespace Simplex
+{
+
+	class MyEntity;
+
+	//System Class
+	class MyIDTable
+	{
+		//slot of the table, empty if it has no entity
+		struct Entry
+		{
+			size_t uHash = 0; //hash of the unique ID, compared before the strings
+			String sID; //unique ID
+			MyEntity* pEntity = nullptr; //entity with the unique ID
+		};
+
+		std::vector<Entry> m_lEntry; //slots, a power of 2 and never more than half full
+		uint m_uCount = 0; //number of unique IDs in the table
+
+	public:
+		/*
+		USAGE: Finds the entity with a unique ID
+		ARGUMENTS: String const& a_sID -> unique ID
+		OUTPUT: entity, nullptr if there is none
+		*/
+		MyEntity* Find(String const& a_sID);
+		/*
+		USAGE: Sets the entity of a unique ID, replacing the one it had
+		ARGUMENTS:
+		- String const& a_sID -> unique ID
+		- MyEntity* a_pEntity -> entity
+		OUTPUT: ---
+		*/
+		void Insert(String const& a_sID, MyEntity* a_pEntity);
+		/*
+		USAGE: Takes a unique ID out of the table, the IDs after it in its run move back so no slot
+		is left marked as removed
+		ARGUMENTS: String const& a_sID -> unique ID
+		OUTPUT: ---
+		*/
+		void Erase(String const& a_sID);
+		/*
+		USAGE: Gets the number of unique IDs in the table
+		ARGUMENTS: ---
+		OUTPUT: count
+		*/
+		uint GetCount(void);
+		/*
+		USAGE: Takes every unique ID out and frees the slots
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Clear(void);
+
+	private:
+		/*
+		USAGE: Finds the slot of a unique ID or the empty slot where it would go
+		ARGUMENTS:
+		- String const& a_sID -> unique ID
+		- size_t a_uHash -> hash of the unique ID
+		OUTPUT: slot
+		*/
+		uint FindSlot(String const& a_sID, size_t a_uHash);
+		/*
+		USAGE: Doubles the slots and inserts every unique ID again
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Grow(void);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYIDTABLECLASS_H_
@@ -0,0 +1,391 @@
+#include "MyLinearOctree.h"
+using namespace Simplex;
+
+const uint MyLinearOctree::m_uCodeLevels;
+
+MyLinearOctree::MyLinearOctree(uint a_nMaxLevel, uint a_nIdealEntityCount)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_uMaxLevel = std::min(a_nMaxLevel, m_uCodeLevels);
+	m_uIdealEntityCount = a_nIdealEntityCount;
+	m_bLinkEntities = true;
+
+	//take a snapshot of the bounding boxes of all entities
+	uint nObjects = m_pEntityMngr->GetEntityCount();
+	std::vector<vector3> lMin(nObjects);
+	std::vector<vector3> lMax(nObjects);
+	for (uint i = 0; i < nObjects; i++)
+	{
+		MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(i)->GetRigidBody();
+		lMin[i] = pRigidBody->GetMinGlobal();
+		lMax[i] = pRigidBody->GetMaxGlobal();
+	}
+
+	ConstructTree(lMin, lMax);
+	AssignIDtoEntity();
+
+	//the snapshot is up to date, earlier moves do not need to be applied
+	m_pEntityMngr->ClearMovedList();
+}
+
+MyLinearOctree::MyLinearOctree(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	uint a_nMaxLevel, uint a_nIdealEntityCount)
+{
+	m_pMeshMngr = MeshManager::GetInstance();
+	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_uMaxLevel = std::min(a_nMaxLevel, m_uCodeLevels);
+	m_uIdealEntityCount = a_nIdealEntityCount;
+	m_bLinkEntities = false;
+
+	ConstructTree(a_lMin, a_lMax);
+}
+
+MyLinearOctree::~MyLinearOctree(void)
+{
+	m_pMeshMngr = nullptr;
+	m_pEntityMngr = nullptr;
+}
+
+uint MyLinearOctree::GetOctantCount(void) { return m_lOctant.size(); }
+
+uint MyLinearOctree::ExpandBits(uint a_uValue)
+{
+	a_uValue &= 0x000003ff;
+	a_uValue = (a_uValue | (a_uValue << 16)) & 0xff0000ff;
+	a_uValue = (a_uValue | (a_uValue << 8)) & 0x0300f00f;
+	a_uValue = (a_uValue | (a_uValue << 4)) & 0x030c30c3;
+	a_uValue = (a_uValue | (a_uValue << 2)) & 0x09249249;
+	return a_uValue;
+}
+
+uint MyLinearOctree::CompactBits(uint a_uValue)
+{
+	a_uValue &= 0x09249249;
+	a_uValue = (a_uValue | (a_uValue >> 2)) & 0x030c30c3;
+	a_uValue = (a_uValue | (a_uValue >> 4)) & 0x0300f00f;
+	a_uValue = (a_uValue | (a_uValue >> 8)) & 0xff0000ff;
+	a_uValue = (a_uValue | (a_uValue >> 16)) & 0x000003ff;
+	return a_uValue;
+}
+
+bool MyLinearOctree::IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+	vector3 const& a_v3MinB, vector3 const& a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x) return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y) return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z) return false;
+	return true;
+}
+
+void MyLinearOctree::RadixSort(std::vector<uint>& a_lKey, std::vector<uint>& a_lValue)
+{
+	uint nCount = a_lKey.size();
+	std::vector<uint> lKeyTemp(nCount);
+	std::vector<uint> lValueTemp(nCount);
+
+	for (uint uShift = 0; uShift < 32; uShift += 8)
+	{
+		//count how many keys have each byte value
+		uint lOffset[256] = { 0 };
+		for (uint i = 0; i < nCount; i++)
+		{
+			lOffset[(a_lKey[i] >> uShift) & 0xff]++;
+		}
+
+		//if every key has the same byte there is nothing to move on this pass
+		if (nCount == 0 || lOffset[(a_lKey[0] >> uShift) & 0xff] == nCount)
+			continue;
+
+		//turn the counts into starting positions
+		uint uSum = 0;
+		for (uint i = 0; i < 256; i++)
+		{
+			uint uTemp = lOffset[i];
+			lOffset[i] = uSum;
+			uSum += uTemp;
+		}
+
+		//place each pair in its bucket keeping the order of the previous pass
+		for (uint i = 0; i < nCount; i++)
+		{
+			uint uTarget = lOffset[(a_lKey[i] >> uShift) & 0xff]++;
+			lKeyTemp[uTarget] = a_lKey[i];
+			lValueTemp[uTarget] = a_lValue[i];
+		}
+		a_lKey.swap(lKeyTemp);
+		a_lValue.swap(lValueTemp);
+	}
+}
+
+void MyLinearOctree::ConstructTree(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	uint nObjects = a_lMin.size();
+
+	//find min and max values among all entities to create the root cell
+	vector3 v3Min = vector3(0.0f);
+	vector3 v3Max = vector3(0.0f);
+	if (nObjects > 0)
+	{
+		v3Min = a_lMin[0];
+		v3Max = a_lMax[0];
+	}
+	for (uint i = 1; i < nObjects; i++)
+	{
+		v3Min = glm::min(v3Min, a_lMin[i]);
+		v3Max = glm::max(v3Max, a_lMax[i]);
+	}
+	vector3 v3Size = v3Max - v3Min;
+	m_fSize = std::max(v3Size.x, std::max(v3Size.y, v3Size.z));
+	m_v3Min = (v3Max + v3Min) / 2.0f - vector3(m_fSize / 2.0f);
+
+	//Morton code of the center of each entity at the deepest level
+	float fCells = static_cast<float>(1 << m_uCodeLevels);
+	float fScale = m_fSize > 0.0f ? fCells / m_fSize : 0.0f;
+	m_lCode.resize(nObjects);
+	m_lEntity.resize(nObjects);
+	for (uint i = 0; i < nObjects; i++)
+	{
+		vector3 v3Cell = ((a_lMin[i] + a_lMax[i]) / 2.0f - m_v3Min) * fScale;
+		uint uCode = 0;
+		for (uint k = 0; k < 3; k++)
+		{
+			float fCell = std::min(std::max(v3Cell[k], 0.0f), fCells - 1.0f);
+			uCode |= ExpandBits(static_cast<uint>(fCell)) << k;
+		}
+		m_lCode[i] = uCode;
+		m_lEntity[i] = i;
+	}
+
+	RadixSort(m_lCode, m_lEntity);
+
+	//keep the boxes in sorted order so the leafs read them in sequence
+	m_lEntityMin.resize(nObjects);
+	m_lEntityMax.resize(nObjects);
+	for (uint i = 0; i < nObjects; i++)
+	{
+		m_lEntityMin[i] = a_lMin[m_lEntity[i]];
+		m_lEntityMax[i] = a_lMax[m_lEntity[i]];
+	}
+
+	m_lOctant.clear();
+	ConstructOctant(0, 0, 0, nObjects);
+}
+
+void MyLinearOctree::ConstructOctant(uint a_uCode, uint a_uLevel, uint a_uFirst, uint a_uCount)
+{
+	//the octant is added before the ones below it, the array ends up in Morton order
+	uint uIndex = m_lOctant.size();
+	m_lOctant.push_back(LinearOctant());
+	m_lOctant[uIndex].uCode = a_uCode;
+	m_lOctant[uIndex].uLevel = a_uLevel;
+	m_lOctant[uIndex].uFirst = a_uFirst;
+	m_lOctant[uIndex].uCount = a_uCount;
+
+	vector3 v3Min = vector3(FLT_MAX);
+	vector3 v3Max = vector3(-FLT_MAX);
+
+	if (a_uCount > m_uIdealEntityCount && a_uLevel < m_uMaxLevel)
+	{
+		//sorted entities with the same next 3 bits are in the same child
+		uint uShift = 3 * (m_uCodeLevels - a_uLevel - 1);
+		uint uEnd = a_uFirst + a_uCount;
+		uint i = a_uFirst;
+		while (i < uEnd)
+		{
+			uint uChild = (m_lCode[i] >> uShift) & 7;
+			uint j = i + 1;
+			while (j < uEnd && ((m_lCode[j] >> uShift) & 7) == uChild)
+			{
+				j++;
+			}
+			ConstructOctant((a_uCode << 3) | uChild, a_uLevel + 1, i, j - i);
+			i = j;
+		}
+
+		//the box of the octant holds the boxes of its children
+		uint uChildIndex = uIndex + 1;
+		while (uChildIndex < m_lOctant.size())
+		{
+			v3Min = glm::min(v3Min, m_lOctant[uChildIndex].v3Min);
+			v3Max = glm::max(v3Max, m_lOctant[uChildIndex].v3Max);
+			uChildIndex = m_lOctant[uChildIndex].uSkip;
+		}
+	}
+	else
+	{
+		for (uint i = a_uFirst; i < a_uFirst + a_uCount; i++)
+		{
+			v3Min = glm::min(v3Min, m_lEntityMin[i]);
+			v3Max = glm::max(v3Max, m_lEntityMax[i]);
+		}
+	}
+
+	m_lOctant[uIndex].v3Min = v3Min;
+	m_lOctant[uIndex].v3Max = v3Max;
+	m_lOctant[uIndex].uSkip = m_lOctant.size();
+}
+
+void MyLinearOctree::AssignIDtoEntity(void)
+{
+	if (!m_bLinkEntities) return;
+
+	//an entity shares a leaf with every entity it overlaps as leafs hold the boxes of their entities
+	uint nObjects = m_lEntity.size();
+	uint nOctants = m_lOctant.size();
+	for (uint uEntity = 0; uEntity < nObjects; uEntity++)
+	{
+		vector3 const& v3Min = m_lEntityMin[uEntity];
+		vector3 const& v3Max = m_lEntityMax[uEntity];
+		uint i = 0;
+		while (i < nOctants)
+		{
+			LinearOctant const& octant = m_lOctant[i];
+			if (!IsOverlapping(octant.v3Min, octant.v3Max, v3Min, v3Max))
+			{
+				i = octant.uSkip;
+				continue;
+			}
+			if (octant.uSkip == i + 1)
+				m_pEntityMngr->AddDimension(m_lEntity[uEntity], i);
+			i++;
+		}
+	}
+}
+
+void MyLinearOctree::GetColliding(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput)
+{
+	uint nOctants = m_lOctant.size();
+	uint i = 0;
+	while (i < nOctants)
+	{
+		LinearOctant const& octant = m_lOctant[i];
+
+		//skip the octant and everything below it
+		if (!IsOverlapping(octant.v3Min, octant.v3Max, a_v3Min, a_v3Max))
+		{
+			i = octant.uSkip;
+			continue;
+		}
+
+		//leafs check their entities
+		if (octant.uSkip == i + 1)
+		{
+			for (uint uEntity = octant.uFirst; uEntity < octant.uFirst + octant.uCount; uEntity++)
+			{
+				if (IsOverlapping(m_lEntityMin[uEntity], m_lEntityMax[uEntity], a_v3Min, a_v3Max))
+					a_lOutput.push_back(m_lEntity[uEntity]);
+			}
+		}
+		i++;
+	}
+}
+
+void MyLinearOctree::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	uint nEntities = m_lEntity.size();
+	uint nOctants = m_lOctant.size();
+	for (uint uSorted = 0; uSorted < nEntities; uSorted++)
+	{
+		vector3 const& v3Min = m_lEntityMin[uSorted];
+		vector3 const& v3Max = m_lEntityMax[uSorted];
+
+		uint i = 0;
+		while (i < nOctants)
+		{
+			LinearOctant const& octant = m_lOctant[i];
+
+			//octants that end before this entity only hold pairs already added
+			if (octant.uFirst + octant.uCount <= uSorted ||
+				!IsOverlapping(octant.v3Min, octant.v3Max, v3Min, v3Max))
+			{
+				i = octant.uSkip;
+				continue;
+			}
+
+			if (octant.uSkip == i + 1)
+			{
+				uint uStart = std::max(octant.uFirst, uSorted + 1);
+				for (uint uOther = uStart; uOther < octant.uFirst + octant.uCount; uOther++)
+				{
+					if (!IsOverlapping(m_lEntityMin[uOther], m_lEntityMax[uOther], v3Min, v3Max)) continue;
+
+					uint uA = m_lEntity[uSorted];
+					uint uB = m_lEntity[uOther];
+					if (uA < uB)
+						a_lOutput.push_back(std::pair<uint, uint>(uA, uB));
+					else
+						a_lOutput.push_back(std::pair<uint, uint>(uB, uA));
+				}
+			}
+			i++;
+		}
+	}
+}
+
+uint MyLinearOctree::CountLeafs(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	uint nLeafs = 0;
+	uint nOctants = m_lOctant.size();
+	uint i = 0;
+	while (i < nOctants)
+	{
+		LinearOctant const& octant = m_lOctant[i];
+		if (!IsOverlapping(octant.v3Min, octant.v3Max, a_v3Min, a_v3Max))
+		{
+			i = octant.uSkip;
+			continue;
+		}
+		if (octant.uSkip == i + 1)
+			nLeafs++;
+		i++;
+	}
+	return nLeafs;
+}
+
+bool MyLinearOctree::IsColliding(uint a_uRBIndex)
+{
+	//if invalid entity index
+	if (a_uRBIndex >= m_pEntityMngr->GetEntityCount()) return false;
+
+	MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(a_uRBIndex)->GetRigidBody();
+	return IsOverlapping(m_v3Min, m_v3Min + vector3(m_fSize),
+		pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+}
+
+bool MyLinearOctree::IsColliding(uint a_uOctant, uint a_uRBIndex)
+{
+	//if invalid octant or entity index
+	if (a_uOctant >= m_lOctant.size()) return false;
+	if (a_uRBIndex >= m_pEntityMngr->GetEntityCount()) return false;
+
+	MyRigidBody* pRigidBody = m_pEntityMngr->GetEntity(a_uRBIndex)->GetRigidBody();
+	return IsOverlapping(m_lOctant[a_uOctant].v3Min, m_lOctant[a_uOctant].v3Max,
+		pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+}
+
+void MyLinearOctree::Display(uint a_nIndex, vector3 a_v3Color)
+{
+	//if invalid octant index
+	if (a_nIndex >= m_lOctant.size()) return;
+
+	//the cell is found from the bits of its code
+	LinearOctant const& octant = m_lOctant[a_nIndex];
+	float fSize = m_fSize / static_cast<float>(1 << octant.uLevel);
+	vector3 v3Cell = vector3(static_cast<float>(CompactBits(octant.uCode)),
+		static_cast<float>(CompactBits(octant.uCode >> 1)),
+		static_cast<float>(CompactBits(octant.uCode >> 2)));
+	vector3 v3Center = m_v3Min + (v3Cell + vector3(0.5f)) * fSize;
+
+	m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, v3Center) *
+		glm::scale(vector3(fSize)), a_v3Color, RENDER_WIRE);
+}
+
+void MyLinearOctree::Display(vector3 a_v3Color)
+{
+	uint nOctants = m_lOctant.size();
+	for (uint i = 0; i < nOctants; i++)
+	{
+		Display(i, a_v3Color);
+	}
+}
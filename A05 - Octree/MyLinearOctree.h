@@ -0,0 +1,205 @@
+#ifndef __MYLINEAROCTREECLASS_H_
+#define __MYLINEAROCTREECLASS_H_
+
+#include "MyEntityManager.h"
+
+#include <cfloat>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyLinearOctree
+	{
+		//Node of the tree, nodes are stored in Morton order (depth first) in a single array
+		struct LinearOctant
+		{
+			uint uCode = 0; //Morton code of the cell (3 bits per level, from the root)
+			uint uLevel = 0; //level of the cell
+			uint uFirst = 0; //first Entity of the cell in the sorted list
+			uint uCount = 0; //number of Entities in the cell and all cells below it
+			uint uSkip = 0; //index of the next octant once this one and all below it are skipped
+			vector3 v3Min = vector3(0.0f); //minimum corner of the Entities in the cell
+			vector3 v3Max = vector3(0.0f); //maximum corner of the Entities in the cell
+		};
+
+		static const uint m_uCodeLevels = 10; //bits per axis in the Morton code, deepest level possible
+
+		uint m_uMaxLevel = 3; //will store the maximum level an octant can go to
+		uint m_uIdealEntityCount = 5; //will tell how many ideal Entities an octant will contain
+		bool m_bLinkEntities = true; //will the leafs set their ID as a dimension in the Entity Manager
+
+		MeshManager* m_pMeshMngr = nullptr;//Mesh Manager singleton
+		MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
+
+		vector3 m_v3Min = vector3(0.0f); //minimum corner of the root cell
+		float m_fSize = 0.0f; //size of the root cell
+
+		std::vector<LinearOctant> m_lOctant; //all the octants of the tree in Morton order
+		std::vector<uint> m_lEntity; //index of the Entities sorted by the Morton code of their center
+		std::vector<uint> m_lCode; //Morton code of the Entities in sorted order
+		std::vector<vector3> m_lEntityMin; //minimum corner of the Entities in sorted order
+		std::vector<vector3> m_lEntityMax; //maximum corner of the Entities in sorted order
+
+	public:
+		/*
+		USAGE: Constructor, will create a linear octree containing all the Entities in the Entity
+		Manager and set the leafs as their dimensions
+		ARGUMENTS:
+		- uint a_nMaxLevel = 2 -> Sets the maximum level of subdivision (10 at most)
+		- uint nIdealEntityCount = 5 -> Sets the ideal level of objects per octant
+		OUTPUT: class object
+		*/
+		MyLinearOctree(uint a_nMaxLevel = 2, uint a_nIdealEntityCount = 5);
+		/*
+		USAGE: Constructor, will create a linear octree containing the bounding boxes provided,
+		no dimensions will be assigned (used for benchmarking)
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of each bounding box
+		- std::vector<vector3> const& a_lMax -> maximum corner of each bounding box
+		- uint a_nMaxLevel -> Sets the maximum level of subdivision (10 at most)
+		- uint a_nIdealEntityCount -> Sets the ideal level of objects per octant
+		OUTPUT: class object
+		*/
+		MyLinearOctree(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			uint a_nMaxLevel, uint a_nIdealEntityCount);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyLinearOctree(void);
+		/*
+		USAGE: Gets the total number of octants in the tree
+		ARGUMENTS: ---
+		OUTPUT: octant count
+		*/
+		uint GetOctantCount(void);
+		/*
+		USAGE: Asks if the root cell collides with the Entity specified by index
+		ARGUMENTS: uint a_uRBIndex -> Index of the Entity in the Entity Manager
+		OUTPUT: check of the collision
+		*/
+		bool IsColliding(uint a_uRBIndex);
+		/*
+		USAGE: Asks if the Entities of the octant specified collide with the Entity specified
+		ARGUMENTS:
+		- uint a_uOctant -> index of the octant
+		- uint a_uRBIndex -> Index of the Entity in the Entity Manager
+		OUTPUT: check of the collision
+		*/
+		bool IsColliding(uint a_uOctant, uint a_uRBIndex);
+		/*
+		USAGE: Gets the Entities whose bounding box overlaps the box specified, the tree is walked
+		in order skipping the octants that do not overlap it
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetColliding(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Counts the leafs whose Entities overlap the box specified
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		OUTPUT: number of leafs
+		*/
+		uint CountLeafs(vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Gets every pair of Entities whose bounding boxes overlap, each Entity is stored once
+		so each one walks the tree looking for the ones after it in Morton order, each pair is
+		added once with the smaller index first
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput);
+		/*
+		USAGE: Displays the cell of the octant specified by index
+		ARGUMENTS:
+		- uint a_nIndex -> octant to be displayed.
+		- vector3 a_v3Color = C_YELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(uint a_nIndex, vector3 a_v3Color = C_YELLOW);
+		/*
+		USAGE: Displays the cells of all octants in the color specified
+		ARGUMENTS: vector3 a_v3Color = C_YELLOW -> Color of the volume to display.
+		OUTPUT: ---
+		*/
+		void Display(vector3 a_v3Color = C_YELLOW);
+
+	private:
+		/*
+		USAGE: Copy Constructor, deleted so the tree cannot be copied
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyLinearOctree(MyLinearOctree const& other) = delete;
+		/*
+		USAGE: Copy Assignment Operator, deleted so the tree cannot be copied
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyLinearOctree& operator=(MyLinearOctree const& other) = delete;
+		/*
+		USAGE: Sorts the boxes by Morton code and builds the octants over them
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of each bounding box
+		- std::vector<vector3> const& a_lMax -> maximum corner of each bounding box
+		OUTPUT: ---
+		*/
+		void ConstructTree(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax);
+		/*
+		USAGE: Adds the octant for the sorted Entities in the range and the octants below it
+		ARGUMENTS:
+		- uint a_uCode -> Morton code of the cell
+		- uint a_uLevel -> level of the cell
+		- uint a_uFirst -> first sorted Entity in the cell
+		- uint a_uCount -> number of sorted Entities in the cell
+		OUTPUT: ---
+		*/
+		void ConstructOctant(uint a_uCode, uint a_uLevel, uint a_uFirst, uint a_uCount);
+		/*
+		USAGE: Sets the leafs whose Entities overlap each Entity as the dimensions of it
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void AssignIDtoEntity(void);
+		/*
+		USAGE: Asks if two boxes overlap
+		ARGUMENTS:
+		- vector3 const& a_v3MinA -> minimum corner of the first box
+		- vector3 const& a_v3MaxA -> maximum corner of the first box
+		- vector3 const& a_v3MinB -> minimum corner of the second box
+		- vector3 const& a_v3MaxB -> maximum corner of the second box
+		OUTPUT: do they overlap?
+		*/
+		static bool IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+			vector3 const& a_v3MinB, vector3 const& a_v3MaxB);
+		/*
+		USAGE: Sorts the keys and values by key, 8 bits per pass
+		ARGUMENTS:
+		- std::vector<uint>& a_lKey -> keys to sort
+		- std::vector<uint>& a_lValue -> values that follow their key
+		OUTPUT: ---
+		*/
+		static void RadixSort(std::vector<uint>& a_lKey, std::vector<uint>& a_lValue);
+		/*
+		USAGE: Spreads the lower 10 bits of the value so there are two empty bits between each
+		ARGUMENTS: uint a_uValue -> value to spread
+		OUTPUT: spread value
+		*/
+		static uint ExpandBits(uint a_uValue);
+		/*
+		USAGE: Undoes ExpandBits
+		ARGUMENTS: uint a_uValue -> spread value
+		OUTPUT: compact value
+		*/
+		static uint CompactBits(uint a_uValue);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYLINEAROCTREECLASS_H_
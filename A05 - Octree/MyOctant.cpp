@@ -1,26 +1,36 @@
 #include "MyOctant.h"
 using namespace Simplex;
 
-//set default values
-uint MyOctant::m_uOctantCount = 0;
-uint MyOctant::m_uMaxLevel = 3;
-uint MyOctant::m_uIdealEntityCount = 5;
+const uint MyOctant::m_uPoolChunkBlocks;
+const uint MyOctant::m_uSliceEntities;
+const uint MyOctant::m_uSliceSearches;
+const uint MyOctant::m_uNotOutside;
 
 
-uint MyOctant::GetOctantCount(void) { return m_uOctantCount; }
+uint MyOctant::GetOctantCount(void) { return m_pRoot->m_pTree->uOctantCount; }
+
+void MyOctant::SetBuildThreads(uint a_uThreadCount, uint a_uCutoff)
+{
+	m_pRoot->m_pTree->uBuildThreadCount = a_uThreadCount;
+	m_pRoot->m_pTree->uParallelCutoff = std::max(a_uCutoff, 1u);
+}
+
+uint MyOctant::GetBuildThreadCount(void) { return m_pRoot->m_pTree->uBuildThreadCount; }
 
 //initialize octant to default empty values
 void MyOctant::Init(void)
 {
 	m_uChildren = 0;
 	m_fSize = 0.0f;
-	m_uID = m_uOctantCount;
+	m_uID = 0;
 	m_uLevel = 0;
 	m_v3Center = vector3(0.0f);
 	m_v3Min = vector3(0.0f);
 	m_v3Max = vector3(0.0f);
-	m_pMeshMngr = MeshManager::GetInstance();
-	m_pEntityMngr = MyEntityManager::GetInstance();
+	m_v3EntityMin = vector3(FLT_MAX);
+	m_v3EntityMax = vector3(-FLT_MAX);
+	m_v3BranchMin = vector3(FLT_MAX);
+	m_v3BranchMax = vector3(-FLT_MAX);
 	for (uint i = 0; i < 8; i++)
 	{
 		m_pChild[i] = nullptr;
@@ -34,14 +44,15 @@ void MyOctant::Swap(MyOctant& other)
 	std::swap(m_fSize, other.m_fSize);
 	std::swap(m_uID, other.m_uID);
 	std::swap(m_pRoot, other.m_pRoot);
-	std::swap(m_lChild, other.m_lChild);
+	std::swap(m_pTree, other.m_pTree);
+	std::swap(m_EntityList, other.m_EntityList);
 	std::swap(m_v3Center, other.m_v3Center);
 	std::swap(m_v3Min, other.m_v3Min);
 	std::swap(m_v3Max, other.m_v3Max);
-
-	m_pMeshMngr = MeshManager::GetInstance();
-	m_pEntityMngr = MyEntityManager::GetInstance();
-
+	std::swap(m_v3EntityMin, other.m_v3EntityMin);
+	std::swap(m_v3EntityMax, other.m_v3EntityMax);
+	std::swap(m_v3BranchMin, other.m_v3BranchMin);
+	std::swap(m_v3BranchMax, other.m_v3BranchMax);
 	std::swap(m_uLevel, other.m_uLevel);
 	std::swap(m_pParent, other.m_pParent);
 	for (uint i = 0; i < 8; i++)
@@ -56,334 +67,2343 @@ MyOctant* MyOctant::GetParent(void) { return m_pParent; }
 void MyOctant::Release(void)
 {
 	if (m_uLevel == 0) KillBranches();
+	if (this == m_pRoot) ReleasePool();
 	m_uChildren = 0;
 	m_fSize = 0.0f;
 	m_EntityList.clear();
-	m_lChild.clear();
+
+	//the lists of the tree go with the state the root owns
+	SafeDelete(m_pTree);
 }
 
-//create octant with predetermined max level and ideal entity count
-MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount)
+void MyOctant::ReleasePool(void)
 {
-	Init();
-
-	m_uOctantCount = 0;
-	m_uMaxLevel = a_nMaxLevel;
-	m_uIdealEntityCount = a_nIdealEntityCount;
-	m_uID = m_uOctantCount;
+	//octants in the pool only own their lists, destroy them and free the chunks
+	for (uint i = 0; i < m_pTree->uPoolBlockCount; i++)
+	{
+		MyOctant* pBlock = GetPoolBlock(i);
+		for (uint j = 0; j < 8; j++)
+		{
+			pBlock[j].~MyOctant();
+		}
+	}
+	for (uint i = 0; i < m_pTree->lPoolChunk.size(); i++)
+	{
+		::operator delete(m_pTree->lPoolChunk[i]);
+	}
+	m_pTree->lPoolChunk.clear();
+	m_pTree->lPoolFree.clear();
+	m_pTree->uPoolBlockCount = 0;
+	m_pTree->uPoolBlockUsed = 0;
+}
 
-	m_pRoot = this;
-	m_lChild.clear();
+MyOctant* MyOctant::GetPoolBlock(uint a_uBlock)
+{
+	return m_pTree->lPoolChunk[a_uBlock / m_uPoolChunkBlocks] + (a_uBlock % m_uPoolChunkBlocks) * 8;
+}
 
-	std::vector<vector3> lMinMax;
+MyOctant* MyOctant::AcquireBlock(void)
+{
+	//the tasks of a parallel build take blocks at the same time
+	std::unique_lock<std::mutex> lock(m_pTree->PoolMutex, std::defer_lock);
+	if (m_pTree->bParallelBuild)
+		lock.lock();
 
-	//find min and max values among all entities to create octant size
-	uint nObjects = m_pEntityMngr->GetEntityCount();
-	for (uint i = 0; i < nObjects; i++)
+	//blocks given back by merges first
+	if (!m_pTree->lPoolFree.empty())
 	{
-		MyEntity* pEntity = m_pEntityMngr->GetEntity(i);
-		MyRigidBody* pRigidBody = pEntity->GetRigidBody();
-		lMinMax.push_back(pRigidBody->GetMinGlobal());
-		lMinMax.push_back(pRigidBody->GetMaxGlobal());
+		MyOctant* pBlock = m_pTree->lPoolFree.back();
+		m_pTree->lPoolFree.pop_back();
+		return pBlock;
 	}
 
-	MyRigidBody* pRigidBody = new MyRigidBody(lMinMax);
+	//then the blocks of earlier builds, in the same order so octants get lists of about the right size
+	if (m_pTree->uPoolBlockUsed < m_pTree->uPoolBlockCount)
+		return GetPoolBlock(m_pTree->uPoolBlockUsed++);
 
-	//find halfwidth of octant
-	vector3 vHalfWidth = pRigidBody->GetHalfWidth();
-	float fMax = vHalfWidth.x;
-	for (int i = 0; i < 3; i++)
+	//the pool is full, construct a new block (and a new chunk if the last one is full)
+	if (m_pTree->uPoolBlockCount == m_pTree->lPoolChunk.size() * m_uPoolChunkBlocks)
+		m_pTree->lPoolChunk.push_back(static_cast<MyOctant*>(::operator new(sizeof(MyOctant) * 8 * m_uPoolChunkBlocks)));
+
+	MyOctant* pBlock = GetPoolBlock(m_pTree->uPoolBlockCount);
+	for (uint i = 0; i < 8; i++)
 	{
-		if (fMax < vHalfWidth[i]) fMax = vHalfWidth[i];
+		new (pBlock + i) MyOctant(this);
 	}
-
-	//set center of octree
-	vector3 v3Center = pRigidBody->GetCenterLocal();
-	lMinMax.clear();
-	SafeDelete(pRigidBody);
-
-	//set dimensions of octant (size, center, min, and max)
-	m_fSize = fMax * 2.0f;
-	m_v3Center = v3Center;
-	m_v3Min = m_v3Center - (vector3(fMax)); //center - halfwidth
-	m_v3Max = m_v3Center + (vector3(fMax)); //center + halfwidth
-	m_uOctantCount++; //increment octant count
-	ConstructTree(m_uMaxLevel); //construct tree from with set max level
+	m_pTree->uPoolBlockCount++;
+	m_pTree->uPoolBlockUsed++;
+	return pBlock;
 }
 
+uint MyOctant::GetPoolAllocationCount(void) { return m_pRoot->m_pTree->lPoolChunk.size(); }
 
-//create octant with predetermined center and size
-MyOctant::MyOctant(vector3 a_v3Center, float a_fSize)
+bool MyOctant::IsLoose(void) { return m_pRoot->m_pTree->bLoose; }
+
+float MyOctant::GetDuplicationFactor(void)
 {
-	Init();
-	m_v3Center = a_v3Center;
-	m_fSize = a_fSize;
-	m_v3Min = m_v3Center - (vector3(m_fSize) / 2.0f);
-	m_v3Max = m_v3Center + (vector3(m_fSize) / 2.0f);
-	m_uOctantCount++;
+	uint nEntities = m_pRoot->m_pTree->lEntityMin.size();
+	if (nEntities == 0) return 0.0f;
+
+	//count every entry of every list in the tree
+	uint nStored = 0;
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(m_pRoot);
+	while (!lStack.empty())
+	{
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+		nStored += pOctant->m_EntityList.size();
+		for (uint i = 0; i < pOctant->m_uChildren; i++)
+		{
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
+	}
+	return nStored / static_cast<float>(nEntities);
 }
 
-MyOctant::MyOctant(MyOctant const& other)
+void MyOctant::GetStats(Stats& a_Output)
 {
-	m_uChildren = other.m_uChildren;
-	m_v3Center = other.m_v3Center;
-	m_v3Min = other.m_v3Min;
-	m_v3Max = other.m_v3Max;
-	m_fSize = other.m_fSize;
-	m_uID = other.m_uID;
-	m_uLevel = other.m_uLevel;
-	m_pParent = other.m_pParent;
-	m_pRoot = other.m_pRoot;
-	m_lChild = other.m_lChild;
+	a_Output = Stats();
+	a_Output.uEntityCount = m_pRoot->m_pTree->lEntityMin.size();
+	a_Output.dBuildMs = m_pRoot->m_pTree->dBuildMs;
+
+	//leafs up to twice the ideal count get a bucket of their own
+	uint uLastBucket = m_pRoot->m_pTree->uIdealEntityCount * 2;
+	a_Output.lLeafOccupancy.resize(uLastBucket + 1, 0);
+
+	uint nStored = 0;
+	size_t uListBytes = 0;
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(m_pRoot);
+	while (!lStack.empty())
+	{
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+
+		uint nEntities = pOctant->m_EntityList.size();
+		nStored += nEntities;
+		uListBytes += pOctant->m_EntityList.capacity() * sizeof(uint);
+		a_Output.uOctantCount++;
+		if (a_Output.lLevelOctants.size() <= pOctant->m_uLevel)
+			a_Output.lLevelOctants.resize(pOctant->m_uLevel + 1, 0);
+		a_Output.lLevelOctants[pOctant->m_uLevel]++;
+
+		if (pOctant->m_uChildren == 0)
+		{
+			a_Output.uLeafCount++;
+			if (nEntities == 0)
+				a_Output.uEmptyLeafCount++;
+			a_Output.lLeafOccupancy[std::min(nEntities, uLastBucket)]++;
+			a_Output.uMaxLeafEntities = std::max(a_Output.uMaxLeafEntities, nEntities);
+		}
+		else
+		{
+			a_Output.uBranchEntities += nEntities;
+		}
 
-	m_pMeshMngr = MeshManager::GetInstance();
-	m_pEntityMngr = MyEntityManager::GetInstance();
+		for (uint i = 0; i < pOctant->m_uChildren; i++)
+		{
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
+	}
+	if (a_Output.uEntityCount > 0)
+		a_Output.fDuplication = nStored / static_cast<float>(a_Output.uEntityCount);
 
-	for (uint i = 0; i < 8; i++)
+	//the octants of the pool are there whether they are in the tree or not, so are the lists they keep
+	TreeState* pTree = m_pRoot->m_pTree;
+	for (uint uBlock = pTree->uPoolBlockUsed; uBlock < pTree->uPoolBlockCount; uBlock++)
 	{
-		m_pChild[i] = other.m_pChild[i];
+		MyOctant* pBlock = m_pRoot->GetPoolBlock(uBlock);
+		for (uint i = 0; i < 8; i++)
+		{
+			uListBytes += pBlock[i].m_EntityList.capacity() * sizeof(uint);
+		}
 	}
+	a_Output.uMemoryBytes = sizeof(MyOctant) + sizeof(TreeState) + uListBytes
+		+ pTree->lPoolChunk.size() * m_uPoolChunkBlocks * 8 * sizeof(MyOctant)
+		+ (pTree->lEntityMin.capacity() + pTree->lEntityMax.capacity()) * sizeof(vector3)
+		+ (pTree->lOutsideMin.capacity() + pTree->lOutsideMax.capacity()) * sizeof(vector3)
+		+ (pTree->lOutside.capacity() + pTree->lOutsideSlot.capacity()) * sizeof(uint)
+		+ (pTree->lChild.capacity() + pTree->lPoolChunk.capacity() + pTree->lPoolFree.capacity()) * sizeof(MyOctant*)
+		+ (pTree->lDimension.capacity() + pTree->lDimensionFirst.capacity()) * sizeof(uint);
 }
 
-MyOctant& MyOctant::operator=(MyOctant const& other)
+String MyOctant::GetStatsJSON(Stats const& a_Stats)
 {
-	if (this != &other)
+	std::stringstream sJSON;
+	sJSON << "{\n";
+	sJSON << "\t\"octants\": " << a_Stats.uOctantCount << ",\n";
+	sJSON << "\t\"entities\": " << a_Stats.uEntityCount << ",\n";
+	sJSON << "\t\"level_octants\": [";
+	for (uint i = 0; i < a_Stats.lLevelOctants.size(); i++)
 	{
-		Release();
-		Init();
-		MyOctant temp(other);
-		Swap(temp);
+		sJSON << (i > 0 ? ", " : "") << a_Stats.lLevelOctants[i];
 	}
-	return *this;
+	sJSON << "],\n";
+	sJSON << "\t\"leafs\": " << a_Stats.uLeafCount << ",\n";
+	sJSON << "\t\"empty_leafs\": " << a_Stats.uEmptyLeafCount << ",\n";
+	sJSON << "\t\"leaf_occupancy\": [";
+	for (uint i = 0; i < a_Stats.lLeafOccupancy.size(); i++)
+	{
+		sJSON << (i > 0 ? ", " : "") << a_Stats.lLeafOccupancy[i];
+	}
+	sJSON << "],\n";
+	sJSON << "\t\"max_leaf_entities\": " << a_Stats.uMaxLeafEntities << ",\n";
+	sJSON << "\t\"branch_entities\": " << a_Stats.uBranchEntities << ",\n";
+	sJSON << "\t\"duplication\": " << a_Stats.fDuplication << ",\n";
+	sJSON << "\t\"build_ms\": " << a_Stats.dBuildMs << ",\n";
+	sJSON << "\t\"memory_bytes\": " << a_Stats.uMemoryBytes << "\n";
+	sJSON << "}\n";
+	return sJSON.str();
 }
 
-MyOctant::~MyOctant() { Release(); }
-
-float MyOctant::GetSize(void) { return m_fSize; }
+void MyOctant::GetDimensions(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput)
+{
+	//the bounds of the branch hold all the entities below, the ones of the stored entities are tighter
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		if (!IsOverlapping(m_v3BranchMin, m_v3BranchMax, a_v3Min, a_v3Max)) return;
+		if (m_EntityList.size() > 0 && IsOverlapping(m_v3EntityMin, m_v3EntityMax, a_v3Min, a_v3Max))
+			a_lOutput.push_back(m_uID);
+	}
+	else
+	{
+		if (!IsColliding(a_v3Min, a_v3Max)) return;
+		if (m_uChildren == 0 && m_EntityList.size() > 0)
+			a_lOutput.push_back(m_uID);
+	}
 
-vector3 MyOctant::GetCenterGlobal(void) { return m_v3Center; }
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetDimensions(a_v3Min, a_v3Max, a_lOutput);
+	}
+}
 
-vector3 MyOctant::GetMinGlobal(void) { return m_v3Min; }
+void MyOctant::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	if (this != m_pRoot) return;
 
-vector3 MyOctant::GetMaxGlobal(void) { return m_v3Max; }
+	//the boxes of each octant are copied here to be tested side by side
+	MyBoxArray boxes;
+	std::vector<uint>& lHit = m_pTree->lPairHit;
+	if (lHit.size() < m_pTree->lEntityMin.size())
+		lHit.resize(m_pTree->lEntityMin.size());
 
-void MyOctant::Display(uint a_nIndex, vector3 a_v3Color)
-{
-	//display octant with specific index: 'a_nIndex'
-	if (m_uID == a_nIndex)
+	if (!m_pTree->bLoose)
 	{
-		m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
-			glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
+		GetLeafPairs(a_lOutput, boxes, lHit);
 		return;
 	}
 
-	//display all children of octant
-	for (uint i = 0; i < m_uChildren; i++)
+	//every entity is stored once, go through the octants holding them
+	std::vector<MyOctant*> lStack;
+	lStack.push_back(this);
+	while (!lStack.empty())
 	{
-		m_pChild[i]->Display(a_nIndex);
+		MyOctant* pOctant = lStack.back();
+		lStack.pop_back();
+
+		if (pOctant->m_EntityList.size() > 0)
+			GetLoosePairs(pOctant, a_lOutput, boxes, lHit);
+		for (uint i = 0; i < pOctant->m_uChildren; i++)
+		{
+			lStack.push_back(pOctant->m_pChild[i]);
+		}
 	}
 }
 
-void MyOctant::Display(vector3 a_v3Color)
+void MyOctant::GetLeafPairs(std::vector<std::pair<uint, uint>>& a_lOutput, MyBoxArray& a_Boxes, std::vector<uint>& a_lHit)
 {
 	for (uint i = 0; i < m_uChildren; i++)
 	{
-		m_pChild[i]->Display(a_v3Color);
+		m_pChild[i]->GetLeafPairs(a_lOutput, a_Boxes, a_lHit);
 	}
-	m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
-		glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
-}
+	if (m_uChildren != 0) return;
 
-void MyOctant::Subdivide(void)
-{
-	//if already at max level
-	if (m_uLevel >= m_uMaxLevel) return;
+	uint nEntities = m_EntityList.size();
+	if (nEntities < 2) return;
 
-	//if octant has children already
-	if (m_uChildren != 0) return;
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	a_Boxes.Gather(lMin, lMax, m_EntityList);
 
-	m_uChildren = 8;
-	float fSize = m_fSize / 4.0f;
-	float fSizeD = fSize * 2.0f;
-	vector3 v3Center;
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint uA = m_EntityList[i];
+		uint nHits = a_Boxes.Overlap(lMin[uA], lMax[uA], i + 1, nEntities, a_lHit.data());
+		for (uint j = 0; j < nHits; j++)
+		{
+			uint uB = m_EntityList[a_lHit[j]];
 
-	//set positions and create children octants
-	v3Center = m_v3Center;
-	v3Center.x -= fSize;
-	v3Center.y -= fSize;
-	v3Center.z -= fSize;
-	m_pChild[0] = new MyOctant(v3Center, fSizeD);
+			//both are in every leaf the overlap touches, only the leaf holding its minimum corner adds the pair
+			if (!IsOwner(glm::max(lMin[uA], lMin[uB]))) continue;
 
-	v3Center.x += fSizeD;
-	m_pChild[1] = new MyOctant(v3Center, fSizeD);
+			if (uA < uB)
+				a_lOutput.push_back(std::pair<uint, uint>(uA, uB));
+			else
+				a_lOutput.push_back(std::pair<uint, uint>(uB, uA));
+		}
+	}
+}
 
-	v3Center.z += fSizeD;
-	m_pChild[2] = new MyOctant(v3Center, fSizeD);
+void MyOctant::GetLoosePairs(MyOctant* a_pOctant, std::vector<std::pair<uint, uint>>& a_lOutput, MyBoxArray& a_Boxes,
+	std::vector<uint>& a_lHit)
+{
+	vector3 const& v3Min = a_pOctant->m_v3EntityMin;
+	vector3 const& v3Max = a_pOctant->m_v3EntityMax;
+	if (!IsOverlapping(m_v3BranchMin, m_v3BranchMax, v3Min, v3Max)) return;
 
-	v3Center.x -= fSizeD;
-	m_pChild[3] = new MyOctant(v3Center, fSizeD);
+	//the other octant finds this one too, only the one with the smaller ID adds the pairs
+	uint nEntities = m_EntityList.size();
+	if (nEntities > 0 && m_uID >= a_pOctant->m_uID && IsOverlapping(m_v3EntityMin, m_v3EntityMax, v3Min, v3Max))
+	{
+		std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+		std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+		a_Boxes.Gather(lMin, lMax, m_EntityList);
 
-	v3Center.y += fSizeD;
-	m_pChild[4] = new MyOctant(v3Center, fSizeD);
+		std::vector<uint> const& lOther = a_pOctant->m_EntityList;
+		uint nOthers = lOther.size();
+		for (uint i = 0; i < nOthers; i++)
+		{
+			uint uA = lOther[i];
 
-	v3Center.z -= fSizeD;
-	m_pChild[5] = new MyOctant(v3Center, fSizeD);
+			//pairs inside of the same octant are only added once
+			uint nHits = a_Boxes.Overlap(lMin[uA], lMax[uA], this == a_pOctant ? i + 1 : 0, nEntities, a_lHit.data());
+			for (uint j = 0; j < nHits; j++)
+			{
+				uint uB = m_EntityList[a_lHit[j]];
+				if (uA < uB)
+					a_lOutput.push_back(std::pair<uint, uint>(uA, uB));
+				else
+					a_lOutput.push_back(std::pair<uint, uint>(uB, uA));
+			}
+		}
+	}
 
-	v3Center.x += fSizeD;
-	m_pChild[6] = new MyOctant(v3Center, fSizeD);
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetLoosePairs(a_pOctant, a_lOutput, a_Boxes, a_lHit);
+	}
+}
 
-	v3Center.z += fSizeD;
-	m_pChild[7] = new MyOctant(v3Center, fSizeD);
+void MyOctant::GetVisible(matrix4 const& a_m4ViewProjection, std::vector<uint>& a_lOutput)
+{
+	if (this != m_pRoot) return;
 
-	for (uint i = 0; i < 8; i++)
+	//planes of the frustum from the rows of the matrix, a point is inside when all of them are
+	//positive (glm stores the matrix by columns)
+	vector4 v4Row[4];
+	for (uint i = 0; i < 4; i++)
 	{
-		//set childrens' root, parent, level, and subdivide if necessary (contains too many entities)
-		m_pChild[i]->m_pRoot = m_pRoot;
-		m_pChild[i]->m_pParent = this;
-		m_pChild[i]->m_uLevel = m_uLevel + 1; //set to one more level than current
-		if (m_pChild[i]->ContainsMoreThan(m_uIdealEntityCount))
+		v4Row[i] = vector4(a_m4ViewProjection[0][i], a_m4ViewProjection[1][i],
+			a_m4ViewProjection[2][i], a_m4ViewProjection[3][i]);
+	}
+	vector4 v4Plane[6];
+	for (uint i = 0; i < 3; i++)
+	{
+		v4Plane[i * 2] = v4Row[3] + v4Row[i];
+		v4Plane[i * 2 + 1] = v4Row[3] - v4Row[i];
+	}
+
+	uint uFirst = a_lOutput.size();
+	GetVisibleBranch(v4Plane, a_lOutput);
+
+	//entities of a regular octree are in every leaf they overlap, keep the first time each shows up
+	if (!m_pTree->bLoose)
+	{
+		uint uStamp = NextQueryStamp();
+		uint nVisible = uFirst;
+		for (uint i = uFirst; i < a_lOutput.size(); i++)
 		{
-			m_pChild[i]->Subdivide();
+			uint uEntity = a_lOutput[i];
+			if (m_pTree->lQueryStamp[uEntity] == uStamp) continue;
+			m_pTree->lQueryStamp[uEntity] = uStamp;
+			a_lOutput[nVisible++] = uEntity;
 		}
+		a_lOutput.resize(nVisible);
 	}
-}
 
-MyOctant* MyOctant::GetChild(uint a_nChild)
-{
-	//if invalid index
-	if (a_nChild > 7) return nullptr;
-	return m_pChild[a_nChild];
+	//the octants do not hold the boxes that left the root, test those whole
+	uint nOutside = m_pTree->lOutside.size();
+	for (uint i = 0; i < nOutside; i++)
+	{
+		if (ClassifyBox(v4Plane, m_pTree->lOutsideMin[i], m_pTree->lOutsideMax[i]) >= 0)
+			a_lOutput.push_back(m_pTree->lOutside[i]);
+	}
 }
 
-bool MyOctant::IsColliding(uint a_uRBIndex)
+void MyOctant::GetVisibleBranch(vector4 const* a_pPlane, std::vector<uint>& a_lOutput)
 {
-	uint nObjectCount = m_pEntityMngr->GetEntityCount();
-	//if invalid entity index
-	if (a_uRBIndex >= nObjectCount) return false;
+	//the bounds of the branch of a loose octree hold the entities below it, octants of a regular
+	//octree hold theirs; entities clamped to the root when they moved out are in the outside list
+	int nSide = m_pRoot->m_pTree->bLoose ? ClassifyBox(a_pPlane, m_v3BranchMin, m_v3BranchMax)
+		: ClassifyBox(a_pPlane, m_v3Min, m_v3Max);
+	if (nSide < 0) return;
+	if (nSide > 0)
+	{
+		GetBranchEntities(a_lOutput);
+		return;
+	}
 
-	//get position of entity at index: 'a_uRBIndex'
-	MyEntity* pEntity = m_pEntityMngr->GetEntity(a_uRBIndex);
-	MyRigidBody* pRigidBody = pEntity->GetRigidBody();
-	vector3 v3MinO = pRigidBody->GetMinGlobal();
-	vector3 v3MaxO = pRigidBody->GetMaxGlobal();
+	//crossing the frustum, test the entities themselves
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	uint nEntities = m_EntityList.size();
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint uEntity = m_EntityList[i];
+		if (IsOutside(uEntity)) continue;
+		if (ClassifyBox(a_pPlane, lMin[uEntity], lMax[uEntity]) >= 0)
+			a_lOutput.push_back(uEntity);
+	}
 
-	//check if colliding (by seeing if entity is outside bounds of octant)
-	if (m_v3Max.x < v3MinO.x) return false;
-	if (m_v3Min.x > v3MaxO.x) return false;
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetVisibleBranch(a_pPlane, a_lOutput);
+	}
+}
 
-	if (m_v3Max.y < v3MinO.y) return false;
-	if (m_v3Min.y > v3MaxO.y) return false;
+bool MyOctant::GetNearestHit(vector3 const& a_v3Origin, vector3 const& a_v3Direction, uint& a_uEntity,
+	float& a_fDistance, float a_fMaxDistance)
+{
+	if (this != m_pRoot) return false;
 
-	if (m_v3Max.z < v3MinO.z) return false;
-	if (m_v3Min.z > v3MaxO.z) return false;
+	RayQuery query;
+	CastRay(query, a_v3Origin, a_v3Direction, a_fMaxDistance);
+	if (!query.bHit) return false;
 
+	a_uEntity = query.uEntity;
+	a_fDistance = query.fMaxDistance;
 	return true;
 }
 
-bool MyOctant::IsLeaf(void) { return m_uChildren == 0; }
-
-bool MyOctant::ContainsMoreThan(uint a_nEntities)
+void MyOctant::GetAllHits(vector3 const& a_v3Origin, vector3 const& a_v3Direction,
+	std::vector<std::pair<float, uint>>& a_lOutput, float a_fMaxDistance)
 {
-	uint nCount = 0;
-	uint nObjectCount = m_pEntityMngr->GetEntityCount();
+	if (this != m_pRoot) return;
 
-	for (uint i = 0; i < nObjectCount; i++)
-	{
-		//add to nCount for every colliding entity
-		if (IsColliding(i)) nCount++;
-		if (nCount > a_nEntities) return true;
-	}
+	RayQuery query;
+	query.pAllHits = &a_lOutput;
+	if (!m_pTree->bLoose)
+		query.uStamp = NextQueryStamp();
 
-	return false;
+	uint uFirst = a_lOutput.size();
+	CastRay(query, a_v3Origin, a_v3Direction, a_fMaxDistance);
+	std::sort(a_lOutput.begin() + uFirst, a_lOutput.end());
 }
 
-void MyOctant::KillBranches(void)
+bool MyOctant::IsAnyHit(vector3 const& a_v3Origin, vector3 const& a_v3Direction, float a_fMaxDistance)
 {
-	//kill all children down branches until leaves are reached (octant has no children)
-	for (uint i = 0; i < m_uChildren; i++)
-	{
-		m_pChild[i]->KillBranches();
-		delete m_pChild[i];
-		m_pChild[i] = nullptr;
-	}
+	if (this != m_pRoot) return false;
 
-	m_uChildren = 0;
+	RayQuery query;
+	query.bAnyHit = true;
+	CastRay(query, a_v3Origin, a_v3Direction, a_fMaxDistance);
+	return query.bHit;
 }
 
-void MyOctant::DisplayLeafs(vector3 a_v3Color)
+void MyOctant::CastRay(RayQuery& a_Query, vector3 const& a_v3Origin, vector3 const& a_v3Direction, float a_fMaxDistance)
 {
-	uint nLeafs = m_lChild.size();
-
-	for (uint i = 0; i < nLeafs; i++)
+	float fLength = glm::length(a_v3Direction);
+	if (fLength == 0.0f) return;
+
+	a_Query.v3Origin = a_v3Origin;
+	a_Query.v3Direction = a_v3Direction / fLength;
+	a_Query.fMaxDistance = a_fMaxDistance;
+
+	//the boxes that left the root are not where the octants say, they go first so a hit among
+	//them shortens the ray through the tree
+	float fDistance;
+	uint nOutside = m_pTree->lOutside.size();
+	for (uint i = 0; i < nOutside; i++)
 	{
-		m_lChild[i]->DisplayLeafs(a_v3Color);
+		if (!IsRayHitting(a_Query.v3Origin, a_Query.v3Direction, m_pTree->lOutsideMin[i], m_pTree->lOutsideMax[i],
+			a_Query.fMaxDistance, fDistance))
+			continue;
+
+		AddRayHit(a_Query, m_pTree->lOutside[i], fDistance);
+		if (a_Query.bAnyHit) return;
 	}
 
-	m_pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
-		glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
+	vector3 const& v3Min = m_pTree->bLoose ? m_v3BranchMin : m_v3Min;
+	vector3 const& v3Max = m_pTree->bLoose ? m_v3BranchMax : m_v3Max;
+	if (IsRayHitting(a_Query.v3Origin, a_Query.v3Direction, v3Min, v3Max, a_Query.fMaxDistance, fDistance))
+		CastRay(a_Query);
 }
 
-void MyOctant::ClearEntityList(void)
+void MyOctant::AddRayHit(RayQuery& a_Query, uint a_uEntity, float a_fDistance)
 {
-	//clear all entities down every branch
-	for (uint i = 0; i < m_uChildren; i++)
+	if (a_Query.pAllHits != nullptr)
 	{
-		m_pChild[i]->ClearEntityList();
+		if (a_Query.uStamp != 0)
+		{
+			std::vector<uint>& lStamp = m_pRoot->m_pTree->lQueryStamp;
+			if (lStamp[a_uEntity] == a_Query.uStamp) return;
+			lStamp[a_uEntity] = a_Query.uStamp;
+		}
+		a_Query.pAllHits->push_back(std::pair<float, uint>(a_fDistance, a_uEntity));
+		return;
 	}
 
-	m_EntityList.clear();
+	//only boxes entered before this one are looked at from now on, boxes entered at the
+	//same distance go to the smaller index so the order of the octants does not matter
+	if (!a_Query.bHit || a_fDistance < a_Query.fMaxDistance || a_uEntity < a_Query.uEntity)
+	{
+		a_Query.uEntity = a_uEntity;
+		a_Query.fMaxDistance = a_fDistance;
+	}
+	a_Query.bHit = true;
 }
 
-void MyOctant::ConstructTree(uint a_nMaxLevel)
+uint MyOctant::NextQueryStamp(void)
 {
-	//if tree is alreayd created
-	if (m_uLevel != 0) return;
-
-	m_uMaxLevel = a_nMaxLevel;
-	m_uOctantCount = 1;
-
-	//destroy, then rebuild
-	m_EntityList.clear();
-	KillBranches();
-	m_lChild.clear();
-
-	if (ContainsMoreThan(m_uIdealEntityCount)) Subdivide();
+	//Entities added since the last query start with a stamp older than any query
+	if (m_pTree->lQueryStamp.size() < m_pTree->lEntityMin.size())
+		m_pTree->lQueryStamp.resize(m_pTree->lEntityMin.size(), 0);
 
-	AssignIDtoEntity();
-	ConstructList();
+	if (++m_pTree->uQueryStamp == 0)
+	{
+		std::fill(m_pTree->lQueryStamp.begin(), m_pTree->lQueryStamp.end(), 0);
+		m_pTree->uQueryStamp = 1;
+	}
+	return m_pTree->uQueryStamp;
 }
 
-void MyOctant::AssignIDtoEntity(void)
+void MyOctant::CastRay(RayQuery& a_Query)
 {
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	bool bLoose = m_pRoot->m_pTree->bLoose;
+
+	float fDistance;
+	uint nEntities = m_EntityList.size();
+	if (nEntities > 0 && (!bLoose || IsRayHitting(a_Query.v3Origin, a_Query.v3Direction,
+		m_v3EntityMin, m_v3EntityMax, a_Query.fMaxDistance, fDistance)))
+	{
+		for (uint i = 0; i < nEntities; i++)
+		{
+			uint uEntity = m_EntityList[i];
+			if (IsOutside(uEntity)) continue;
+			if (!IsRayHitting(a_Query.v3Origin, a_Query.v3Direction, lMin[uEntity], lMax[uEntity],
+				a_Query.fMaxDistance, fDistance))
+				continue;
+
+			AddRayHit(a_Query, uEntity, fDistance);
+			if (a_Query.bAnyHit) return;
+		}
+	}
+
+	//order the children the ray enters by distance, nearest first
+	MyOctant* pChild[8];
+	float fEntry[8];
+	uint nHit = 0;
 	for (uint i = 0; i < m_uChildren; i++)
 	{
-		m_pChild[i]->AssignIDtoEntity();
+		MyOctant* pOctant = m_pChild[i];
+		vector3 const& v3Min = bLoose ? pOctant->m_v3BranchMin : pOctant->m_v3Min;
+		vector3 const& v3Max = bLoose ? pOctant->m_v3BranchMax : pOctant->m_v3Max;
+		if (!IsRayHitting(a_Query.v3Origin, a_Query.v3Direction, v3Min, v3Max, a_Query.fMaxDistance, fDistance))
+			continue;
+
+		uint j = nHit++;
+		while (j > 0 && fEntry[j - 1] > fDistance)
+		{
+			pChild[j] = pChild[j - 1];
+			fEntry[j] = fEntry[j - 1];
+			j--;
+		}
+		pChild[j] = pOctant;
+		fEntry[j] = fDistance;
 	}
 
-	if (m_uChildren == 0)
+	for (uint i = 0; i < nHit; i++)
 	{
-		uint nEntities = m_pEntityMngr->GetEntityCount();
+		//a nearer hit may have been found in the children before
+		if (fEntry[i] > a_Query.fMaxDistance) break;
 
-		for (int i = 0; i < nEntities; i++)
+		pChild[i]->CastRay(a_Query);
+		if (a_Query.bAnyHit && a_Query.bHit) return;
+	}
+}
+
+bool MyOctant::IsRayHitting(vector3 const& a_v3Origin, vector3 const& a_v3Direction, vector3 const& a_v3Min,
+	vector3 const& a_v3Max, float a_fMaxDistance, float& a_fDistance)
+{
+	float fNear = 0.0f;
+	float fFar = a_fMaxDistance;
+	for (uint k = 0; k < 3; k++)
+	{
+		//parallel to the slab, it has to start between its planes
+		if (a_v3Direction[k] == 0.0f)
 		{
-			if (IsColliding(i))
-			{
-				m_EntityList.push_back(i);
-				m_pEntityMngr->AddDimension(i, m_uID);
-			}
+			if (a_v3Origin[k] < a_v3Min[k] || a_v3Origin[k] > a_v3Max[k]) return false;
+			continue;
 		}
+
+		float fInverse = 1.0f / a_v3Direction[k];
+		float fT1 = (a_v3Min[k] - a_v3Origin[k]) * fInverse;
+		float fT2 = (a_v3Max[k] - a_v3Origin[k]) * fInverse;
+		if (fT1 > fT2) std::swap(fT1, fT2);
+		if (fT1 > fNear) fNear = fT1;
+		if (fT2 < fFar) fFar = fT2;
+		if (fNear > fFar) return false;
 	}
+	a_fDistance = fNear;
+	return true;
 }
 
-void MyOctant::ConstructList(void)
+void MyOctant::GetBranchEntities(std::vector<uint>& a_lOutput)
 {
-	for (uint i = 0; i < m_uChildren; i++)
+	if (m_pRoot->m_pTree->lOutside.empty())
 	{
-		m_pChild[i]->ConstructList();
+		a_lOutput.insert(a_lOutput.end(), m_EntityList.begin(), m_EntityList.end());
 	}
-
-	if (m_EntityList.size() == 0)
+	else
 	{
-		m_pRoot->m_lChild.push_back(this);
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			if (!IsOutside(m_EntityList[i]))
+				a_lOutput.push_back(m_EntityList[i]);
+		}
 	}
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetBranchEntities(a_lOutput);
+	}
+}
+
+int MyOctant::ClassifyBox(vector4 const* a_pPlane, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	int nSide = 1;
+	for (uint i = 0; i < 6; i++)
+	{
+		vector4 const& v4Plane = a_pPlane[i];
+
+		//the corner furthest along the normal of the plane and the one furthest against it
+		vector3 v3Far;
+		vector3 v3Near;
+		for (uint k = 0; k < 3; k++)
+		{
+			v3Far[k] = v4Plane[k] >= 0.0f ? a_v3Max[k] : a_v3Min[k];
+			v3Near[k] = v4Plane[k] >= 0.0f ? a_v3Min[k] : a_v3Max[k];
+		}
+
+		if (glm::dot(vector3(v4Plane), v3Far) + v4Plane.w < 0.0f)
+			return -1;
+		if (glm::dot(vector3(v4Plane), v3Near) + v4Plane.w < 0.0f)
+			nSide = 0;
+	}
+	return nSide;
+}
+
+bool MyOctant::IsOwner(vector3 const& a_v3Point)
+{
+	//leafs hold their minimum faces, the root holds all of its faces and what is past them (the
+	//root is sized around the boxes with a rounding error, some poke out of it)
+	vector3 const& v3RootMin = m_pRoot->m_v3Min;
+	vector3 const& v3RootMax = m_pRoot->m_v3Max;
+	for (uint k = 0; k < 3; k++)
+	{
+		if (a_v3Point[k] < m_v3Min[k] && m_v3Min[k] != v3RootMin[k])
+			return false;
+		if (a_v3Point[k] >= m_v3Max[k] && m_v3Max[k] != v3RootMax[k])
+			return false;
+	}
+	return true;
+}
+
+void MyOctant::GetInBox(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput)
+{
+	if (this != m_pRoot) return;
+	GetInBoxBranch(a_v3Min, a_v3Max, a_lOutput);
+
+	//the octants do not hold the boxes that left the root, test those whole
+	uint nOutside = m_pTree->lOutside.size();
+	for (uint i = 0; i < nOutside; i++)
+	{
+		if (IsOverlapping(m_pTree->lOutsideMin[i], m_pTree->lOutsideMax[i], a_v3Min, a_v3Max))
+			a_lOutput.push_back(m_pTree->lOutside[i]);
+	}
+}
+
+void MyOctant::GetInBoxBranch(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput)
+{
+	bool bLoose = m_pRoot->m_pTree->bLoose;
+	if (bLoose ? !IsOverlapping(m_v3BranchMin, m_v3BranchMax, a_v3Min, a_v3Max) : !IsColliding(a_v3Min, a_v3Max))
+		return;
+
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	uint nEntities = m_EntityList.size();
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint uEntity = m_EntityList[i];
+		if (IsOutside(uEntity)) continue;
+		if (!IsOverlapping(lMin[uEntity], lMax[uEntity], a_v3Min, a_v3Max)) continue;
+
+		//an entity of a regular octree is reported by the leaf holding the minimum corner of the overlap
+		if (!bLoose && !IsOwner(glm::max(lMin[uEntity], a_v3Min))) continue;
+		a_lOutput.push_back(uEntity);
+	}
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetInBoxBranch(a_v3Min, a_v3Max, a_lOutput);
+	}
+}
+
+void MyOctant::GetInSphere(vector3 const& a_v3Center, float a_fRadius, std::vector<uint>& a_lOutput)
+{
+	if (this != m_pRoot) return;
+
+	float fRadiusSquared = a_fRadius * a_fRadius;
+	GetInSphereBranch(a_v3Center, fRadiusSquared, a_lOutput);
+
+	//the octants do not hold the boxes that left the root, test those whole
+	uint nOutside = m_pTree->lOutside.size();
+	for (uint i = 0; i < nOutside; i++)
+	{
+		if (GetDistanceSquared(a_v3Center, m_pTree->lOutsideMin[i], m_pTree->lOutsideMax[i]) <= fRadiusSquared)
+			a_lOutput.push_back(m_pTree->lOutside[i]);
+	}
+}
+
+void MyOctant::GetInSphere(std::vector<vector3> const& a_lCenter, float a_fRadius, std::vector<uint>& a_lOutput,
+	std::vector<uint>& a_lFirst)
+{
+	a_lOutput.clear();
+	a_lFirst.clear();
+	if (this != m_pRoot) return;
+
+	uint nCenters = a_lCenter.size();
+	for (uint i = 0; i < nCenters; i++)
+	{
+		a_lFirst.push_back(a_lOutput.size());
+		GetInSphere(a_lCenter[i], a_fRadius, a_lOutput);
+	}
+	a_lFirst.push_back(a_lOutput.size());
+}
+
+void MyOctant::GetInSphereBranch(vector3 const& a_v3Center, float a_fRadiusSquared, std::vector<uint>& a_lOutput)
+{
+	bool bLoose = m_pRoot->m_pTree->bLoose;
+	float fOctant = bLoose ? GetDistanceSquared(a_v3Center, m_v3BranchMin, m_v3BranchMax)
+		: GetDistanceSquared(a_v3Center, m_v3Min, m_v3Max);
+	if (fOctant > a_fRadiusSquared) return;
+
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	uint nEntities = m_EntityList.size();
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint uEntity = m_EntityList[i];
+		if (IsOutside(uEntity)) continue;
+		if (GetDistanceSquared(a_v3Center, lMin[uEntity], lMax[uEntity]) > a_fRadiusSquared) continue;
+
+		//an entity of a regular octree is reported by the leaf holding its point nearest to the center
+		if (!bLoose && !IsOwner(glm::clamp(a_v3Center, lMin[uEntity], lMax[uEntity]))) continue;
+		a_lOutput.push_back(uEntity);
+	}
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->GetInSphereBranch(a_v3Center, a_fRadiusSquared, a_lOutput);
+	}
+}
+
+void MyOctant::GetNearest(vector3 const& a_v3Point, uint a_uCount, std::vector<std::pair<float, uint>>& a_lOutput)
+{
+	if (this != m_pRoot || a_uCount == 0) return;
+
+	//the ones found are kept in a heap with the farthest on top, then sorted; the boxes that left
+	//the root go first, the octants do not hold them
+	uint uFirst = a_lOutput.size();
+	uint nOutside = m_pTree->lOutside.size();
+	for (uint i = 0; i < nOutside; i++)
+	{
+		float fDistance = GetDistanceSquared(a_v3Point, m_pTree->lOutsideMin[i], m_pTree->lOutsideMax[i]);
+		PushNearest(std::pair<float, uint>(fDistance, m_pTree->lOutside[i]), a_uCount, a_lOutput, uFirst);
+	}
+	GetNearestBranch(a_v3Point, a_uCount, a_lOutput, uFirst);
+	std::sort_heap(a_lOutput.begin() + uFirst, a_lOutput.end());
+	for (uint i = uFirst; i < a_lOutput.size(); i++)
+	{
+		a_lOutput[i].first = std::sqrt(a_lOutput[i].first);
+	}
+}
+
+void MyOctant::GetNearest(std::vector<vector3> const& a_lPoint, uint a_uCount,
+	std::vector<std::pair<float, uint>>& a_lOutput, std::vector<uint>& a_lFirst)
+{
+	a_lOutput.clear();
+	a_lFirst.clear();
+	if (this != m_pRoot) return;
+
+	uint nPoints = a_lPoint.size();
+	for (uint i = 0; i < nPoints; i++)
+	{
+		a_lFirst.push_back(a_lOutput.size());
+		GetNearest(a_lPoint[i], a_uCount, a_lOutput);
+	}
+	a_lFirst.push_back(a_lOutput.size());
+}
+
+void MyOctant::GetNearestBranch(vector3 const& a_v3Point, uint a_uCount, std::vector<std::pair<float, uint>>& a_lOutput,
+	uint a_uFirst)
+{
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	bool bLoose = m_pRoot->m_pTree->bLoose;
+
+	uint nEntities = m_EntityList.size();
+	for (uint i = 0; i < nEntities; i++)
+	{
+		uint uEntity = m_EntityList[i];
+		if (IsOutside(uEntity)) continue;
+		std::pair<float, uint> candidate(GetDistanceSquared(a_v3Point, lMin[uEntity], lMax[uEntity]), uEntity);
+
+		//the farthest found so far is on top of the heap, ties are broken by the index
+		bool bFull = a_lOutput.size() - a_uFirst >= a_uCount;
+		if (bFull && !(candidate < a_lOutput[a_uFirst])) continue;
+
+		//an entity of a regular octree is added by the leaf holding its point nearest to the point
+		if (!bLoose && !IsOwner(glm::clamp(a_v3Point, lMin[uEntity], lMax[uEntity]))) continue;
+
+		PushNearest(candidate, a_uCount, a_lOutput, a_uFirst);
+	}
+
+	//visit the children from the nearest
+	MyOctant* pChild[8];
+	float fDistance[8];
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		MyOctant* pOctant = m_pChild[i];
+		float fOctant = bLoose ? GetDistanceSquared(a_v3Point, pOctant->m_v3BranchMin, pOctant->m_v3BranchMax)
+			: GetDistanceSquared(a_v3Point, pOctant->m_v3Min, pOctant->m_v3Max);
+
+		uint j = i;
+		while (j > 0 && fDistance[j - 1] > fOctant)
+		{
+			pChild[j] = pChild[j - 1];
+			fDistance[j] = fDistance[j - 1];
+			j--;
+		}
+		pChild[j] = pOctant;
+		fDistance[j] = fOctant;
+	}
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		//the rest are farther than the farthest found
+		if (a_lOutput.size() - a_uFirst >= a_uCount && fDistance[i] > a_lOutput[a_uFirst].first) break;
+		pChild[i]->GetNearestBranch(a_v3Point, a_uCount, a_lOutput, a_uFirst);
+	}
+}
+
+void MyOctant::PushNearest(std::pair<float, uint> const& a_Candidate, uint a_uCount,
+	std::vector<std::pair<float, uint>>& a_lOutput, uint a_uFirst)
+{
+	//once full the candidate takes the place of the farthest if it is nearer
+	if (a_lOutput.size() - a_uFirst >= a_uCount)
+	{
+		if (!(a_Candidate < a_lOutput[a_uFirst])) return;
+		std::pop_heap(a_lOutput.begin() + a_uFirst, a_lOutput.end());
+		a_lOutput.back() = a_Candidate;
+	}
+	else
+	{
+		a_lOutput.push_back(a_Candidate);
+	}
+	std::push_heap(a_lOutput.begin() + a_uFirst, a_lOutput.end());
+}
+
+float MyOctant::GetDistanceSquared(vector3 const& a_v3Point, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	float fDistance = 0.0f;
+	for (uint k = 0; k < 3; k++)
+	{
+		float fOut = 0.0f;
+		if (a_v3Point[k] < a_v3Min[k])
+			fOut = a_v3Min[k] - a_v3Point[k];
+		else if (a_v3Point[k] > a_v3Max[k])
+			fOut = a_v3Point[k] - a_v3Max[k];
+		fDistance += fOut * fOut;
+	}
+	return fDistance;
+}
+
+bool MyOctant::IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+	vector3 const& a_v3MinB, vector3 const& a_v3MaxB)
+{
+	if (a_v3MaxA.x < a_v3MinB.x || a_v3MinA.x > a_v3MaxB.x) return false;
+	if (a_v3MaxA.y < a_v3MinB.y || a_v3MinA.y > a_v3MaxB.y) return false;
+	if (a_v3MaxA.z < a_v3MinB.z || a_v3MinA.z > a_v3MaxB.z) return false;
+	return true;
+}
+
+void MyOctant::ExpandEntityBounds(uint a_uIndex)
+{
+	m_v3EntityMin = glm::min(m_v3EntityMin, m_pRoot->m_pTree->lEntityMin[a_uIndex]);
+	m_v3EntityMax = glm::max(m_v3EntityMax, m_pRoot->m_pTree->lEntityMax[a_uIndex]);
+	ExpandBranchBounds(a_uIndex);
+}
+
+void MyOctant::ExpandBranchBounds(uint a_uIndex)
+{
+	m_v3BranchMin = glm::min(m_v3BranchMin, m_pRoot->m_pTree->lEntityMin[a_uIndex]);
+	m_v3BranchMax = glm::max(m_v3BranchMax, m_pRoot->m_pTree->lEntityMax[a_uIndex]);
+}
+
+void MyOctant::RefitLooseBounds(bool a_bEntities)
+{
+	if (a_bEntities)
+	{
+		std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+		std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+		m_v3EntityMin = vector3(FLT_MAX);
+		m_v3EntityMax = vector3(-FLT_MAX);
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			m_v3EntityMin = glm::min(m_v3EntityMin, lMin[m_EntityList[i]]);
+			m_v3EntityMax = glm::max(m_v3EntityMax, lMax[m_EntityList[i]]);
+		}
+	}
+
+	m_v3BranchMin = m_v3EntityMin;
+	m_v3BranchMax = m_v3EntityMax;
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_v3BranchMin = glm::min(m_v3BranchMin, m_pChild[i]->m_v3BranchMin);
+		m_v3BranchMax = glm::max(m_v3BranchMax, m_pChild[i]->m_v3BranchMax);
+	}
+}
+
+void MyOctant::AssignLooseIDtoEntity(uint a_uIndex)
+{
+	//any entity that can touch this one lives in an octant whose stored entities it overlaps,
+	//whichever of the two moved last has the octant of the other
+	m_pTree->pEntityMngr->ClearDimensionSet(a_uIndex);
+
+	std::vector<uint> lDimension;
+	GetDimensions(m_pTree->lEntityMin[a_uIndex], m_pTree->lEntityMax[a_uIndex], lDimension);
+	uint nDimensions = lDimension.size();
+	for (uint i = 0; i < nDimensions; i++)
+	{
+		m_pTree->pEntityMngr->AddDimension(a_uIndex, lDimension[i]);
+	}
+}
+
+//create octant with predetermined max level and ideal entity count
+MyOctant::MyOctant(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness, bool a_bSliced)
+{
+	Init();
+	m_pTree = new TreeState();
+
+	//a sliced tree takes the boxes a slice at a time and is linked like a tree built from boxes
+	if (a_bSliced)
+	{
+		m_pTree->bLinkEntities = false;
+		m_pTree->bOwnDimensions = false;
+		InitRoot(a_nMaxLevel, a_nIdealEntityCount, a_fLooseness, true);
+		m_pTree->lEntityMin.reserve(m_pTree->pEntityMngr->GetEntityCount());
+		m_pTree->lEntityMax.reserve(m_pTree->pEntityMngr->GetEntityCount());
+		m_pTree->eBuildPhase = BUILD_SNAPSHOT;
+		return;
+	}
+
+	TakeSnapshot();
+
+	m_pTree->bLinkEntities = true;
+	m_pTree->bOwnDimensions = true;
+	InitRoot(a_nMaxLevel, a_nIdealEntityCount, a_fLooseness);
+
+	//the snapshot is up to date, earlier moves do not need to be applied
+	m_pTree->pEntityMngr->ClearMovedList();
+}
+
+void MyOctant::TakeSnapshot(void)
+{
+	//take a snapshot of the bounding boxes of all entities so the build does not
+	//need to go through the entity manager for every octant
+	uint nObjects = m_pTree->pEntityMngr->GetEntityCount();
+	m_pTree->lEntityMin.resize(nObjects);
+	m_pTree->lEntityMax.resize(nObjects);
+	for (uint i = 0; i < nObjects; i++)
+	{
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(i)->GetRigidBody();
+		m_pTree->lEntityMin[i] = pRigidBody->GetMinGlobal();
+		m_pTree->lEntityMax[i] = pRigidBody->GetMaxGlobal();
+	}
+}
+
+void MyOctant::Rebuild(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness)
+{
+	if (this != m_pRoot) return;
+
+	if (m_pTree->bLinkEntities)
+		TakeSnapshot();
+
+	//a tree that gave its dimensions up takes them back, the build assigns them all again
+	m_pTree->bOwnDimensions = m_pTree->bLinkEntities;
+	InitRoot(a_nMaxLevel, a_nIdealEntityCount, a_fLooseness);
+
+	if (m_pTree->bLinkEntities)
+		m_pTree->pEntityMngr->ClearMovedList();
+}
+
+//create octant around the provided bounding boxes
+MyOctant::MyOctant(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness, bool a_bSliced, uint a_uThreadCount, uint a_uCutoff)
+{
+	Init();
+	m_pTree = new TreeState();
+	m_pTree->uBuildThreadCount = a_uThreadCount;
+	m_pTree->uParallelCutoff = std::max(a_uCutoff, 1u);
+
+	m_pTree->lEntityMin = a_lMin;
+	m_pTree->lEntityMax = a_lMax;
+
+	m_pTree->bLinkEntities = false;
+	m_pTree->bOwnDimensions = false;
+	InitRoot(a_nMaxLevel, a_nIdealEntityCount, a_fLooseness, a_bSliced);
+}
+
+void MyOctant::InitRoot(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness, bool a_bSliced)
+{
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+
+	m_pTree->uOctantCount = 0;
+	m_pTree->uMaxLevel = a_nMaxLevel;
+	m_pTree->uIdealEntityCount = a_nIdealEntityCount;
+	m_uID = m_pTree->uOctantCount;
+
+	//loose bounds smaller than the octant would leave entities without an octant
+	m_pTree->bLoose = a_fLooseness > 0.0f;
+	m_pTree->fLooseness = m_pTree->bLoose ? std::max(a_fLooseness, 1.0f) : 1.0f;
+
+	m_pRoot = this;
+	m_pTree->lChild.clear();
+
+	//the root is sized around every box, none is outside of it
+	m_pTree->lOutside.clear();
+	m_pTree->lOutsideMin.clear();
+	m_pTree->lOutsideMax.clear();
+	m_pTree->lOutsideSlot.clear();
+
+	m_pTree->uOctantCount++; //increment octant count
+
+	//ContinueBuild fits the root around the boxes and splits the octants a slice at a time
+	if (a_bSliced)
+	{
+		m_pTree->v3SliceMin = vector3(FLT_MAX);
+		m_pTree->v3SliceMax = vector3(-FLT_MAX);
+		m_pTree->uSliceCursor = 0;
+		m_pTree->eBuildPhase = BUILD_BOUNDS;
+		std::chrono::duration<double, std::milli> tElapsed = std::chrono::high_resolution_clock::now() - tStart;
+		m_pTree->dBuildMs = tElapsed.count();
+		return;
+	}
+
+	//find min and max values among all entities to create octant size
+	uint nObjects = m_pTree->lEntityMin.size();
+	vector3 v3Min = vector3(0.0f);
+	vector3 v3Max = vector3(0.0f);
+	if (nObjects > 0)
+	{
+		v3Min = m_pTree->lEntityMin[0];
+		v3Max = m_pTree->lEntityMax[0];
+	}
+	for (uint i = 1; i < nObjects; i++)
+	{
+		v3Min = glm::min(v3Min, m_pTree->lEntityMin[i]);
+		v3Max = glm::max(v3Max, m_pTree->lEntityMax[i]);
+	}
+	SetRootVolume(v3Min, v3Max);
+
+	ConstructTree(m_pTree->uMaxLevel); //construct tree from with set max level
+	std::chrono::duration<double, std::milli> tElapsed = std::chrono::high_resolution_clock::now() - tStart;
+	m_pTree->dBuildMs = tElapsed.count();
+}
+
+void MyOctant::SetRootVolume(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//find halfwidth of octant
+	vector3 vHalfWidth = (a_v3Max - a_v3Min) / 2.0f;
+	float fMax = vHalfWidth.x;
+	for (int i = 0; i < 3; i++)
+	{
+		if (fMax < vHalfWidth[i]) fMax = vHalfWidth[i];
+	}
+
+	//set dimensions of octant (size, center, min, and max)
+	m_fSize = fMax * 2.0f;
+	m_v3Center = (a_v3Max + a_v3Min) / 2.0f;
+	m_v3Min = m_v3Center - (vector3(fMax)); //center - halfwidth
+	m_v3Max = m_v3Center + (vector3(fMax)); //center + halfwidth
+}
+
+
+//create octant with predetermined center and size
+MyOctant::MyOctant(vector3 a_v3Center, float a_fSize)
+{
+	Init();
+	m_v3Center = a_v3Center;
+	m_fSize = a_fSize;
+	m_v3Min = m_v3Center - (vector3(m_fSize) / 2.0f);
+	m_v3Max = m_v3Center + (vector3(m_fSize) / 2.0f);
+	m_pRoot = this;
+	m_pTree = new TreeState();
+	m_pTree->uOctantCount = 1;
+}
+
+//create an empty octant for the node pool of the root specified
+MyOctant::MyOctant(MyOctant* a_pRoot)
+{
+	Init();
+	m_pRoot = a_pRoot;
+}
+
+void MyOctant::Reset(vector3 a_v3Center, float a_fSize)
+{
+	Init();
+	m_v3Center = a_v3Center;
+	m_fSize = a_fSize;
+	m_v3Min = m_v3Center - (vector3(m_fSize) / 2.0f);
+	m_v3Max = m_v3Center + (vector3(m_fSize) / 2.0f);
+	m_EntityList.clear();
+
+	//a parallel build numbers the octants once it is done
+	if (!m_pRoot->m_pTree->bParallelBuild)
+		m_uID = m_pRoot->m_pTree->uOctantCount++;
+}
+
+MyOctant::MyOctant(MyOctant const& other)
+{
+	m_uChildren = other.m_uChildren;
+	m_v3Center = other.m_v3Center;
+	m_v3Min = other.m_v3Min;
+	m_v3Max = other.m_v3Max;
+	m_v3EntityMin = other.m_v3EntityMin;
+	m_v3EntityMax = other.m_v3EntityMax;
+	m_v3BranchMin = other.m_v3BranchMin;
+	m_v3BranchMax = other.m_v3BranchMax;
+	m_fSize = other.m_fSize;
+	m_uID = other.m_uID;
+	m_uLevel = other.m_uLevel;
+	m_pParent = other.m_pParent;
+	m_pRoot = other.m_pRoot;
+	m_EntityList = other.m_EntityList;
+
+	//a copy of a root gets its own state, the node pool stays with the original
+	if (other.m_pTree != nullptr)
+	{
+		m_pTree = new TreeState();
+		m_pTree->uOctantCount = other.m_pTree->uOctantCount;
+		m_pTree->uMaxLevel = other.m_pTree->uMaxLevel;
+		m_pTree->uIdealEntityCount = other.m_pTree->uIdealEntityCount;
+		m_pTree->lChild = other.m_pTree->lChild;
+		m_pTree->lEntityMin = other.m_pTree->lEntityMin;
+		m_pTree->lEntityMax = other.m_pTree->lEntityMax;
+		m_pTree->lOutside = other.m_pTree->lOutside;
+		m_pTree->lOutsideMin = other.m_pTree->lOutsideMin;
+		m_pTree->lOutsideMax = other.m_pTree->lOutsideMax;
+		m_pTree->lOutsideSlot = other.m_pTree->lOutsideSlot;
+		m_pTree->lDimension = other.m_pTree->lDimension;
+		m_pTree->lDimensionFirst = other.m_pTree->lDimensionFirst;
+		m_pTree->bLinkEntities = other.m_pTree->bLinkEntities;
+		m_pTree->bOwnDimensions = other.m_pTree->bOwnDimensions;
+		m_pTree->bListDirty = other.m_pTree->bListDirty;
+		m_pTree->bLoose = other.m_pTree->bLoose;
+		m_pTree->fLooseness = other.m_pTree->fLooseness;
+		m_pTree->uBuildThreadCount = other.m_pTree->uBuildThreadCount;
+		m_pTree->uParallelCutoff = other.m_pTree->uParallelCutoff;
+		m_pTree->dBuildMs = other.m_pTree->dBuildMs;
+	}
+
+	for (uint i = 0; i < 8; i++)
+	{
+		m_pChild[i] = other.m_pChild[i];
+	}
+}
+
+MyOctant& MyOctant::operator=(MyOctant const& other)
+{
+	if (this != &other)
+	{
+		Release();
+		Init();
+		MyOctant temp(other);
+		Swap(temp);
+	}
+	return *this;
+}
+
+MyOctant::~MyOctant() { Release(); }
+
+float MyOctant::GetSize(void) { return m_fSize; }
+
+vector3 MyOctant::GetCenterGlobal(void) { return m_v3Center; }
+
+vector3 MyOctant::GetMinGlobal(void) { return m_v3Min; }
+
+vector3 MyOctant::GetMaxGlobal(void) { return m_v3Max; }
+
+void MyOctant::Display(uint a_nIndex, vector3 a_v3Color)
+{
+	//display octant with specific index: 'a_nIndex'
+	if (m_uID == a_nIndex)
+	{
+		m_pRoot->m_pTree->pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
+			glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
+		return;
+	}
+
+	//display all children of octant
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->Display(a_nIndex);
+	}
+}
+
+void MyOctant::Display(vector3 a_v3Color)
+{
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->Display(a_v3Color);
+	}
+	m_pRoot->m_pTree->pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
+		glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
+}
+
+void MyOctant::Subdivide(void)
+{
+	//if already at max level
+	if (m_uLevel >= m_pRoot->m_pTree->uMaxLevel) return;
+
+	//if octant has children already
+	if (m_uChildren != 0) return;
+
+	CreateChildren();
+
+	uint nEntities = m_EntityList.size();
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		uint nStay = 0;
+		HandDownLoose(0, nEntities, nStay);
+	}
+	else
+	{
+		//the entities of this octant are handed down to the children that overlap them
+		for (uint i = 0; i < 8; i++)
+		{
+			FillChild(i, 0, nEntities);
+		}
+
+		//only leafs keep entities, the memory of the list stays for the next build
+		m_EntityList.clear();
+	}
+
+	//subdivide the children if necessary (contains too many entities)
+	for (uint i = 0; i < 8; i++)
+	{
+		if (m_pChild[i]->ContainsMoreThan(m_pRoot->m_pTree->uIdealEntityCount))
+		{
+			m_pChild[i]->Subdivide();
+		}
+	}
+}
+
+void MyOctant::SubdivideParallel(MyTaskPool& a_Pool)
+{
+	if (m_uLevel >= m_pRoot->m_pTree->uMaxLevel) return;
+	if (m_uChildren != 0) return;
+
+	//small branches are not worth a task, the thread that got here builds them
+	if (m_EntityList.size() < m_pRoot->m_pTree->uParallelCutoff)
+	{
+		Subdivide();
+		return;
+	}
+
+	CreateChildren();
+
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		//a single pass hands the entities down, then each child is a task
+		uint nStay = 0;
+		HandDownLoose(0, m_EntityList.size(), nStay);
+		for (uint i = 0; i < 8; i++)
+		{
+			MyOctant* pChild = m_pChild[i];
+			if (pChild->ContainsMoreThan(m_pRoot->m_pTree->uIdealEntityCount))
+				a_Pool.Push([pChild, &a_Pool] { pChild->SubdivideParallel(a_Pool); });
+		}
+		return;
+	}
+
+	//each child takes its entities from the list of this octant on its own, the list is only
+	//read until the build is done so it is cleared afterwards (NumberBranches)
+	for (uint i = 0; i < 8; i++)
+	{
+		a_Pool.Push([this, i, &a_Pool]
+		{
+			FillChild(i, 0, m_EntityList.size());
+			if (m_pChild[i]->ContainsMoreThan(m_pRoot->m_pTree->uIdealEntityCount))
+				m_pChild[i]->SubdivideParallel(a_Pool);
+		});
+	}
+}
+
+void MyOctant::CreateChildren(void)
+{
+	m_uChildren = 8;
+	float fSize = m_fSize / 4.0f;
+	float fSizeD = fSize * 2.0f;
+	vector3 v3Center;
+
+	//siblings are taken from the pool of the root as one contiguous block
+	MyOctant* pBlock = m_pRoot->AcquireBlock();
+	for (uint i = 0; i < 8; i++)
+	{
+		m_pChild[i] = pBlock + i;
+	}
+
+	//set positions and create children octants
+	v3Center = m_v3Center;
+	v3Center.x -= fSize;
+	v3Center.y -= fSize;
+	v3Center.z -= fSize;
+	m_pChild[0]->Reset(v3Center, fSizeD);
+
+	v3Center.x += fSizeD;
+	m_pChild[1]->Reset(v3Center, fSizeD);
+
+	v3Center.z += fSizeD;
+	m_pChild[2]->Reset(v3Center, fSizeD);
+
+	v3Center.x -= fSizeD;
+	m_pChild[3]->Reset(v3Center, fSizeD);
+
+	v3Center.y += fSizeD;
+	m_pChild[4]->Reset(v3Center, fSizeD);
+
+	v3Center.z -= fSizeD;
+	m_pChild[5]->Reset(v3Center, fSizeD);
+
+	v3Center.x += fSizeD;
+	m_pChild[6]->Reset(v3Center, fSizeD);
+
+	v3Center.z += fSizeD;
+	m_pChild[7]->Reset(v3Center, fSizeD);
+
+	for (uint i = 0; i < 8; i++)
+	{
+		//set childrens' root, parent and level
+		m_pChild[i]->m_pRoot = m_pRoot;
+		m_pChild[i]->m_pParent = this;
+		m_pChild[i]->m_uLevel = m_uLevel + 1; //set to one more level than current
+
+		//take the corners from this octant so children share borders exactly and stay
+		//inside of it, an entity touching a border cannot fall between octants
+		for (uint k = 0; k < 3; k++)
+		{
+			if (m_pChild[i]->m_v3Center[k] < m_v3Center[k])
+			{
+				m_pChild[i]->m_v3Min[k] = m_v3Min[k];
+				m_pChild[i]->m_v3Max[k] = m_v3Center[k];
+			}
+			else
+			{
+				m_pChild[i]->m_v3Min[k] = m_v3Center[k];
+				m_pChild[i]->m_v3Max[k] = m_v3Max[k];
+			}
+		}
+	}
+}
+
+void MyOctant::FillChild(uint a_nChild, uint a_uFirst, uint a_uEnd)
+{
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+	MyOctant* pChild = m_pChild[a_nChild];
+
+	for (uint j = a_uFirst; j < a_uEnd; j++)
+	{
+		uint uEntity = m_EntityList[j];
+		if (pChild->IsColliding(lMin[uEntity], lMax[uEntity]))
+			pChild->m_EntityList.push_back(uEntity);
+	}
+}
+
+void MyOctant::HandDownLoose(uint a_uFirst, uint a_uEnd, uint& a_uStay)
+{
+	std::vector<vector3> const& lMin = m_pRoot->m_pTree->lEntityMin;
+	std::vector<vector3> const& lMax = m_pRoot->m_pTree->lEntityMax;
+
+	//each entity goes down to the child that can hold it, the rest stay in this octant
+	if (a_uFirst == 0)
+	{
+		m_v3EntityMin = vector3(FLT_MAX);
+		m_v3EntityMax = vector3(-FLT_MAX);
+	}
+	for (uint j = a_uFirst; j < a_uEnd; j++)
+	{
+		uint uEntity = m_EntityList[j];
+		MyOctant* pChild = GetLooseChild(lMin[uEntity], lMax[uEntity]);
+		if (pChild != nullptr)
+		{
+			pChild->m_EntityList.push_back(uEntity);
+			pChild->ExpandEntityBounds(uEntity);
+		}
+		else
+		{
+			m_EntityList[a_uStay++] = uEntity;
+			ExpandEntityBounds(uEntity);
+		}
+	}
+	if (a_uEnd == m_EntityList.size())
+		m_EntityList.resize(a_uStay);
+}
+
+void MyOctant::NumberBranches(void)
+{
+	//same order as a serial build: the 8 children when they are created, then the branch of each
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->m_uID = m_pRoot->m_pTree->uOctantCount++;
+	}
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->NumberBranches();
+	}
+
+	//the children of a regular octree were reading this list while the tree was built
+	if (m_uChildren != 0 && !m_pRoot->m_pTree->bLoose)
+		m_EntityList.clear();
+}
+
+MyOctant* MyOctant::GetLooseChild(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	if (m_uChildren == 0) return nullptr;
+
+	vector3 v3Center = (a_v3Min + a_v3Max) / 2.0f;
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		MyOctant* pChild = m_pChild[i];
+		bool bHoldsCenter = true;
+		for (uint k = 0; k < 3; k++)
+		{
+			if (v3Center[k] < pChild->m_v3Min[k] || v3Center[k] > pChild->m_v3Max[k])
+				bHoldsCenter = false;
+		}
+		if (!bHoldsCenter) continue;
+
+		//the first child holding the center is the only option, the box must fit its loose bounds
+		float fHalf = pChild->m_fSize * m_pRoot->m_pTree->fLooseness / 2.0f;
+		for (uint k = 0; k < 3; k++)
+		{
+			if (a_v3Min[k] < pChild->m_v3Center[k] - fHalf || a_v3Max[k] > pChild->m_v3Center[k] + fHalf)
+				return nullptr;
+		}
+		return pChild;
+	}
+	return nullptr;
+}
+
+
+MyOctant* MyOctant::GetChild(uint a_nChild)
+{
+	//if invalid index
+	if (a_nChild > 7) return nullptr;
+	return m_pChild[a_nChild];
+}
+
+bool MyOctant::IsColliding(uint a_uRBIndex)
+{
+	uint nObjectCount = m_pRoot->m_pTree->pEntityMngr->GetEntityCount();
+	//if invalid entity index
+	if (a_uRBIndex >= nObjectCount) return false;
+
+	//get position of entity at index: 'a_uRBIndex'
+	MyEntity* pEntity = m_pRoot->m_pTree->pEntityMngr->GetEntity(a_uRBIndex);
+	MyRigidBody* pRigidBody = pEntity->GetRigidBody();
+	vector3 v3MinO = pRigidBody->GetMinGlobal();
+	vector3 v3MaxO = pRigidBody->GetMaxGlobal();
+
+	//check if colliding (by seeing if entity is outside bounds of octant)
+	if (m_v3Max.x < v3MinO.x) return false;
+	if (m_v3Min.x > v3MaxO.x) return false;
+
+	if (m_v3Max.y < v3MinO.y) return false;
+	if (m_v3Min.y > v3MaxO.y) return false;
+
+	if (m_v3Max.z < v3MinO.z) return false;
+	if (m_v3Min.z > v3MaxO.z) return false;
+
+	return true;
+}
+
+bool MyOctant::IsColliding(vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	//check if colliding (by seeing if the box is outside bounds of octant)
+	if (m_v3Max.x < a_v3Min.x) return false;
+	if (m_v3Min.x > a_v3Max.x) return false;
+
+	if (m_v3Max.y < a_v3Min.y) return false;
+	if (m_v3Min.y > a_v3Max.y) return false;
+
+	if (m_v3Max.z < a_v3Min.z) return false;
+	if (m_v3Min.z > a_v3Max.z) return false;
+
+	return true;
+}
+
+bool MyOctant::IsLeaf(void) { return m_uChildren == 0; }
+
+bool MyOctant::ContainsMoreThan(uint a_nEntities)
+{
+	//the list only holds the entities handed down by the parent that overlap this octant
+	return m_EntityList.size() > a_nEntities;
+}
+
+void MyOctant::KillBranches(void)
+{
+	if (this == m_pRoot)
+	{
+		//every octant comes from the pool of the root, give all of them back at once
+		m_pTree->lPoolFree.clear();
+		m_pTree->uPoolBlockUsed = 0;
+	}
+	else if (m_uChildren != 0)
+	{
+		//kill all children down branches until leaves are reached (octant has no children)
+		for (uint i = 0; i < m_uChildren; i++)
+		{
+			m_pChild[i]->KillBranches();
+		}
+		m_pRoot->m_pTree->lPoolFree.push_back(m_pChild[0]);
+	}
+
+	for (uint i = 0; i < 8; i++)
+	{
+		m_pChild[i] = nullptr;
+	}
+	m_uChildren = 0;
+}
+
+void MyOctant::DisplayLeafs(vector3 a_v3Color)
+{
+	//updates only flag the list, it gets reconstructed when it is needed
+	if (this == m_pRoot && m_pTree->bListDirty)
+	{
+		m_pTree->lChild.clear();
+		ConstructList();
+		m_pTree->bListDirty = false;
+	}
+
+	//the root goes through the list of the tree, the octants in it only draw themselves
+	if (this == m_pRoot)
+	{
+		uint nLeafs = m_pTree->lChild.size();
+
+		for (uint i = 0; i < nLeafs; i++)
+		{
+			if (m_pTree->lChild[i] != this)
+				m_pTree->lChild[i]->DisplayLeafs(a_v3Color);
+		}
+	}
+
+	m_pRoot->m_pTree->pMeshMngr->AddWireCubeToRenderList(glm::translate(IDENTITY_M4, m_v3Center) *
+		glm::scale(vector3(m_fSize)), a_v3Color, RENDER_WIRE);
+}
+
+void MyOctant::ClearEntityList(void)
+{
+	//clear all entities down every branch
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->ClearEntityList();
+	}
+
+	m_EntityList.clear();
+}
+
+void MyOctant::ConstructTree(uint a_nMaxLevel)
+{
+	//if tree is alreayd created
+	if (m_uLevel != 0) return;
+
+	m_pTree->uMaxLevel = a_nMaxLevel;
+	ResetTree();
+
+	uint nEntities = m_pTree->lEntityMin.size();
+	if (ContainsMoreThan(m_pTree->uIdealEntityCount))
+	{
+		//a thread count of 0 uses every core, 1 keeps the build serial
+		if (m_pTree->uBuildThreadCount != 1 && nEntities >= m_pTree->uParallelCutoff)
+		{
+			m_pTree->bParallelBuild = true;
+			{
+				MyTaskPool pool(m_pTree->uBuildThreadCount);
+				SubdivideParallel(pool);
+				pool.Wait();
+			}
+			m_pTree->bParallelBuild = false;
+
+			//the IDs do not depend on which thread got to an octant first
+			NumberBranches();
+		}
+		else
+		{
+			Subdivide();
+		}
+	}
+
+	AssignIDtoEntity();
+	ConstructList();
+	m_pTree->bListDirty = false;
+}
+
+void MyOctant::ResetTree(void)
+{
+	m_pTree->uOctantCount = 1;
+	m_pTree->eBuildPhase = BUILD_DONE;
+
+	//destroy, then rebuild
+	KillBranches();
+	m_pTree->lChild.clear();
+
+	//the root starts with every entity, each level only looks at what its parent passed down
+	uint nEntities = m_pTree->lEntityMin.size();
+	m_EntityList.resize(nEntities);
+	m_v3EntityMin = vector3(FLT_MAX);
+	m_v3EntityMax = vector3(-FLT_MAX);
+	m_v3BranchMin = vector3(FLT_MAX);
+	m_v3BranchMax = vector3(-FLT_MAX);
+	for (uint i = 0; i < nEntities; i++)
+	{
+		m_EntityList[i] = i;
+		ExpandEntityBounds(i);
+	}
+}
+
+bool MyOctant::ContinueBuild(double a_dBudgetMs)
+{
+	if (this != m_pRoot) return true;
+
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	std::chrono::duration<double, std::milli> tElapsed(0.0);
+	while (m_pTree->eBuildPhase != BUILD_DONE)
+	{
+		if (m_pTree->eBuildPhase == BUILD_SNAPSHOT)
+			SnapshotSlice();
+		else if (m_pTree->eBuildPhase == BUILD_BOUNDS)
+			BoundsSlice();
+		else if (m_pTree->eBuildPhase == BUILD_RESET)
+			ResetSlice();
+		else if (m_pTree->eBuildPhase == BUILD_SPLIT)
+			SplitSlice();
+		else if (m_pTree->eBuildPhase == BUILD_LIST)
+			ListSlice();
+		else
+			LinkSlice();
+
+		tElapsed = std::chrono::high_resolution_clock::now() - tStart;
+		if (tElapsed.count() >= a_dBudgetMs) break;
+	}
+	m_pTree->dBuildMs += tElapsed.count();
+	return m_pTree->eBuildPhase == BUILD_DONE;
+}
+
+bool MyOctant::IsBuilding(void) { return m_pRoot->m_pTree->eBuildPhase != BUILD_DONE; }
+
+bool MyOctant::IsLinking(void) { return !m_pRoot->m_pTree->bLinkEntities; }
+
+void MyOctant::SnapshotSlice(void)
+{
+	//the count is asked every slice, the link drops what is removed after its box was taken
+	uint nEntities = m_pTree->pEntityMngr->GetEntityCount();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(m_pTree->uSliceCursor)->GetRigidBody();
+		m_pTree->lEntityMin.push_back(pRigidBody->GetMinGlobal());
+		m_pTree->lEntityMax.push_back(pRigidBody->GetMaxGlobal());
+	}
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	m_pTree->uSliceCursor = 0;
+	m_pTree->eBuildPhase = BUILD_BOUNDS;
+}
+
+void MyOctant::BoundsSlice(void)
+{
+	uint nEntities = m_pTree->lEntityMin.size();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		m_pTree->v3SliceMin = glm::min(m_pTree->v3SliceMin, m_pTree->lEntityMin[m_pTree->uSliceCursor]);
+		m_pTree->v3SliceMax = glm::max(m_pTree->v3SliceMax, m_pTree->lEntityMax[m_pTree->uSliceCursor]);
+	}
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	if (nEntities > 0)
+		SetRootVolume(m_pTree->v3SliceMin, m_pTree->v3SliceMax);
+	else
+		SetRootVolume(vector3(0.0f), vector3(0.0f));
+
+	//the start of ResetTree, the root gets its entities in the slices that follow
+	m_pTree->uOctantCount = 1;
+	KillBranches();
+	m_pTree->lChild.clear();
+	m_EntityList.clear();
+	m_EntityList.reserve(nEntities);
+	m_v3EntityMin = vector3(FLT_MAX);
+	m_v3EntityMax = vector3(-FLT_MAX);
+	m_v3BranchMin = vector3(FLT_MAX);
+	m_v3BranchMax = vector3(-FLT_MAX);
+	m_pTree->uSliceCursor = 0;
+	m_pTree->eBuildPhase = BUILD_RESET;
+}
+
+void MyOctant::ResetSlice(void)
+{
+	uint nEntities = m_pTree->lEntityMin.size();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		m_EntityList.push_back(m_pTree->uSliceCursor);
+		ExpandEntityBounds(m_pTree->uSliceCursor);
+	}
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	//the octants are split one at a time, the root first
+	m_pTree->lSplitStack.clear();
+	m_pTree->pSplitOctant = nullptr;
+	if (ContainsMoreThan(m_pTree->uIdealEntityCount) && m_pTree->uMaxLevel > 0)
+		m_pTree->lSplitStack.push_back(this);
+	m_pTree->eBuildPhase = BUILD_SPLIT;
+}
+
+void MyOctant::SplitSlice(void)
+{
+	if (m_pTree->pSplitOctant == nullptr)
+	{
+		//every octant is split, the list of octants with entities is next
+		if (m_pTree->lSplitStack.empty())
+		{
+			m_pTree->lChild.clear();
+			m_pTree->lListStack.clear();
+			m_pTree->lListStack.push_back(std::make_pair(this, 0u));
+			m_pTree->uSliceStored = 0;
+			m_pTree->eBuildPhase = BUILD_LIST;
+			return;
+		}
+
+		m_pTree->pSplitOctant = m_pTree->lSplitStack.back();
+		m_pTree->lSplitStack.pop_back();
+		m_pTree->pSplitOctant->CreateChildren();
+		m_pTree->uSliceCursor = 0;
+		m_pTree->uSliceStay = 0;
+	}
+
+	//the entities are handed down a slice of the list at a time, the last slice cuts the list
+	MyOctant* pOctant = m_pTree->pSplitOctant;
+	uint nEntities = pOctant->m_EntityList.size();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	if (m_pTree->bLoose)
+		pOctant->HandDownLoose(m_pTree->uSliceCursor, nEnd, m_pTree->uSliceStay);
+	else
+	{
+		for (uint i = 0; i < 8; i++)
+		{
+			pOctant->FillChild(i, m_pTree->uSliceCursor, nEnd);
+		}
+	}
+	m_pTree->uSliceCursor = nEnd;
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	if (!m_pTree->bLoose)
+		pOctant->m_EntityList.clear();
+
+	//the last child pushed is split first, the order Subdivide goes through them
+	for (uint i = 8; i-- > 0;)
+	{
+		MyOctant* pChild = pOctant->m_pChild[i];
+		if (pChild->ContainsMoreThan(m_pTree->uIdealEntityCount) && pChild->m_uLevel < m_pTree->uMaxLevel)
+			m_pTree->lSplitStack.push_back(pChild);
+	}
+	m_pTree->pSplitOctant = nullptr;
+}
+
+void MyOctant::ListSlice(void)
+{
+	//children first and then the octant itself, as the recursion of ConstructList goes
+	for (uint n = 0; n < m_uSliceEntities && !m_pTree->lListStack.empty(); n++)
+	{
+		MyOctant* pOctant = m_pTree->lListStack.back().first;
+		uint uChild = m_pTree->lListStack.back().second;
+		if (uChild < pOctant->m_uChildren)
+		{
+			m_pTree->lListStack.back().second++;
+			m_pTree->lListStack.push_back(std::make_pair(pOctant->m_pChild[uChild], 0u));
+		}
+		else
+		{
+			if (pOctant->m_EntityList.size() > 0)
+			{
+				m_pTree->lChild.push_back(pOctant);
+				m_pTree->uSliceStored += pOctant->m_EntityList.size();
+			}
+			m_pTree->lListStack.pop_back();
+		}
+	}
+	if (!m_pTree->lListStack.empty()) return;
+
+	m_pTree->bListDirty = false;
+
+	//the lists are sized up front, growing them would copy them all in a single slice
+	uint nStored = m_pTree->uSliceStored;
+	m_pTree->lDimension.clear();
+	m_pTree->lDimension.reserve(m_pTree->bLoose ? nStored * 2 : nStored);
+	m_pTree->lDimensionFirst.clear();
+	m_pTree->lDimensionFirst.reserve(m_pTree->lEntityMin.size() + 1);
+	m_pTree->lDimensionFirst.push_back(0);
+	m_pTree->uSliceCursor = 0;
+	m_pTree->eBuildPhase = BUILD_LINK;
+}
+
+void MyOctant::LinkSlice(void)
+{
+	uint nEntities = m_pTree->lEntityMin.size();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceSearches, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		GetDimensions(m_pTree->lEntityMin[m_pTree->uSliceCursor], m_pTree->lEntityMax[m_pTree->uSliceCursor], m_pTree->lDimension);
+		m_pTree->lDimensionFirst.push_back(m_pTree->lDimension.size());
+	}
+
+	if (m_pTree->uSliceCursor == nEntities)
+	{
+		std::vector<MyOctant*>().swap(m_pTree->lSplitStack);
+		std::vector<std::pair<MyOctant*, uint>>().swap(m_pTree->lListStack);
+		m_pTree->eBuildPhase = BUILD_DONE;
+	}
+}
+
+void MyOctant::AssignIDtoEntity(void)
+{
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->AssignIDtoEntity();
+	}
+
+	//entities of a loose octree get every octant they could collide in
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		if (m_pRoot->m_pTree->bOwnDimensions)
+		{
+			uint nEntities = m_EntityList.size();
+			for (uint i = 0; i < nEntities; i++)
+			{
+				m_pRoot->AssignLooseIDtoEntity(m_EntityList[i]);
+			}
+		}
+		return;
+	}
+
+	//leafs already hold the entities that overlap them
+	if (m_uChildren == 0 && m_pRoot->m_pTree->bOwnDimensions)
+	{
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			m_pRoot->m_pTree->pEntityMngr->AddDimension(m_EntityList[i], m_uID);
+		}
+	}
+}
+
+void MyOctant::ConstructList(void)
+{
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->ConstructList();
+	}
+
+	//only leafs hold entities unless the octree is loose
+	if (m_EntityList.size() > 0)
+	{
+		m_pRoot->m_pTree->lChild.push_back(this);
+	}
+}
+
+void MyOctant::RemoveIDfromEntity(void)
+{
+	//loose dimensions are replaced as a whole when they are assigned
+	if (m_pRoot->m_pTree->bLoose) return;
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->RemoveIDfromEntity();
+	}
+
+	if (m_uChildren == 0 && m_pRoot->m_pTree->bOwnDimensions)
+	{
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			m_pRoot->m_pTree->pEntityMngr->RemoveDimension(m_EntityList[i], m_uID);
+		}
+	}
+}
+
+void MyOctant::Update(void)
+{
+	//only the root of a tree linked to the entity manager can follow its entities
+	if (this != m_pRoot || !m_pTree->bLinkEntities) return;
+
+	//the Entity Manager removes an entity by moving its last one into the hole, the one that moved
+	//is in the moved list and the last index is no longer there
+	uint nEntities = m_pTree->pEntityMngr->GetEntityCount();
+	if (m_pTree->lEntityMin.size() > nEntities)
+		DropEntities(nEntities);
+
+	std::vector<uint>& lMoved = m_pTree->pEntityMngr->GetMovedList();
+	uint nMoved = lMoved.size();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = lMoved[i];
+		if (uEntity >= nEntities) continue;
+
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(uEntity)->GetRigidBody();
+		UpdateEntity(uEntity, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+	}
+	m_pTree->pEntityMngr->ClearMovedList();
+
+	//entities added after the tree was built
+	for (uint uEntity = m_pTree->lEntityMin.size(); uEntity < nEntities; uEntity++)
+	{
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(uEntity)->GetRigidBody();
+		UpdateEntity(uEntity, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+	}
+}
+
+void MyOctant::UpdateEntity(uint a_uIndex, vector3 a_v3Min, vector3 a_v3Max)
+{
+	if (this != m_pRoot) return;
+
+	//the octants hold the box inside the root, two boxes that overlap still overlap once clamped;
+	//a box that left the root goes to the outside list so the queries test it whole
+	vector3 v3Min = glm::clamp(a_v3Min, m_v3Min, m_v3Max);
+	vector3 v3Max = glm::clamp(a_v3Max, m_v3Min, m_v3Max);
+
+	if (a_uIndex >= m_pTree->lEntityMin.size())
+	{
+		//new entities start with an inverted box that overlaps nothing
+		m_pTree->lEntityMin.resize(a_uIndex + 1, vector3(FLT_MAX));
+		m_pTree->lEntityMax.resize(a_uIndex + 1, vector3(-FLT_MAX));
+	}
+	SetOutside(a_uIndex, v3Min != a_v3Min || v3Max != a_v3Max, a_v3Min, a_v3Max);
+
+	//still in the same octants, nothing else to do
+	if (m_pTree->lEntityMin[a_uIndex] == v3Min && m_pTree->lEntityMax[a_uIndex] == v3Max)
+		return;
+
+	RemoveEntity(a_uIndex, m_pTree->lEntityMin[a_uIndex], m_pTree->lEntityMax[a_uIndex]);
+	m_pTree->lEntityMin[a_uIndex] = v3Min;
+	m_pTree->lEntityMax[a_uIndex] = v3Max;
+	InsertEntity(a_uIndex, v3Min, v3Max);
+
+	m_pTree->bListDirty = true;
+}
+
+bool MyOctant::IsOutside(uint a_uIndex)
+{
+	std::vector<uint> const& lSlot = m_pRoot->m_pTree->lOutsideSlot;
+	return a_uIndex < lSlot.size() && lSlot[a_uIndex] != m_uNotOutside;
+}
+
+void MyOctant::SetOutside(uint a_uIndex, bool a_bOutside, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	uint uSlot = a_uIndex < m_pTree->lOutsideSlot.size() ? m_pTree->lOutsideSlot[a_uIndex] : m_uNotOutside;
+	if (a_bOutside)
+	{
+		if (uSlot == m_uNotOutside)
+		{
+			//the places are only kept while something is outside, the queries skip them otherwise
+			if (m_pTree->lOutsideSlot.size() < m_pTree->lEntityMin.size())
+				m_pTree->lOutsideSlot.resize(m_pTree->lEntityMin.size(), m_uNotOutside);
+			uSlot = m_pTree->lOutside.size();
+			m_pTree->lOutsideSlot[a_uIndex] = uSlot;
+			m_pTree->lOutside.push_back(a_uIndex);
+			m_pTree->lOutsideMin.push_back(a_v3Min);
+			m_pTree->lOutsideMax.push_back(a_v3Max);
+			return;
+		}
+		m_pTree->lOutsideMin[uSlot] = a_v3Min;
+		m_pTree->lOutsideMax[uSlot] = a_v3Max;
+		return;
+	}
+	if (uSlot == m_uNotOutside) return;
+
+	//swap it with the last one and then pop
+	uint uLast = m_pTree->lOutside.back();
+	m_pTree->lOutside[uSlot] = uLast;
+	m_pTree->lOutsideMin[uSlot] = m_pTree->lOutsideMin.back();
+	m_pTree->lOutsideMax[uSlot] = m_pTree->lOutsideMax.back();
+	m_pTree->lOutsideSlot[uLast] = uSlot;
+	m_pTree->lOutside.pop_back();
+	m_pTree->lOutsideMin.pop_back();
+	m_pTree->lOutsideMax.pop_back();
+	m_pTree->lOutsideSlot[a_uIndex] = m_uNotOutside;
+	if (m_pTree->lOutside.empty())
+		m_pTree->lOutsideSlot.clear();
+}
+
+void MyOctant::PrepareLink(void)
+{
+	if (this != m_pRoot) return;
+
+	uint nEntities = m_pTree->lEntityMin.size();
+	m_pTree->lDimension.clear();
+	m_pTree->lDimensionFirst.assign(nEntities + 1, 0);
+
+	if (m_pTree->bLoose)
+	{
+		std::vector<uint> lDimension;
+		for (uint i = 0; i < nEntities; i++)
+		{
+			lDimension.clear();
+			GetDimensions(m_pTree->lEntityMin[i], m_pTree->lEntityMax[i], lDimension);
+			m_pTree->lDimension.insert(m_pTree->lDimension.end(), lDimension.begin(), lDimension.end());
+			m_pTree->lDimensionFirst[i + 1] = m_pTree->lDimension.size();
+		}
+		return;
+	}
+
+	//count the leafs of each entity, then place them
+	uint nLeafs = m_pTree->lChild.size();
+	for (uint i = 0; i < nLeafs; i++)
+	{
+		std::vector<uint>& lEntity = m_pTree->lChild[i]->m_EntityList;
+		for (uint j = 0; j < lEntity.size(); j++)
+		{
+			m_pTree->lDimensionFirst[lEntity[j] + 1]++;
+		}
+	}
+	for (uint i = 0; i < nEntities; i++)
+	{
+		m_pTree->lDimensionFirst[i + 1] += m_pTree->lDimensionFirst[i];
+	}
+
+	m_pTree->lDimension.resize(m_pTree->lDimensionFirst[nEntities]);
+	std::vector<uint> lNext(m_pTree->lDimensionFirst.begin(), m_pTree->lDimensionFirst.end() - 1);
+	for (uint i = 0; i < nLeafs; i++)
+	{
+		std::vector<uint>& lEntity = m_pTree->lChild[i]->m_EntityList;
+		for (uint j = 0; j < lEntity.size(); j++)
+		{
+			m_pTree->lDimension[lNext[lEntity[j]]++] = m_pTree->lChild[i]->m_uID;
+		}
+	}
+}
+
+void MyOctant::GetLinkDimensions(uint a_uIndex, std::vector<uint>& a_lOutput)
+{
+	if (this != m_pRoot || a_uIndex + 1 >= m_pTree->lDimensionFirst.size()) return;
+
+	a_lOutput.insert(a_lOutput.end(), m_pTree->lDimension.begin() + m_pTree->lDimensionFirst[a_uIndex],
+		m_pTree->lDimension.begin() + m_pTree->lDimensionFirst[a_uIndex + 1]);
+}
+
+void MyOctant::LinkEntities(void) { ContinueLink(DBL_MAX); }
+
+bool MyOctant::ContinueLink(double a_dBudgetMs)
+{
+	if (this != m_pRoot || m_pTree->bLinkEntities) return true;
+
+	std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+	if (IsBuilding() && !ContinueBuild(a_dBudgetMs)) return false;
+
+	//the octants of every entity are written from here on, the tree in use gave them up
+	if (m_pTree->eLinkPhase == LINK_DONE)
+	{
+		if (m_pTree->lDimensionFirst.size() != m_pTree->lEntityMin.size() + 1)
+			PrepareLink();
+		m_pTree->bOwnDimensions = true;
+		m_pTree->uSliceCursor = 0;
+		m_pTree->eLinkPhase = LINK_DIMENSIONS;
+	}
+
+	//the moves of every frame are applied even if the build took the whole budget
+	LinkMoves();
+
+	std::chrono::duration<double, std::milli> tElapsed = std::chrono::high_resolution_clock::now() - tStart;
+	while (m_pTree->eLinkPhase != LINK_DONE && tElapsed.count() < a_dBudgetMs)
+	{
+		if (m_pTree->eLinkPhase == LINK_DIMENSIONS)
+			LinkDimensionSlice();
+		else
+			LinkEntitySlice();
+
+		tElapsed = std::chrono::high_resolution_clock::now() - tStart;
+	}
+	return m_pTree->bLinkEntities;
+}
+
+void MyOctant::ReleaseDimensions(void) { m_pRoot->m_pTree->bOwnDimensions = false; }
+
+void MyOctant::LinkMoves(void)
+{
+	//the Entity Manager removes an entity by moving its last one into the hole, the one that moved
+	//is in the moved list and the last index is no longer there
+	uint nEntities = m_pTree->pEntityMngr->GetEntityCount();
+	if (m_pTree->lEntityMin.size() > nEntities)
+		DropEntities(nEntities);
+
+	std::vector<uint>& lMoved = m_pTree->pEntityMngr->GetMovedList();
+	uint nLinked = std::min(m_pTree->uSliceCursor, nEntities);
+	uint nMoved = lMoved.size();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = lMoved[i];
+		if (uEntity >= nLinked) continue;
+
+		//an entity moved into the place of a removed one has the dimensions of its old place
+		if (m_pTree->eLinkPhase == LINK_DIMENSIONS)
+		{
+			LinkDimensions(uEntity);
+			continue;
+		}
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(uEntity)->GetRigidBody();
+		UpdateEntity(uEntity, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+	}
+}
+
+void MyOctant::LinkDimensions(uint a_uIndex)
+{
+	m_pTree->pEntityMngr->ClearDimensionSet(a_uIndex);
+	if (a_uIndex >= m_pTree->lEntityMin.size()) return;
+
+	for (uint j = m_pTree->lDimensionFirst[a_uIndex]; j < m_pTree->lDimensionFirst[a_uIndex + 1]; j++)
+	{
+		m_pTree->pEntityMngr->AddDimension(a_uIndex, m_pTree->lDimension[j]);
+	}
+}
+
+void MyOctant::LinkDimensionSlice(void)
+{
+	//entities added after the boxes were taken start without dimensions, the next phase adds them
+	uint nEntities = m_pTree->pEntityMngr->GetEntityCount();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		LinkDimensions(m_pTree->uSliceCursor);
+	}
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	std::vector<uint>().swap(m_pTree->lDimension);
+	std::vector<uint>().swap(m_pTree->lDimensionFirst);
+	m_pTree->uSliceCursor = 0;
+	m_pTree->eLinkPhase = LINK_ENTITIES;
+}
+
+void MyOctant::LinkEntitySlice(void)
+{
+	//the ones that kept moving are updated and the ones still in place return right away
+	uint nEntities = m_pTree->pEntityMngr->GetEntityCount();
+	uint nEnd = std::min(m_pTree->uSliceCursor + m_uSliceEntities, nEntities);
+	for (; m_pTree->uSliceCursor < nEnd; m_pTree->uSliceCursor++)
+	{
+		MyRigidBody* pRigidBody = m_pTree->pEntityMngr->GetEntity(m_pTree->uSliceCursor)->GetRigidBody();
+		UpdateEntity(m_pTree->uSliceCursor, pRigidBody->GetMinGlobal(), pRigidBody->GetMaxGlobal());
+	}
+	if (m_pTree->uSliceCursor < nEntities) return;
+
+	//the moved list is left to Update, it finds everything in place
+	m_pTree->bLinkEntities = true;
+	m_pTree->eLinkPhase = LINK_DONE;
+}
+
+void MyOctant::InsertEntity(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max)
+{
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		//the entity goes down to the deepest octant that can hold it
+		ExpandBranchBounds(a_uIndex);
+		MyOctant* pChild = GetLooseChild(a_v3Min, a_v3Max);
+		if (pChild != nullptr)
+		{
+			pChild->InsertEntity(a_uIndex, a_v3Min, a_v3Max);
+			return;
+		}
+
+		m_EntityList.push_back(a_uIndex);
+		ExpandEntityBounds(a_uIndex);
+		if (m_uChildren == 0 && ContainsMoreThan(m_pRoot->m_pTree->uIdealEntityCount) && m_uLevel < m_pRoot->m_pTree->uMaxLevel)
+		{
+			//the entities handed down have new octants to collide with
+			Subdivide();
+			AssignIDtoEntity();
+		}
+		else if (m_pRoot->m_pTree->bOwnDimensions)
+		{
+			m_pRoot->AssignLooseIDtoEntity(a_uIndex);
+		}
+		return;
+	}
+
+	if (!IsColliding(a_v3Min, a_v3Max)) return;
+
+	if (m_uChildren == 0)
+	{
+		m_EntityList.push_back(a_uIndex);
+		if (m_pRoot->m_pTree->bOwnDimensions)
+			m_pRoot->m_pTree->pEntityMngr->AddDimension(a_uIndex, m_uID);
+
+		//too many entities, the leaf becomes a branch and hands them down
+		if (ContainsMoreThan(m_pRoot->m_pTree->uIdealEntityCount) && m_uLevel < m_pRoot->m_pTree->uMaxLevel)
+		{
+			RemoveIDfromEntity();
+			Subdivide();
+			AssignIDtoEntity();
+		}
+		return;
+	}
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->InsertEntity(a_uIndex, a_v3Min, a_v3Max);
+	}
+}
+
+void MyOctant::RemoveEntity(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max, bool a_bGone)
+{
+	if (!IsColliding(a_v3Min, a_v3Max) && this == m_pRoot) return;
+
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		//follow the same path it was inserted with
+		MyOctant* pChild = GetLooseChild(a_v3Min, a_v3Max);
+		if (pChild != nullptr)
+		{
+			pChild->RemoveEntity(a_uIndex, a_v3Min, a_v3Max, a_bGone);
+			if (!a_bGone)
+				TryMerge();
+
+			//the bounds only grow as entities come in, they shrink on the way up from a removal
+			RefitLooseBounds(false);
+			return;
+		}
+
+		//its dimensions are replaced when it is inserted again
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			if (m_EntityList[i] == a_uIndex)
+			{
+				std::swap(m_EntityList[i], m_EntityList[nEntities - 1]);
+				m_EntityList.pop_back();
+				RefitLooseBounds(true);
+				break;
+			}
+		}
+		return;
+	}
+
+	if (!IsColliding(a_v3Min, a_v3Max)) return;
+
+	if (m_uChildren == 0)
+	{
+		uint nEntities = m_EntityList.size();
+		for (uint i = 0; i < nEntities; i++)
+		{
+			if (m_EntityList[i] == a_uIndex)
+			{
+				//swap it with the last one and then pop
+				std::swap(m_EntityList[i], m_EntityList[nEntities - 1]);
+				m_EntityList.pop_back();
+				if (m_pRoot->m_pTree->bOwnDimensions && !a_bGone)
+					m_pRoot->m_pTree->pEntityMngr->RemoveDimension(a_uIndex, m_uID);
+				break;
+			}
+		}
+		return;
+	}
+
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		m_pChild[i]->RemoveEntity(a_uIndex, a_v3Min, a_v3Max, a_bGone);
+	}
+
+	//children are processed first so merges go up the branch
+	if (!a_bGone)
+		TryMerge();
+}
+
+void MyOctant::DropEntities(uint a_uCount)
+{
+	//the Entity Manager asks for the last index when given one past its count, so the ones it
+	//removed leave the octants without touching it; merges wait for the next move so that no
+	//dimension is handed to an Entity that is not there
+	for (uint uEntity = m_pTree->lEntityMin.size(); uEntity-- > a_uCount;)
+	{
+		SetOutside(uEntity, false, m_pTree->lEntityMin[uEntity], m_pTree->lEntityMax[uEntity]);
+		RemoveEntity(uEntity, m_pTree->lEntityMin[uEntity], m_pTree->lEntityMax[uEntity], true);
+	}
+	m_pTree->lEntityMin.resize(a_uCount);
+	m_pTree->lEntityMax.resize(a_uCount);
+	m_pTree->bListDirty = true;
+}
+
+bool MyOctant::TryMerge(void)
+{
+	if (m_uChildren == 0) return false;
+
+	//only branches with leafs for children can merge, an entity is in 8 children at most
+	uint nTotal = 0;
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		if (!m_pChild[i]->IsLeaf()) return false;
+		nTotal += m_pChild[i]->m_EntityList.size();
+	}
+	if (m_pRoot->m_pTree->bLoose)
+	{
+		//entities are stored once, the children hand theirs back to this octant
+		nTotal += m_EntityList.size();
+		if (nTotal > m_pRoot->m_pTree->uIdealEntityCount) return false;
+
+		for (uint i = 0; i < m_uChildren; i++)
+		{
+			m_EntityList.insert(m_EntityList.end(), m_pChild[i]->m_EntityList.begin(), m_pChild[i]->m_EntityList.end());
+			m_v3EntityMin = glm::min(m_v3EntityMin, m_pChild[i]->m_v3EntityMin);
+			m_v3EntityMax = glm::max(m_v3EntityMax, m_pChild[i]->m_v3EntityMax);
+		}
+		KillBranches();
+		AssignIDtoEntity();
+		return true;
+	}
+
+	if (nTotal > m_pRoot->m_pTree->uIdealEntityCount * 8) return false;
+
+	//gather the entities of the children
+	std::vector<uint> lEntities;
+	lEntities.reserve(nTotal);
+	for (uint i = 0; i < m_uChildren; i++)
+	{
+		lEntities.insert(lEntities.end(), m_pChild[i]->m_EntityList.begin(), m_pChild[i]->m_EntityList.end());
+	}
+
+	//entities on the border of the children are in more than one of them
+	std::sort(lEntities.begin(), lEntities.end());
+	lEntities.erase(std::unique(lEntities.begin(), lEntities.end()), lEntities.end());
+	if (lEntities.size() > m_pRoot->m_pTree->uIdealEntityCount) return false;
+
+	RemoveIDfromEntity();
+	KillBranches();
+	m_EntityList.swap(lEntities);
+	AssignIDtoEntity();
+	return true;
 }
\ No newline at end of file
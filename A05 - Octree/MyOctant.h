@@ -2,6 +2,12 @@
 #define __MYOCTANTCLASS_H_
 
 #include "MyEntityManager.h"
+#include "MyTaskPool.h"
+
+#include <cfloat>
+#include <chrono>
+#include <new>
+#include <sstream>
 
 namespace Simplex
 {
@@ -9,9 +15,94 @@ namespace Simplex
 	//System Class
 	class MyOctant
 	{
-		static uint m_uOctantCount; //will store the number of octants instantiated
-		static uint m_uMaxLevel;//will store the maximum level an octant can go to
-		static uint m_uIdealEntityCount; //will tell how many ideal Entities this object will contain
+		//Ray or segment going through the tree, the direction is normalized
+		struct RayQuery
+		{
+			vector3 v3Origin = vector3(0.0f); //start of the ray
+			vector3 v3Direction = vector3(0.0f); //normalized direction of the ray
+			float fMaxDistance = FLT_MAX; //end of the ray, shrinks to the nearest hit so far when only that one is wanted
+			bool bAnyHit = false; //stop at the first hit found
+			bool bHit = false; //was anything hit
+			uint uEntity = 0; //nearest Entity hit so far
+			std::vector<std::pair<float, uint>>* pAllHits = nullptr; //every hit when not null
+			uint uStamp = 0; //stamp of the Entities already in the hits, a regular octree has them in more than one leaf
+		};
+
+		//Work left for a tree built a slice at a time
+		enum BuildPhase
+		{
+			BUILD_DONE, //the tree is complete
+			BUILD_SNAPSHOT, //the bounding boxes of the Entities are being taken from the Entity Manager
+			BUILD_BOUNDS, //the root volume is being fit around the bounding boxes
+			BUILD_RESET, //the root is being given every Entity
+			BUILD_SPLIT, //octants holding too many Entities are being split
+			BUILD_LIST, //the list of octants with Entities is being made
+			BUILD_LINK //the octants of every Entity are being found for the link
+		};
+
+		//Work left for a tree being linked to the Entity Manager a slice at a time
+		enum LinkPhase
+		{
+			LINK_DONE, //the tree is not being linked
+			LINK_DIMENSIONS, //the dimensions of the Entities are being replaced with the octants found for them
+			LINK_ENTITIES //the Entities that moved or were added since their boxes were taken are being updated
+		};
+
+		//State of the whole tree, the root owns it and the other octants reach it through the root
+		struct TreeState
+		{
+			uint uOctantCount = 0; //will store the number of octants instantiated
+			uint uMaxLevel = 3;//will store the maximum level an octant can go to
+			uint uIdealEntityCount = 5; //will tell how many ideal Entities this object will contain
+
+			MeshManager* pMeshMngr = MeshManager::GetInstance();//Mesh Manager singleton
+			MyEntityManager* pEntityMngr = MyEntityManager::GetInstance(); //Entity Manager Singleton
+
+			std::vector<MyOctant*> lChild; //list of nodes that contain objects
+
+			std::vector<vector3> lEntityMin; //minimum corner of every Entity taken when building
+			std::vector<vector3> lEntityMax; //maximum corner of every Entity taken when building
+			std::vector<uint> lOutside; //Entities whose box left the root after the build, the tree holds them clamped to it
+			std::vector<vector3> lOutsideMin; //minimum corner of each Entity in the outside list, not clamped
+			std::vector<vector3> lOutsideMax; //maximum corner of each Entity in the outside list, not clamped
+			std::vector<uint> lOutsideSlot; //place of each Entity in the outside list, empty while the list is
+			bool bLinkEntities = true; //does the tree follow the Entities of the Entity Manager
+			bool bOwnDimensions = true; //will the leafs set their ID as a dimension in the Entity Manager, a tree being linked takes them from the one in use
+			bool bListDirty = false; //does the list of leafs with objects need to be reconstructed
+			bool bLoose = false; //is this a loose octree, each Entity lives in a single octant
+			float fLooseness = 1.0f; //scale of the loose bounds of each octant over its size
+			bool bParallelBuild = false; //is the tree being built by the task pool
+			uint uBuildThreadCount = 1; //threads building the tree, 0 for one per core and 1 for a serial build
+			uint uParallelCutoff = 4096; //octants holding less Entities than this are built by a single thread
+			std::mutex PoolMutex; //guards the node pool while a parallel build takes blocks
+			std::vector<uint> lDimension; //octants of every Entity found away from the main thread, waiting to be linked
+			std::vector<uint> lDimensionFirst; //where the octants of each Entity start in lDimension, one more than Entities
+			std::vector<uint> lQueryStamp; //stamp of the last query that returned each Entity, kept between queries
+			uint uQueryStamp = 0; //stamp of the query running, newer than every one in the list
+			std::vector<uint> lPairHit; //room for the boxes overlapping one while finding pairs, kept between frames
+
+			BuildPhase eBuildPhase = BUILD_DONE; //what a sliced build does next
+			LinkPhase eLinkPhase = LINK_DONE; //what ContinueLink does next
+			vector3 v3SliceMin = vector3(FLT_MAX); //minimum corner of the boxes a sliced build went through so far
+			vector3 v3SliceMax = vector3(-FLT_MAX); //maximum corner of the boxes a sliced build went through so far
+			uint uSliceStored = 0; //Entities held by the octants a sliced build listed so far
+			std::vector<MyOctant*> lSplitStack; //octants a sliced build still has to split, the next one last
+			MyOctant* pSplitOctant = nullptr; //octant a sliced build is handing the Entities of down
+			std::vector<std::pair<MyOctant*, uint>> lListStack; //octants being listed and their next child
+			uint uSliceCursor = 0; //next Entity of the snapshot, the octant being split or the link
+			uint uSliceStay = 0; //Entities that stay in the loose octant being split so far
+
+			std::vector<MyOctant*> lPoolChunk; //memory of the node pool, octants are never deleted one by one
+			std::vector<MyOctant*> lPoolFree; //blocks given back by merges, handed out before any other
+			uint uPoolBlockCount = 0; //blocks constructed in the node pool
+			uint uPoolBlockUsed = 0; //blocks handed out since the last build
+			double dBuildMs = 0.0; //time the last full build took, slices of a sliced build added up
+		};
+
+		static const uint m_uNotOutside = static_cast<uint>(-1); //place in the outside list of an Entity inside of the root
+		static const uint m_uSliceEntities = 1024; //Entities taken, handed down or linked, or octants listed, between two looks at the clock
+		static const uint m_uSliceSearches = 128; //Entities whose octants are searched between two looks at the clock, each one walks the tree
+		static const uint m_uPoolChunkBlocks = 64; //blocks of 8 siblings allocated at once by the node pool
 
 		uint m_uID = 0; //Will store the current ID for this octant
 		uint m_uLevel = 0; //Will store the current level of the octant
@@ -19,12 +110,13 @@ namespace Simplex
 
 		float m_fSize = 0.0f; //Size of the octant
 
-		MeshManager* m_pMeshMngr = nullptr;//Mesh Manager singleton
-		MyEntityManager* m_pEntityMngr = nullptr; //Entity Manager Singleton
-
 		vector3 m_v3Center = vector3(0.0f); //Will store the center point of the octant
 		vector3 m_v3Min = vector3(0.0f); //Will store the minimum vector of the octant
 		vector3 m_v3Max = vector3(0.0f); //Will store the maximum vector of the octant
+		vector3 m_v3EntityMin = vector3(FLT_MAX); //minimum corner of the Entities stored in the octant (loose only)
+		vector3 m_v3EntityMax = vector3(-FLT_MAX); //maximum corner of the Entities stored in the octant (loose only)
+		vector3 m_v3BranchMin = vector3(FLT_MAX); //minimum corner of the Entities in the octant and below (loose only)
+		vector3 m_v3BranchMax = vector3(-FLT_MAX); //maximum corner of the Entities in the octant and below (loose only)
 
 		MyOctant* m_pParent = nullptr;// Will store the parent of current octant
 		MyOctant* m_pChild[8];//Will store the children of the current octant
@@ -32,18 +124,55 @@ namespace Simplex
 		std::vector<uint> m_EntityList; //List of Entities under this octant (Index in Entity Manager)
 
 		MyOctant* m_pRoot = nullptr;//Root octant
-		std::vector<MyOctant*> m_lChild; //list of nodes that contain objects (this will be applied to root only)
+		TreeState* m_pTree = nullptr; //state of the whole tree (root only, the other octants use the one of m_pRoot)
 
 	public:
+		//Shape of the tree, what GetStats fills
+		struct Stats
+		{
+			uint uOctantCount = 0; //octants in the tree, the root included
+			uint uEntityCount = 0; //Entities the tree knows of
+			std::vector<uint> lLevelOctants; //octants on each level, the root level first
+			uint uLeafCount = 0; //octants without children
+			uint uEmptyLeafCount = 0; //leafs without Entities
+			std::vector<uint> lLeafOccupancy; //leafs holding as many Entities as the index, the last one that many or more
+			uint uMaxLeafEntities = 0; //most Entities in a single leaf
+			uint uBranchEntities = 0; //Entities stored above the leafs (loose only)
+			float fDuplication = 0.0f; //average number of octants each Entity is stored in
+			double dBuildMs = 0.0; //time the last full build took
+			size_t uMemoryBytes = 0; //memory held by the tree: octants, lists and snapshot
+		};
+
 		/*
 		USAGE: Constructor, will create an octant containing all MagnaEntities Instances in the Mesh
 		manager	currently contains
 		ARGUMENTS:
 		- uint a_nMaxLevel = 2 -> Sets the maximum level of subdivision
 		- uint nIdealEntityCount = 5 -> Sets the ideal level of objects per octant
+		- float a_fLooseness = 0.0f -> 0 builds a regular octree, 1 or more a loose octree whose
+		octants have bounds this many times their size
+		- bool a_bSliced = false -> only set the root up, ContinueBuild takes the bounding boxes and
+		builds the rest a slice at a time and ContinueLink links it to the Entities
+		OUTPUT: class object
+		*/
+		MyOctant(uint a_nMaxLevel = 2, uint a_nIdealEntityCount = 5, float a_fLooseness = 0.0f, bool a_bSliced = false);
+		/*
+		USAGE: Constructor, will create an octant containing the bounding boxes provided instead of
+		the Entities in the Entity Manager, no dimensions will be assigned (used for benchmarking)
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of each bounding box
+		- std::vector<vector3> const& a_lMax -> maximum corner of each bounding box
+		- uint a_nMaxLevel -> Sets the maximum level of subdivision
+		- uint a_nIdealEntityCount -> Sets the ideal level of objects per octant
+		- float a_fLooseness = 0.0f -> 0 builds a regular octree, 1 or more a loose octree
+		- bool a_bSliced = false -> only set the root up, ContinueBuild builds the rest a slice at a time
+		- uint a_uThreadCount = 1 -> threads building the tree, 0 for one per core and 1 for a serial build
+		- uint a_uCutoff = 4096 -> octants holding less Entities than this are not split in tasks
 		OUTPUT: class object
 		*/
-		MyOctant(uint a_nMaxLevel = 2, uint a_nIdealEntityCount = 5);
+		MyOctant(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness = 0.0f, bool a_bSliced = false,
+			uint a_uThreadCount = 1, uint a_uCutoff = 4096);
 		/*
 		USAGE: Constructor
 		ARGUMENTS:
@@ -110,6 +239,14 @@ namespace Simplex
 		*/
 		bool IsColliding(uint a_uRBIndex);
 		/*
+		USAGE: Asks if there is a collision with the bounding box specified
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		OUTPUT: check of the collision
+		*/
+		bool IsColliding(vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
 		USAGE: Displays the MyOctant volume specified by index including the objects underneath
 		ARGUMENTS:
 		- uint a_nIndex -> MyOctant to be displayed.
@@ -138,7 +275,8 @@ namespace Simplex
 		*/
 		void ClearEntityList(void);
 		/*
-		USAGE: allocates 8 smaller octants in the child pointers
+		USAGE: takes a block of 8 smaller octants from the node pool for the child pointers, each child keeps the Entities
+		of this octant that overlap it and subdivides further if it holds too many
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
@@ -169,7 +307,8 @@ namespace Simplex
 		*/
 		bool ContainsMoreThan(uint a_nEntities);
 		/*
-		USAGE: Deletes all children and the children of their children (almost sounds apocalyptic)
+		USAGE: Deletes all children and the children of their children (almost sounds apocalyptic),
+		their blocks go back to the node pool; on the root the whole pool is reset at once
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
@@ -189,20 +328,717 @@ namespace Simplex
 		void AssignIDtoEntity(void);
 
 		/*
-		USAGE: Gets the total number of octants in the world
+		USAGE: Gets the total number of octants in the world (IDs handed out, merged octants included)
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
 		uint GetOctantCount(void);
+		/*
+		USAGE: Sets how the next builds of this tree (Rebuild) are constructed, the tasks of a parallel
+		build take the branches of octants holding at least the cutoff and the smaller ones are built
+		serially by the task that got to them; the octant IDs and the dimensions do not depend on
+		the thread count
+		ARGUMENTS:
+		- uint a_uThreadCount -> threads building the tree, 0 for one per core and 1 for a serial build
+		- uint a_uCutoff = 4096 -> octants holding less Entities than this are not split in tasks
+		OUTPUT: ---
+		*/
+		void SetBuildThreads(uint a_uThreadCount, uint a_uCutoff = 4096);
+		/*
+		USAGE: Gets the number of threads this tree is built with, 0 for one per core
+		ARGUMENTS: ---
+		OUTPUT: thread count
+		*/
+		uint GetBuildThreadCount(void);
 
 		/*
-		USAGE: creates the list of all leafs that contains objects.
+		USAGE: Builds the tree again, the octants of the last build go back to the node pool at once
+		and are reused; a tree linked to the Entity Manager takes a new snapshot of the Entities first
+		(as with a new tree the dimensions of the last build are not removed)
+		ARGUMENTS:
+		- uint a_nMaxLevel -> Sets the maximum level of subdivision
+		- uint a_nIdealEntityCount -> Sets the ideal level of objects per octant
+		- float a_fLooseness = 0.0f -> 0 builds a regular octree, 1 or more a loose octree
+		OUTPUT: ---
+		*/
+		void Rebuild(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness = 0.0f);
+		/*
+		USAGE: Gets the number of chunks the node pool has allocated since the tree was created
+		ARGUMENTS: ---
+		OUTPUT: chunk count
+		*/
+		uint GetPoolAllocationCount(void);
+		/*
+		USAGE: Asks if this is a loose octree
+		ARGUMENTS: ---
+		OUTPUT: is it loose?
+		*/
+		bool IsLoose(void);
+		/*
+		USAGE: Gets the average number of octants each Entity is stored in, a loose octree stores
+		every Entity once
+		ARGUMENTS: ---
+		OUTPUT: stored Entities over the Entity count
+		*/
+		float GetDuplicationFactor(void);
+		/*
+		USAGE: Gets the number of octants on each level, the leaf occupancy and the memory of the tree
+		ARGUMENTS: Stats& a_Output -> output statistics
+		OUTPUT: ---
+		*/
+		void GetStats(Stats& a_Output);
+		/*
+		USAGE: Writes statistics as a JSON object, for the benchmark tracking
+		ARGUMENTS: Stats const& a_Stats -> statistics to write
+		OUTPUT: JSON text
+		*/
+		static String GetStatsJSON(Stats const& a_Stats);
+		/*
+		USAGE: Gets the IDs a bounding box gets as dimensions: the leafs holding Entities it overlaps
+		or, on a loose octree, the octants whose stored Entities it could overlap
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		- std::vector<uint>& a_lOutput -> list the IDs are appended to
+		OUTPUT: ---
+		*/
+		void GetDimensions(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Gets every pair of Entities whose bounding boxes overlap, each pair once and with the
+		smaller index first; on a regular octree the pairs come from the leafs, a pair belongs to the
+		leaf holding the minimum corner of the overlap, on a loose octree each octant holding Entities
+		looks for the octants it could overlap and the one with the smaller ID adds the pairs (root only)
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput);
+		/*
+		USAGE: Gets the Entities whose bounding box is inside of the view frustum, branches outside
+		of it are skipped and branches inside of it are taken whole without testing their Entities,
+		each Entity is added once (root only)
+		ARGUMENTS:
+		- matrix4 const& a_m4ViewProjection -> projection times view matrix of the camera
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetVisible(matrix4 const& a_m4ViewProjection, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Gets the nearest Entity a ray or segment hits, octants are visited front to back and
+		the ones past the nearest hit so far are skipped (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Origin -> start of the ray in global space
+		- vector3 const& a_v3Direction -> direction of the ray, does not need to be normalized
+		- uint& a_uEntity -> output index of the Entity hit
+		- float& a_fDistance -> output distance to where the ray enters its bounding box (0 if it starts inside)
+		- float a_fMaxDistance = FLT_MAX -> length of the segment, a ray when left as is
+		OUTPUT: was anything hit?
+		*/
+		bool GetNearestHit(vector3 const& a_v3Origin, vector3 const& a_v3Direction, uint& a_uEntity,
+			float& a_fDistance, float a_fMaxDistance = FLT_MAX);
+		/*
+		USAGE: Gets every Entity a ray or segment hits sorted by distance, each Entity once (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Origin -> start of the ray in global space
+		- vector3 const& a_v3Direction -> direction of the ray, does not need to be normalized
+		- std::vector<std::pair<float, uint>>& a_lOutput -> list the distance and index of each Entity hit are appended to
+		- float a_fMaxDistance = FLT_MAX -> length of the segment, a ray when left as is
+		OUTPUT: ---
+		*/
+		void GetAllHits(vector3 const& a_v3Origin, vector3 const& a_v3Direction,
+			std::vector<std::pair<float, uint>>& a_lOutput, float a_fMaxDistance = FLT_MAX);
+		/*
+		USAGE: Asks if a ray or segment hits any Entity, stops at the first one found (line of sight) (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Origin -> start of the ray in global space
+		- vector3 const& a_v3Direction -> direction of the ray, does not need to be normalized
+		- float a_fMaxDistance = FLT_MAX -> length of the segment, a ray when left as is
+		OUTPUT: was anything hit?
+		*/
+		bool IsAnyHit(vector3 const& a_v3Origin, vector3 const& a_v3Direction, float a_fMaxDistance = FLT_MAX);
+		/*
+		USAGE: Gets the Entities whose bounding box overlaps the box specified, each Entity once;
+		the output is only appended to so a buffer reused between queries does not allocate (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetInBox(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Gets the Entities whose bounding box is within the radius of the point specified,
+		each Entity once, octants farther than the radius are skipped (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Center -> center of the sphere in global space
+		- float a_fRadius -> radius of the sphere
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetInSphere(vector3 const& a_v3Center, float a_fRadius, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Gets the Entities in the radius of each of the points specified (root only)
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lCenter -> center of each sphere in global space
+		- float a_fRadius -> radius of the spheres
+		- std::vector<uint>& a_lOutput -> output Entity indices of all the spheres one after the other
+		(cleared first, its memory is reused)
+		- std::vector<uint>& a_lFirst -> output first index in a_lOutput of each sphere, plus the end
+		of the last one (cleared first, its memory is reused)
+		OUTPUT: ---
+		*/
+		void GetInSphere(std::vector<vector3> const& a_lCenter, float a_fRadius, std::vector<uint>& a_lOutput,
+			std::vector<uint>& a_lFirst);
+		/*
+		USAGE: Gets the Entities whose bounding box is nearest to the point specified sorted by
+		distance, octants are visited from the nearest and skipped once they are farther than the
+		farthest of the ones found (root only)
+		ARGUMENTS:
+		- vector3 const& a_v3Point -> point in global space
+		- uint a_uCount -> number of Entities to find (less if there are not that many)
+		- std::vector<std::pair<float, uint>>& a_lOutput -> list the distance and index of each Entity
+		are appended to
+		OUTPUT: ---
+		*/
+		void GetNearest(vector3 const& a_v3Point, uint a_uCount, std::vector<std::pair<float, uint>>& a_lOutput);
+		/*
+		USAGE: Gets the Entities nearest to each of the points specified (root only)
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lPoint -> points in global space
+		- uint a_uCount -> number of Entities to find for each point
+		- std::vector<std::pair<float, uint>>& a_lOutput -> output distance and index of the Entities
+		of all the points one after the other (cleared first, its memory is reused)
+		- std::vector<uint>& a_lFirst -> output first index in a_lOutput of each point, plus the end
+		of the last one (cleared first, its memory is reused)
+		OUTPUT: ---
+		*/
+		void GetNearest(std::vector<vector3> const& a_lPoint, uint a_uCount,
+			std::vector<std::pair<float, uint>>& a_lOutput, std::vector<uint>& a_lFirst);
+		/*
+		USAGE: Gets the squared distance from a point to a box, 0 if it is inside
+		ARGUMENTS:
+		- vector3 const& a_v3Point -> point
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		OUTPUT: squared distance
+		*/
+		static float GetDistanceSquared(vector3 const& a_v3Point, vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Asks if a ray hits a box with the slab test
+		ARGUMENTS:
+		- vector3 const& a_v3Origin -> start of the ray
+		- vector3 const& a_v3Direction -> direction of the ray
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		- float a_fMaxDistance -> the box must be entered before this distance
+		- float& a_fDistance -> output distance the ray enters the box at (0 if it starts inside)
+		OUTPUT: does it hit?
+		*/
+		static bool IsRayHitting(vector3 const& a_v3Origin, vector3 const& a_v3Direction, vector3 const& a_v3Min,
+			vector3 const& a_v3Max, float a_fMaxDistance, float& a_fDistance);
+
+		/*
+		USAGE: Moves the Entities the Entity Manager flagged as moved between the leafs and adds the
+		ones created after the tree, only the octants they touch are split or merged
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Update(void);
+		/*
+		USAGE: Moves an Entity to the leafs that overlap its new bounding box, leafs holding more
+		than the ideal count get subdivided and branches holding less get merged back into a leaf;
+		boxes are clamped to the root volume so entities outside of it stay on the border leafs, the
+		queries test those from the outside list with the box given
+		ARGUMENTS:
+		- uint a_uIndex -> index of the Entity (an index past the known ones is inserted as new)
+		- vector3 a_v3Min -> new minimum corner in global space
+		- vector3 a_v3Max -> new maximum corner in global space
+		OUTPUT: ---
+		*/
+		void UpdateEntity(uint a_uIndex, vector3 a_v3Min, vector3 a_v3Max);
+		/*
+		USAGE: Finds the octants of every Entity of a tree built from bounding boxes without touching
+		the Entity Manager, so it can run on the thread that built the tree
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void PrepareLink(void);
+		/*
+		USAGE: Gets the octants PrepareLink or a sliced build found for an Entity, the dimensions the
+		link gives it
+		ARGUMENTS:
+		- uint a_uIndex -> index of the Entity
+		- std::vector<uint>& a_lOutput -> octants are appended here
+		OUTPUT: ---
+		*/
+		void GetLinkDimensions(uint a_uIndex, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Links a tree built from bounding boxes to the Entity Manager on the main thread at once,
+		as ContinueLink does with no limit of time
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void LinkEntities(void);
+		/*
+		USAGE: Links a tree built from bounding boxes to the Entity Manager for about the time given
+		and stops, the next call picks up where this one left: the dimensions of every Entity are
+		replaced with its octants and then the Entities that moved or were added since the boxes were
+		taken are updated, from then on it works as a tree built from the Entity Manager. A sliced
+		build is finished first. The tree in use has to give its dimensions up with ReleaseDimensions
+		before the first call, and each call has to come before the moved list is cleared so no move
+		is missed; the dimensions mix the octants of both trees until the link is done
+		ARGUMENTS:
+		- double a_dBudgetMs -> milliseconds to work for, one slice always runs
+		OUTPUT: is the tree linked?
+		*/
+		bool ContinueLink(double a_dBudgetMs);
+		/*
+		USAGE: Stops setting the octants of the tree as dimensions of the Entities, so a new tree can
+		be linked while this one stays in use; Rebuild takes them back
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ReleaseDimensions(void);
+		/*
+		USAGE: Builds a tree created sliced for about the time given and stops, the next call picks
+		up where this one left; the octants are split in the same order as ConstructTree so the
+		finished tree is the same, then the octants of every Entity are found as PrepareLink does.
+		Nothing but ContinueLink should be asked of the tree until it is done
+		ARGUMENTS:
+		- double a_dBudgetMs -> milliseconds to work for, one slice always runs
+		OUTPUT: is the tree done?
+		*/
+		bool ContinueBuild(double a_dBudgetMs);
+		/*
+		USAGE: Asks if a sliced build still has work left
+		ARGUMENTS: ---
+		OUTPUT: is it building?
+		*/
+		bool IsBuilding(void);
+		/*
+		USAGE: Asks if the tree was built from bounding boxes and is not linked to the Entity Manager yet
+		ARGUMENTS: ---
+		OUTPUT: is it waiting for the link?
+		*/
+		bool IsLinking(void);
+
+		/*
+		USAGE: creates the list of all octants that contains objects (only leafs unless loose).
 		ARGUMENTS: ---
 		OUTPUT: ---
 		*/
 		void ConstructList(void);
 
 	private:
+		/*
+		USAGE: Constructor of the octants in the node pool, they stay empty until handed out
+		ARGUMENTS: MyOctant* a_pRoot -> root that owns the pool
+		OUTPUT: class object
+		*/
+		explicit MyOctant(MyOctant* a_pRoot);
+		/*
+		USAGE: Takes the bounding boxes of all the Entities in the Entity Manager (root only)
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void TakeSnapshot(void);
+		/*
+		USAGE: Sets the root volume around the bounding boxes stored in the root and builds the tree
+		ARGUMENTS:
+		- uint a_nMaxLevel -> Sets the maximum level of subdivision
+		- uint a_nIdealEntityCount -> Sets the ideal level of objects per octant
+		- float a_fLooseness -> 0 builds a regular octree, 1 or more a loose octree
+		- bool a_bSliced = false -> leave the tree to ContinueBuild instead of building it
+		OUTPUT: ---
+		*/
+		void InitRoot(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness, bool a_bSliced = false);
+		/*
+		USAGE: Clears the tree and gives the root every Entity, the first step of any build
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ResetTree(void);
+		/*
+		USAGE: Sets the root as the cube around the corners given
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the boxes
+		- vector3 const& a_v3Max -> maximum corner of the boxes
+		OUTPUT: ---
+		*/
+		void SetRootVolume(vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Takes the bounding boxes of the next slice of Entities from the Entity Manager, the
+		ones added meanwhile are taken too
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void SnapshotSlice(void);
+		/*
+		USAGE: Grows the root volume around the next slice of bounding boxes, once they are all in
+		the root is set and the tree cleared
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void BoundsSlice(void);
+		/*
+		USAGE: Gives the root the next slice of Entities as ResetTree does, once it has them all it
+		is queued to be split
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ResetSlice(void);
+		/*
+		USAGE: Hands down the next slice of Entities of the octant a sliced build is splitting, once
+		they are all down its children holding too many are queued to be split
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void SplitSlice(void);
+		/*
+		USAGE: Adds the next slice of octants to the list of octants with Entities, in the order
+		ConstructList does
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ListSlice(void);
+		/*
+		USAGE: Finds the octants of the next slice of Entities of a sliced build
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void LinkSlice(void);
+		/*
+		USAGE: Replaces the dimensions of the next slice of Entities with the octants found for them
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void LinkDimensionSlice(void);
+		/*
+		USAGE: Updates the next slice of Entities with their current bounding box, the dimensions
+		follow them from now on
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void LinkEntitySlice(void);
+		/*
+		USAGE: Catches the link up with the Entity Manager: removed Entities are dropped and the ones
+		that moved are linked again if their slice is already done, the rest wait for their slice
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void LinkMoves(void);
+		/*
+		USAGE: Replaces the dimensions of an Entity with the octants found for it, an Entity added
+		after the boxes were taken is left without any until it is updated
+		ARGUMENTS: uint a_uIndex -> index of the Entity
+		OUTPUT: ---
+		*/
+		void LinkDimensions(uint a_uIndex);
+		/*
+		USAGE: Subdivides like Subdivide but hands the children to the task pool, each task fills a
+		child from the list of this octant and subdivides it (regular) or the children are filled in
+		one pass and then handed out (loose); octants under the cutoff are subdivided serially
+		ARGUMENTS: MyTaskPool& a_Pool -> pool running the tasks
+		OUTPUT: ---
+		*/
+		void SubdivideParallel(MyTaskPool& a_Pool);
+		/*
+		USAGE: Takes a block of 8 octants from the node pool and sets them as the children
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void CreateChildren(void);
+		/*
+		USAGE: Adds the Entities in a range of the list of this octant that overlap the child
+		specified to its list (regular only)
+		ARGUMENTS:
+		- uint a_nChild -> index of the child
+		- uint a_uFirst -> first place of the range in the list
+		- uint a_uEnd -> place past the last one of the range
+		OUTPUT: ---
+		*/
+		void FillChild(uint a_nChild, uint a_uFirst, uint a_uEnd);
+		/*
+		USAGE: Moves each Entity in a range of the list of this octant to the child that can hold it,
+		the rest stay and are moved to the front of the list; the bounds of the Entities of this
+		octant start over at the start of the list and the list is cut to the ones that stay at
+		its end (loose only)
+		ARGUMENTS:
+		- uint a_uFirst -> first place of the range in the list
+		- uint a_uEnd -> place past the last one of the range
+		- uint& a_uStay -> Entities that stayed before the range, the ones of the range are added
+		OUTPUT: ---
+		*/
+		void HandDownLoose(uint a_uFirst, uint a_uEnd, uint& a_uStay);
+		/*
+		USAGE: Gives the octants below this one the IDs a serial build would have given them and
+		clears the lists of the branches of a regular octree, after a parallel build
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void NumberBranches(void);
+		/*
+		USAGE: Gets the child a box goes to on a loose octree: the one holding its center, as long
+		as the loose bounds of it hold the whole box
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box in global space
+		- vector3 const& a_v3Max -> maximum corner of the box in global space
+		OUTPUT: child, nullptr if the box stays in this octant
+		*/
+		MyOctant* GetLooseChild(vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Grows the bounds of the Entities stored in the octant and of its branch to hold the
+		Entity specified, RefitLooseBounds shrinks them when Entities leave (loose only)
+		ARGUMENTS: uint a_uIndex -> index of the Entity
+		OUTPUT: ---
+		*/
+		void ExpandEntityBounds(uint a_uIndex);
+		/*
+		USAGE: Grows the bounds of the branch to hold the Entity specified (loose only)
+		ARGUMENTS: uint a_uIndex -> index of the Entity
+		OUTPUT: ---
+		*/
+		void ExpandBranchBounds(uint a_uIndex);
+		/*
+		USAGE: Fits the bounds of the branch again to the Entities stored in the octant and the
+		branches of its children, after an Entity left it or a branch below it (loose only)
+		ARGUMENTS: bool a_bEntities -> fit the bounds of the Entities stored in the octant first, it
+		is the one the Entity left
+		OUTPUT: ---
+		*/
+		void RefitLooseBounds(bool a_bEntities);
+		/*
+		USAGE: Sets the dimensions of an Entity on a loose octree, replacing the ones it had (root only)
+		ARGUMENTS: uint a_uIndex -> index of the Entity
+		OUTPUT: ---
+		*/
+		void AssignLooseIDtoEntity(uint a_uIndex);
+		/*
+		USAGE: Adds the pairs the Entities of this leaf own and the pairs of the leafs below, the boxes
+		of each leaf are copied side by side and tested a few at a time
+		ARGUMENTS:
+		- std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		- MyBoxArray& a_Boxes -> room for the boxes of a leaf
+		- std::vector<uint>& a_lHit -> room for the boxes overlapping one, as many as Entities
+		OUTPUT: ---
+		*/
+		void GetLeafPairs(std::vector<std::pair<uint, uint>>& a_lOutput, MyBoxArray& a_Boxes, std::vector<uint>& a_lHit);
+		/*
+		USAGE: Adds the pairs of the Entities of the octant specified with the Entities of the octants
+		with the same or a larger ID in this octant and below it on a loose octree
+		ARGUMENTS:
+		- MyOctant* a_pOctant -> octant whose Entities are paired
+		- std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		- MyBoxArray& a_Boxes -> room for the boxes of an octant
+		- std::vector<uint>& a_lHit -> room for the boxes overlapping one, as many as Entities
+		OUTPUT: ---
+		*/
+		void GetLoosePairs(MyOctant* a_pOctant, std::vector<std::pair<uint, uint>>& a_lOutput, MyBoxArray& a_Boxes,
+			std::vector<uint>& a_lHit);
+		/*
+		USAGE: Adds the Entities of this octant and below it that are inside of the frustum
+		ARGUMENTS:
+		- vector4 const* a_pPlane -> the 6 planes of the frustum, pointing inwards
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetVisibleBranch(vector4 const* a_pPlane, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Tests the Entities of this octant against the ray and goes into the children it
+		hits from the nearest to the farthest
+		ARGUMENTS: RayQuery& a_Query -> ray and hits so far
+		OUTPUT: ---
+		*/
+		void CastRay(RayQuery& a_Query);
+		/*
+		USAGE: Sets up a query for the ray specified and runs it from the root when it hits it
+		ARGUMENTS:
+		- RayQuery& a_Query -> query to run, the hit fields are filled
+		- vector3 const& a_v3Origin -> start of the ray
+		- vector3 const& a_v3Direction -> direction of the ray, does not need to be normalized
+		- float a_fMaxDistance -> length of the segment
+		OUTPUT: ---
+		*/
+		void CastRay(RayQuery& a_Query, vector3 const& a_v3Origin, vector3 const& a_v3Direction, float a_fMaxDistance);
+		/*
+		USAGE: Records that the ray of a query hits an Entity: adds it to every hit once or keeps it
+		if it is the nearest so far
+		ARGUMENTS:
+		- RayQuery& a_Query -> ray and hits so far
+		- uint a_uEntity -> index of the Entity hit
+		- float a_fDistance -> distance the ray enters its box at
+		OUTPUT: ---
+		*/
+		void AddRayHit(RayQuery& a_Query, uint a_uEntity, float a_fDistance);
+		/*
+		USAGE: Starts a query that returns each Entity once, an Entity is returned already when its
+		stamp is the one of the query; the list grows with the Entities and is only cleared when the
+		stamps wrap around (root only)
+		ARGUMENTS: ---
+		OUTPUT: stamp of the query
+		*/
+		uint NextQueryStamp(void);
+		/*
+		USAGE: Adds the Entities of this octant and below it that overlap the box
+		ARGUMENTS:
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetInBoxBranch(vector3 const& a_v3Min, vector3 const& a_v3Max, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Adds the Entities of this octant and below it within the radius of the point
+		ARGUMENTS:
+		- vector3 const& a_v3Center -> center of the sphere
+		- float a_fRadiusSquared -> squared radius of the sphere
+		- std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetInSphereBranch(vector3 const& a_v3Center, float a_fRadiusSquared, std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Adds the Entities of this octant and below it nearer than the farthest found so far
+		to the heap of the ones found, children are visited from the nearest
+		ARGUMENTS:
+		- vector3 const& a_v3Point -> point
+		- uint a_uCount -> size of the heap once full
+		- std::vector<std::pair<float, uint>>& a_lOutput -> buffer holding the heap (squared distances)
+		- uint a_uFirst -> index in the buffer the heap starts at
+		OUTPUT: ---
+		*/
+		void GetNearestBranch(vector3 const& a_v3Point, uint a_uCount, std::vector<std::pair<float, uint>>& a_lOutput,
+			uint a_uFirst);
+		/*
+		USAGE: Adds an Entity to the heap of the nearest ones found, once the heap is full it takes
+		the place of the farthest if it is nearer
+		ARGUMENTS:
+		- std::pair<float, uint> const& a_Candidate -> squared distance and index of the Entity
+		- uint a_uCount -> size of the heap once full
+		- std::vector<std::pair<float, uint>>& a_lOutput -> buffer holding the heap
+		- uint a_uFirst -> index in the buffer the heap starts at
+		OUTPUT: ---
+		*/
+		static void PushNearest(std::pair<float, uint> const& a_Candidate, uint a_uCount,
+			std::vector<std::pair<float, uint>>& a_lOutput, uint a_uFirst);
+		/*
+		USAGE: Asks if this leaf is the one that reports an Entity found in more than one leaf of a
+		regular octree, the one holding the point specified of it (leafs hold their minimum faces,
+		the root holds all of its faces and the points past them)
+		ARGUMENTS: vector3 const& a_v3Point -> point inside of the Entity and the query
+		OUTPUT: does it report it?
+		*/
+		bool IsOwner(vector3 const& a_v3Point);
+		/*
+		USAGE: Adds the Entities of this octant and below it without testing them, the ones in the
+		outside list are left to the caller
+		ARGUMENTS: std::vector<uint>& a_lOutput -> list the Entity indices are appended to
+		OUTPUT: ---
+		*/
+		void GetBranchEntities(std::vector<uint>& a_lOutput);
+		/*
+		USAGE: Asks if the box of an Entity left the root, the octants hold it clamped so the queries
+		test it from the outside list
+		ARGUMENTS: uint a_uIndex -> index of the Entity
+		OUTPUT: is it in the outside list?
+		*/
+		bool IsOutside(uint a_uIndex);
+		/*
+		USAGE: Adds an Entity to the outside list, moves it there or takes it out of it (root only)
+		ARGUMENTS:
+		- uint a_uIndex -> index of the Entity
+		- bool a_bOutside -> did its box leave the root?
+		- vector3 const& a_v3Min -> minimum corner of the box, not clamped
+		- vector3 const& a_v3Max -> maximum corner of the box, not clamped
+		OUTPUT: ---
+		*/
+		void SetOutside(uint a_uIndex, bool a_bOutside, vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Asks where a box is from the frustum
+		ARGUMENTS:
+		- vector4 const* a_pPlane -> the 6 planes of the frustum, pointing inwards
+		- vector3 const& a_v3Min -> minimum corner of the box
+		- vector3 const& a_v3Max -> maximum corner of the box
+		OUTPUT: -1 outside, 0 crossing a plane, 1 inside
+		*/
+		static int ClassifyBox(vector4 const* a_pPlane, vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Asks if two boxes overlap
+		ARGUMENTS:
+		- vector3 const& a_v3MinA -> minimum corner of the first box
+		- vector3 const& a_v3MaxA -> maximum corner of the first box
+		- vector3 const& a_v3MinB -> minimum corner of the second box
+		- vector3 const& a_v3MaxB -> maximum corner of the second box
+		OUTPUT: do they overlap?
+		*/
+		static bool IsOverlapping(vector3 const& a_v3MinA, vector3 const& a_v3MaxA,
+			vector3 const& a_v3MinB, vector3 const& a_v3MaxB);
+		/*
+		USAGE: Adds the Entity to the leafs under this octant it overlaps, subdividing full leafs
+		ARGUMENTS:
+		- uint a_uIndex -> index of the Entity
+		- vector3 const& a_v3Min -> minimum corner in global space
+		- vector3 const& a_v3Max -> maximum corner in global space
+		OUTPUT: ---
+		*/
+		void InsertEntity(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max);
+		/*
+		USAGE: Removes the Entity from the leafs under this octant it overlaps, merging branches
+		that no longer hold more than the ideal count
+		ARGUMENTS:
+		- uint a_uIndex -> index of the Entity
+		- vector3 const& a_v3Min -> minimum corner it was inserted with
+		- vector3 const& a_v3Max -> maximum corner it was inserted with
+		- bool a_bGone = false -> the Entity Manager no longer has it: its dimensions are left alone
+		and no branch is merged
+		OUTPUT: ---
+		*/
+		void RemoveEntity(uint a_uIndex, vector3 const& a_v3Min, vector3 const& a_v3Max, bool a_bGone = false);
+		/*
+		USAGE: Takes the Entities from the count given on out of the tree and the snapshot, the
+		Entity Manager removed them (root only)
+		ARGUMENTS: uint a_uCount -> number of Entities the Entity Manager has
+		OUTPUT: ---
+		*/
+		void DropEntities(uint a_uCount);
+		/*
+		USAGE: Turns this octant back into a leaf if all of its children are leafs and together
+		(with this octant on a loose octree) they do not hold more than the ideal count
+		ARGUMENTS: ---
+		OUTPUT: merged?
+		*/
+		bool TryMerge(void);
+		/*
+		USAGE: Traverse the tree up to the leafs and removes their ID from the objects in them
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void RemoveIDfromEntity(void);
+		/*
+		USAGE: Sets a pooled octant as a new empty octant, its Entity list keeps its memory
+		ARGUMENTS:
+		- vector3 a_v3Center -> Center of the octant in global space
+		- float a_fSize -> size of each side of the octant volume
+		OUTPUT: ---
+		*/
+		void Reset(vector3 a_v3Center, float a_fSize);
+		/*
+		USAGE: Hands out 8 contiguous octants, reusing the blocks of earlier builds before
+		allocating a new chunk (root only)
+		ARGUMENTS: ---
+		OUTPUT: first octant of the block
+		*/
+		MyOctant* AcquireBlock(void);
+		/*
+		USAGE: Gets a block of the node pool by index (root only)
+		ARGUMENTS: uint a_uBlock -> index of the block
+		OUTPUT: first octant of the block
+		*/
+		MyOctant* GetPoolBlock(uint a_uBlock);
+		/*
+		USAGE: Destroys every octant in the node pool and frees its memory (root only)
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void ReleasePool(void);
 		/*
 		USAGE: Deallocates member fields
 		ARGUMENTS: ---
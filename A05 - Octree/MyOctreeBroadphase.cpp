@@ -0,0 +1,76 @@
+#include "MyOctreeBroadphase.h"
+using namespace Simplex;
+
+MyOctreeBroadphase::MyOctreeBroadphase(eBROADPHASE a_eType) { m_eType = a_eType; }
+
+MyOctreeBroadphase::~MyOctreeBroadphase(void)
+{
+	SafeDelete(m_pTree);
+	SafeDelete(m_pLinearTree);
+}
+
+String MyOctreeBroadphase::GetName(void) { return GetTypeName(m_eType); }
+
+void MyOctreeBroadphase::Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	SafeDelete(m_pTree);
+	SafeDelete(m_pLinearTree);
+
+	//one level more for every 8 times the ideal count
+	uint nEntities = a_lMin.size();
+	uint uLevels = 0;
+	for (uint uLeafs = 1; uLeafs * m_uIdealCount < nEntities && uLevels < 7; uLeafs *= 8)
+	{
+		uLevels++;
+	}
+
+	if (m_eType == BROADPHASE_LINEAR_OCTREE)
+		m_pLinearTree = new MyLinearOctree(a_lMin, a_lMax, uLevels, m_uIdealCount);
+	else
+		m_pTree = new MyOctant(a_lMin, a_lMax, uLevels, m_uIdealCount,
+			m_eType == BROADPHASE_LOOSE_OCTREE ? m_fLooseness : 0.0f);
+}
+
+void MyOctreeBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& a_lMoved)
+{
+	//the linear octree has no update, and past half of the boxes a new tree is cheaper than the moves
+	uint nMoved = a_lMoved.size();
+	if (m_pTree == nullptr || nMoved * 2 > a_lMin.size())
+	{
+		if (nMoved > 0 || (m_pTree == nullptr && m_pLinearTree == nullptr))
+			Build(a_lMin, a_lMax);
+		return;
+	}
+
+	//the tree clamps boxes to the root, two boxes clamped against the same side could give a
+	//pair that does not overlap, a box leaving the root gets a new root instead
+	vector3 v3Min = m_pTree->GetMinGlobal();
+	vector3 v3Max = m_pTree->GetMaxGlobal();
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = a_lMoved[i];
+		for (uint k = 0; k < 3; k++)
+		{
+			if (a_lMin[uEntity][k] < v3Min[k] || a_lMax[uEntity][k] > v3Max[k])
+			{
+				Build(a_lMin, a_lMax);
+				return;
+			}
+		}
+	}
+
+	for (uint i = 0; i < nMoved; i++)
+	{
+		uint uEntity = a_lMoved[i];
+		m_pTree->UpdateEntity(uEntity, a_lMin[uEntity], a_lMax[uEntity]);
+	}
+}
+
+void MyOctreeBroadphase::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	if (m_pTree != nullptr)
+		m_pTree->GetPairs(a_lOutput);
+	else if (m_pLinearTree != nullptr)
+		m_pLinearTree->GetPairs(a_lOutput);
+}
@@ -0,0 +1,82 @@
+#ifndef __MYOCTREEBROADPHASECLASS_H_
+#define __MYOCTREEBROADPHASECLASS_H_
+
+#include "MyBroadphase.h"
+#include "MyOctant.h"
+#include "MyLinearOctree.h"
+
+namespace Simplex
+{
+
+	//System Class
+	class MyOctreeBroadphase : public MyBroadphase
+	{
+		eBROADPHASE m_eType = BROADPHASE_OCTREE; //regular, loose or linear octree
+		uint m_uIdealCount = 5; //ideal number of Entities per octant
+		float m_fLooseness = 2.0f; //size of the loose bounds over the octant size (loose only)
+		MyOctant* m_pTree = nullptr; //pointer octree, not linked to the Entity Manager (regular and loose)
+		MyLinearOctree* m_pLinearTree = nullptr; //linear octree (linear only)
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: eBROADPHASE a_eType -> BROADPHASE_OCTREE, BROADPHASE_LOOSE_OCTREE or BROADPHASE_LINEAR_OCTREE
+		OUTPUT: class object
+		*/
+		MyOctreeBroadphase(eBROADPHASE a_eType);
+		/*
+		USAGE: Destructor
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyOctreeBroadphase(void);
+		/*
+		USAGE: Gets the name of the broadphase
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		String GetName(void) override;
+		/*
+		USAGE: Builds the octree around the boxes, deep enough for leafs of about the ideal count
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) override;
+		/*
+		USAGE: Moves the boxes through the pointer octree one by one, unless most of them moved or
+		one left the root; the linear octree is built again
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new
+		OUTPUT: ---
+		*/
+		void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved) override;
+		/*
+		USAGE: Gets the pairs the octree finds
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) override;
+
+	private:
+		/*
+		USAGE: Copy Constructor, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyOctreeBroadphase(MyOctreeBroadphase const& other);
+		/*
+		USAGE: Copy Assignment Operator, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyOctreeBroadphase& operator=(MyOctreeBroadphase const& other);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYOCTREEBROADPHASECLASS_H_
@@ -0,0 +1,154 @@
+#include "MyOctreeBuilder.h"
+using namespace Simplex;
+
+MyOctreeBuilder::MyOctreeBuilder(void) : m_bDone(false) {}
+
+MyOctreeBuilder::~MyOctreeBuilder(void)
+{
+	//a sliced build is just dropped
+	if (m_Thread.joinable())
+		m_Thread.join();
+	SafeDelete(m_pTree);
+}
+
+void MyOctreeBuilder::Start(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness)
+{
+	m_uMaxLevel = a_nMaxLevel;
+	m_uIdealCount = a_nIdealEntityCount;
+	m_fLooseness = a_fLooseness;
+	m_bPending = true;
+
+	//a sliced build has nothing running in the background, it is dropped right away
+	if (m_bBuilding && m_dRunningSliceMs > 0.0)
+	{
+		SafeDelete(m_pTree);
+		m_bBuilding = false;
+	}
+
+	//the boxes in use belong to the running thread, the new build starts once it is done
+	if (m_bBuilding)
+	{
+		m_bDiscard = true;
+		return;
+	}
+
+	Launch();
+}
+
+void MyOctreeBuilder::Cancel(void)
+{
+	m_bPending = false;
+	if (m_bBuilding && m_dRunningSliceMs > 0.0)
+	{
+		SafeDelete(m_pTree);
+		m_bBuilding = false;
+	}
+	else if (m_bBuilding)
+		m_bDiscard = true;
+}
+
+bool MyOctreeBuilder::IsBuilding(void) { return m_bBuilding; }
+
+void MyOctreeBuilder::SetSliceMs(double a_dSliceMs) { m_dSliceMs = std::max(a_dSliceMs, 0.0); }
+
+double MyOctreeBuilder::GetSliceMs(void) { return m_dSliceMs; }
+
+void MyOctreeBuilder::SetBuildThreads(uint a_uThreadCount, uint a_uCutoff)
+{
+	m_uThreadCount = a_uThreadCount;
+	m_uParallelCutoff = std::max(a_uCutoff, 1u);
+}
+
+void MyOctreeBuilder::Wait(void)
+{
+	if (m_Thread.joinable())
+		m_Thread.join();
+
+	if (m_dRunningSliceMs > 0.0 && m_pTree != nullptr)
+		m_pTree->ContinueBuild(DBL_MAX);
+}
+
+MyOctant* MyOctreeBuilder::TakeTree(MyOctant* a_pInUse)
+{
+	if (!m_bBuilding)
+		return nullptr;
+
+	//a tree built on the thread is linked here once the thread is done
+	if (m_dRunningSliceMs == 0.0 && !m_bDone.load(std::memory_order_acquire))
+		return nullptr;
+	if (m_Thread.joinable())
+		m_Thread.join();
+
+	if (m_bDiscard)
+	{
+		m_bDiscard = false;
+		m_bBuilding = false;
+		SafeDelete(m_pTree);
+		if (m_bPending)
+			Launch();
+		return nullptr;
+	}
+
+	//the link starts once the build is done, it writes the dimensions the tree in use gives up
+	double dSliceMs = m_dRunningSliceMs > 0.0 ? m_dRunningSliceMs : m_dLinkMs;
+	if (m_pTree->IsBuilding())
+	{
+		m_pTree->ContinueBuild(dSliceMs);
+		return nullptr;
+	}
+	if (a_pInUse != nullptr)
+		a_pInUse->ReleaseDimensions();
+	if (!m_pTree->ContinueLink(dSliceMs))
+		return nullptr;
+
+	m_bBuilding = false;
+	MyOctant* pTree = m_pTree;
+	m_pTree = nullptr;
+
+	if (m_bPending)
+		Launch();
+
+	return pTree;
+}
+
+void MyOctreeBuilder::Launch(void)
+{
+	m_bPending = false;
+
+	m_bBuilding = true;
+	m_bDone.store(false, std::memory_order_relaxed);
+
+	//a sliced build only sets the tree up here, it takes the boxes in the slices of TakeTree
+	m_dRunningSliceMs = m_dSliceMs;
+	if (m_dRunningSliceMs > 0.0)
+	{
+		m_pTree = new MyOctant(m_uMaxLevel, m_uIdealCount, m_fLooseness, true);
+		return;
+	}
+
+	//the boxes are taken here, the thread never touches the Entity Manager
+	MyEntityManager* pEntityMngr = MyEntityManager::GetInstance();
+	uint nObjects = pEntityMngr->GetEntityCount();
+	m_lEntityMin.resize(nObjects);
+	m_lEntityMax.resize(nObjects);
+	for (uint i = 0; i < nObjects; i++)
+	{
+		MyRigidBody* pRigidBody = pEntityMngr->GetEntity(i)->GetRigidBody();
+		m_lEntityMin[i] = pRigidBody->GetMinGlobal();
+		m_lEntityMax[i] = pRigidBody->GetMaxGlobal();
+	}
+
+	uint uMaxLevel = m_uMaxLevel;
+	uint uIdealCount = m_uIdealCount;
+	float fLooseness = m_fLooseness;
+	uint uThreadCount = m_uThreadCount;
+	uint uCutoff = m_uParallelCutoff;
+	m_Thread = std::thread([this, uMaxLevel, uIdealCount, fLooseness, uThreadCount, uCutoff]
+	{
+		MyOctant* pTree = new MyOctant(m_lEntityMin, m_lEntityMax, uMaxLevel, uIdealCount, fLooseness, false,
+			uThreadCount, uCutoff);
+		pTree->PrepareLink();
+		m_pTree = pTree;
+		m_bDone.store(true, std::memory_order_release);
+	});
+}
@@ -0,0 +1,132 @@
+#ifndef __MYOCTREEBUILDERCLASS_H_
+#define __MYOCTREEBUILDERCLASS_H_
+
+#include "MyOctant.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyOctreeBuilder
+	{
+		std::thread m_Thread; //thread building the tree
+		std::atomic<bool> m_bDone; //has the thread finished the tree
+		bool m_bBuilding = false; //was a build started and not taken yet
+		double m_dSliceMs = 0.0; //milliseconds of each slice of the next build, 0 builds on the thread
+		double m_dRunningSliceMs = 0.0; //milliseconds of each slice of the build running, 0 if it is on the thread
+		double m_dLinkMs = 2.0; //milliseconds of each slice of the link of a tree built on the thread
+		MyOctant* m_pTree = nullptr; //tree built by the thread, owned by the builder until taken
+
+		std::vector<vector3> m_lEntityMin; //minimum corner of every Entity when the build on the thread started
+		std::vector<vector3> m_lEntityMax; //maximum corner of every Entity when the build on the thread started
+
+		bool m_bPending = false; //was a build asked for while another one was running
+		bool m_bDiscard = false; //is the tree being built out of date
+		uint m_uMaxLevel = 0; //maximum level of the pending build
+		uint m_uIdealCount = 0; //ideal count of the pending build
+		float m_fLooseness = 0.0f; //looseness of the pending build
+		uint m_uThreadCount = 1; //threads building each tree on the thread, 0 for one per core and 1 for a serial build
+		uint m_uParallelCutoff = 4096; //octants holding less Entities than this are not split in tasks
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: ---
+		OUTPUT: class object
+		*/
+		MyOctreeBuilder(void);
+		/*
+		USAGE: Destructor, waits for the build running and deletes any tree not taken
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyOctreeBuilder(void);
+		/*
+		USAGE: Takes the bounding boxes of the Entities and builds a tree with them on another thread
+		or a slice at a time; while a build is running on the thread the new one waits for it and the
+		running one is thrown away, a sliced one is dropped at once
+		ARGUMENTS:
+		- uint a_nMaxLevel -> maximum level of subdivision
+		- uint a_nIdealEntityCount -> ideal number of Entities per octant
+		- float a_fLooseness = 0.0f -> size of the loose bounds over the octant size, 0 for a regular octree
+		OUTPUT: ---
+		*/
+		void Start(uint a_nMaxLevel, uint a_nIdealEntityCount, float a_fLooseness = 0.0f);
+		/*
+		USAGE: Sets how the next builds run: on another thread, or on the calling thread a slice at a
+		time with each TakeTree working for the milliseconds given (for machines with a single core)
+		ARGUMENTS: double a_dSliceMs -> milliseconds of work per TakeTree, 0 to build on another thread
+		OUTPUT: ---
+		*/
+		void SetSliceMs(double a_dSliceMs);
+		/*
+		USAGE: Gets the milliseconds of work per TakeTree
+		ARGUMENTS: ---
+		OUTPUT: milliseconds, 0 when building on another thread
+		*/
+		double GetSliceMs(void);
+		/*
+		USAGE: Sets how many threads build the trees started from now on, each build takes a copy of
+		them when it starts so the one running is not affected (a sliced build is always serial)
+		ARGUMENTS:
+		- uint a_uThreadCount -> threads, 0 for one per core and 1 for a serial build
+		- uint a_uCutoff = 4096 -> octants holding less Entities than this are not split in tasks
+		OUTPUT: ---
+		*/
+		void SetBuildThreads(uint a_uThreadCount, uint a_uCutoff = 4096);
+		/*
+		USAGE: Throws away the build running and the one waiting, used when the tree is rebuilt some other way
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Cancel(void);
+		/*
+		USAGE: Asks if a build is running or waiting to be taken
+		ARGUMENTS: ---
+		OUTPUT: is it building?
+		*/
+		bool IsBuilding(void);
+		/*
+		USAGE: Blocks until the build running is done, TakeTree links it after
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Wait(void);
+		/*
+		USAGE: Works on the tree for a slice and gets it once it is built and linked to the Entity
+		Manager, the caller owns it from then on and it replaces the tree in use right away. A sliced
+		build takes its slices of the build first; once the tree is built every call links a slice of
+		it, the tree in use gives up its dimensions for the link. Has to be called every frame before
+		the tree in use is updated
+		ARGUMENTS: MyOctant* a_pInUse -> tree in use, nullptr if there is none
+		OUTPUT: finished tree, nullptr while it is running or if nothing was started
+		*/
+		MyOctant* TakeTree(MyOctant* a_pInUse);
+
+	private:
+		/*
+		USAGE: Copy Constructor, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyOctreeBuilder(MyOctreeBuilder const& other);
+		/*
+		USAGE: Copy Assignment Operator, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyOctreeBuilder& operator=(MyOctreeBuilder const& other);
+		/*
+		USAGE: Takes the bounding boxes and starts the thread with the parameters of the pending build
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Launch(void);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYOCTREEBUILDERCLASS_H_
@@ -0,0 +1,93 @@
+#include "MyOctreeTuner.h"
+using namespace Simplex;
+
+MyOctreeTuner::MyOctreeTuner(uint a_uMaxLevel, uint a_uIdealCount)
+{
+	m_uMaxLevel = a_uMaxLevel;
+	m_uIdealCount = a_uIdealCount;
+}
+
+void MyOctreeTuner::Start(uint a_uEntityCount, uint a_uLevelLimit, uint a_uFrameCount)
+{
+	const uint lIdealCount[] = { 2, 5, 10, 20 };
+
+	//past the level where each leaf would hold a single entity the tree only gets slower
+	uint uLevels = 0;
+	for (uint uLeafs = 1; uLeafs < a_uEntityCount && uLevels < a_uLevelLimit; uLeafs *= 8)
+	{
+		uLevels++;
+	}
+	uLevels = std::min(uLevels + 1, a_uLevelLimit);
+
+	m_lCandidate.clear();
+	for (uint uLevel = 0; uLevel <= uLevels; uLevel++)
+	{
+		for (uint uIdeal : lIdealCount)
+		{
+			Candidate candidate;
+			candidate.uMaxLevel = uLevel;
+			candidate.uIdealCount = uIdeal;
+			m_lCandidate.push_back(candidate);
+
+			//the root never subdivides at level 0, the ideal count does not matter
+			if (uLevel == 0) break;
+		}
+	}
+
+	m_uFrameCount = std::max(a_uFrameCount, 1u);
+	m_uCurrent = 0;
+	m_uFrame = 0;
+	m_bRunning = true;
+}
+
+bool MyOctreeTuner::IsRunning(void) { return m_bRunning; }
+
+void MyOctreeTuner::Stop(void)
+{
+	//the candidates measured so far are not comparable with the ones left, drop them
+	m_bRunning = false;
+	m_lCandidate.clear();
+}
+
+bool MyOctreeTuner::IsNewCandidate(void) { return m_bRunning && m_uFrame == 0; }
+
+void MyOctreeTuner::AddFrame(double a_dBuildMs, double a_dBroadphaseMs)
+{
+	if (!m_bRunning) return;
+
+	Candidate& candidate = m_lCandidate[m_uCurrent];
+	candidate.dBuildMs += a_dBuildMs;
+	candidate.dBroadphaseMs += a_dBroadphaseMs;
+	if (++m_uFrame < m_uFrameCount) return;
+
+	m_uFrame = 0;
+	if (++m_uCurrent < m_lCandidate.size()) return;
+
+	//every candidate is measured, keep the cheapest frame
+	m_bRunning = false;
+	double dBest = DBL_MAX;
+	for (uint i = 0; i < m_lCandidate.size(); i++)
+	{
+		double dCost = m_lCandidate[i].dBuildMs + m_lCandidate[i].dBroadphaseMs;
+		if (dCost < dBest)
+		{
+			dBest = dCost;
+			m_uMaxLevel = m_lCandidate[i].uMaxLevel;
+			m_uIdealCount = m_lCandidate[i].uIdealCount;
+			m_dBuildMs = m_lCandidate[i].dBuildMs / m_uFrameCount;
+			m_dBroadphaseMs = m_lCandidate[i].dBroadphaseMs / m_uFrameCount;
+		}
+	}
+}
+
+uint MyOctreeTuner::GetMaxLevel(void) { return m_bRunning ? m_lCandidate[m_uCurrent].uMaxLevel : m_uMaxLevel; }
+
+uint MyOctreeTuner::GetIdealCount(void) { return m_bRunning ? m_lCandidate[m_uCurrent].uIdealCount : m_uIdealCount; }
+
+double MyOctreeTuner::GetBuildMs(void) { return m_dBuildMs; }
+
+double MyOctreeTuner::GetBroadphaseMs(void) { return m_dBroadphaseMs; }
+
+uint MyOctreeTuner::GetCandidate(void) { return m_uCurrent; }
+
+uint MyOctreeTuner::GetCandidateCount(void) { return m_lCandidate.size(); }
@@ -0,0 +1,122 @@
+#ifndef __MYOCTREETUNERCLASS_H_
+#define __MYOCTREETUNERCLASS_H_
+
+#include "Simplex\Simplex.h"
+
+#include <cfloat>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyOctreeTuner
+	{
+		//Parameters of the octree tried by the tuner
+		struct Candidate
+		{
+			uint uMaxLevel = 0; //maximum level of subdivision
+			uint uIdealCount = 0; //ideal number of Entities per octant
+			double dBuildMs = 0.0; //build time added over the frames measured
+			double dBroadphaseMs = 0.0; //broadphase time added over the frames measured
+		};
+
+		uint m_uFrameCount = 5; //frames each candidate is measured for
+		std::vector<Candidate> m_lCandidate; //parameters to try
+		uint m_uCurrent = 0; //candidate being measured
+		uint m_uFrame = 0; //frames the current candidate has been measured for
+		bool m_bRunning = false; //is the tuner measuring
+
+		uint m_uMaxLevel = 1; //chosen maximum level
+		uint m_uIdealCount = 5; //chosen ideal count
+		double m_dBuildMs = 0.0; //average build time of the chosen parameters
+		double m_dBroadphaseMs = 0.0; //average broadphase time of the chosen parameters
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS:
+		- uint a_uMaxLevel = 1 -> maximum level used until something is tuned
+		- uint a_uIdealCount = 5 -> ideal count used until something is tuned
+		OUTPUT: class object
+		*/
+		MyOctreeTuner(uint a_uMaxLevel = 1, uint a_uIdealCount = 5);
+		/*
+		USAGE: Starts measuring, every max level up to one past the depth where leafs would hold a
+		single Entity is tried with a few ideal counts
+		ARGUMENTS:
+		- uint a_uEntityCount -> number of Entities the octree holds
+		- uint a_uLevelLimit -> deepest level the octree can go to
+		- uint a_uFrameCount = 5 -> frames each candidate is measured for
+		OUTPUT: ---
+		*/
+		void Start(uint a_uEntityCount, uint a_uLevelLimit, uint a_uFrameCount = 5);
+		/*
+		USAGE: Asks if the tuner is measuring, the octree has to be built with GetMaxLevel and
+		GetIdealCount each time IsNewCandidate says so while it does
+		ARGUMENTS: ---
+		OUTPUT: is it running?
+		*/
+		bool IsRunning(void);
+		/*
+		USAGE: Stops measuring without choosing, the parameters chosen last are kept
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Stop(void);
+		/*
+		USAGE: Asks if no frame of the current candidate has been measured yet, the octree has to be
+		built with it once before its frames are added, outside the time measured
+		ARGUMENTS: ---
+		OUTPUT: is the candidate new?
+		*/
+		bool IsNewCandidate(void);
+		/*
+		USAGE: Adds the times of a frame updated with the current candidate, once the candidate has
+		been measured for enough frames the next one is set, after the last one the cheapest is chosen
+		ARGUMENTS:
+		- double a_dBuildMs -> time updating the octree
+		- double a_dBroadphaseMs -> time finding and checking the pairs
+		OUTPUT: ---
+		*/
+		void AddFrame(double a_dBuildMs, double a_dBroadphaseMs);
+		/*
+		USAGE: Gets the maximum level to build with, the candidate while running or else the chosen one
+		ARGUMENTS: ---
+		OUTPUT: maximum level
+		*/
+		uint GetMaxLevel(void);
+		/*
+		USAGE: Gets the ideal count to build with, the candidate while running or else the chosen one
+		ARGUMENTS: ---
+		OUTPUT: ideal count
+		*/
+		uint GetIdealCount(void);
+		/*
+		USAGE: Gets the average build time of the chosen parameters
+		ARGUMENTS: ---
+		OUTPUT: milliseconds
+		*/
+		double GetBuildMs(void);
+		/*
+		USAGE: Gets the average broadphase time of the chosen parameters
+		ARGUMENTS: ---
+		OUTPUT: milliseconds
+		*/
+		double GetBroadphaseMs(void);
+		/*
+		USAGE: Gets the candidate being measured
+		ARGUMENTS: ---
+		OUTPUT: index of the candidate
+		*/
+		uint GetCandidate(void);
+		/*
+		USAGE: Gets the number of candidates tried
+		ARGUMENTS: ---
+		OUTPUT: candidate count
+		*/
+		uint GetCandidateCount(void);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYOCTREETUNERCLASS_H_
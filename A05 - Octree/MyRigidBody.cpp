@@ -28,6 +28,7 @@ void MyRigidBody::Init(void)
 
 	m_nCollidingCount = 0;
 	m_CollidingArray = nullptr;
+	m_lCollidingList.clear();
 }
 void MyRigidBody::Swap(MyRigidBody& other)
 {
@@ -56,6 +57,8 @@ void MyRigidBody::Swap(MyRigidBody& other)
 
 	std::swap(m_nCollidingCount, other.m_nCollidingCount);
 	std::swap(m_CollidingArray, other.m_CollidingArray);
+	//the storage of the lists changes hands with them, the pointers into them stay right
+	std::swap(m_lCollidingList, other.m_lCollidingList);
 }
 void MyRigidBody::Release(void)
 {
@@ -172,6 +175,20 @@ MyRigidBody::MyRigidBody(std::vector<vector3> a_pointList)
 	//Get the distance between the center and either the min or the max
 	m_fRadius = glm::distance(m_v3CenterL, m_v3MinL);
 }
+MyRigidBody::MyRigidBody(MyRigidBody* const a_pShape)
+{
+	Init();
+	m_v3MinL = a_pShape->m_v3MinL;
+	m_v3MaxL = a_pShape->m_v3MaxL;
+	m_v3CenterL = a_pShape->m_v3CenterL;
+	m_v3HalfWidth = a_pShape->m_v3HalfWidth;
+	m_fRadius = a_pShape->m_fRadius;
+
+	//with model matrix being the identity, local and global are the same
+	m_v3MinG = m_v3MinL;
+	m_v3MaxG = m_v3MaxL;
+	m_v3CenterG = m_v3CenterL;
+}
 MyRigidBody::MyRigidBody(MyRigidBody const& other)
 {
 	m_pMeshMngr = other.m_pMeshMngr;
@@ -199,7 +216,12 @@ MyRigidBody::MyRigidBody(MyRigidBody const& other)
 	m_m4ToWorld = other.m_m4ToWorld;
 
 	m_nCollidingCount = other.m_nCollidingCount;
-	m_CollidingArray = other.m_CollidingArray;
+	m_lCollidingList = other.m_lCollidingList;
+	//a view is shared, an own list is the copy
+	if (other.m_nCollidingCount > 0 && other.m_CollidingArray == other.m_lCollidingList.data())
+		m_CollidingArray = m_lCollidingList.data();
+	else
+		m_CollidingArray = other.m_CollidingArray;
 }
 MyRigidBody& MyRigidBody::operator=(MyRigidBody const& other)
 {
@@ -219,22 +241,14 @@ void MyRigidBody::AddCollisionWith(MyRigidBody* other)
 	//if its already in the list return
 	if (IsInCollidingArray(other))
 		return;
-	/*
-		check if the object is already in the colliding set, if
-		the object is already there return with no changes
-	*/
 
-	//insert the entry
-	PRigidBody* pTemp;
-	pTemp = new PRigidBody[m_nCollidingCount + 1];
-	if (m_CollidingArray)
-	{
-		memcpy(pTemp, m_CollidingArray, sizeof(MyRigidBody*) * m_nCollidingCount);
-		delete[] m_CollidingArray;
-		m_CollidingArray = nullptr;
-	}
-	pTemp[m_nCollidingCount] = other;
-	m_CollidingArray = pTemp;
+	//a view is copied before it is changed
+	if (m_CollidingArray != m_lCollidingList.data())
+		m_lCollidingList.assign(m_CollidingArray, m_CollidingArray + m_nCollidingCount);
+
+	//insert the entry, the list doubles when full
+	m_lCollidingList.push_back(other);
+	m_CollidingArray = m_lCollidingList.data();
 
 	++m_nCollidingCount;
 }
@@ -249,31 +263,32 @@ void MyRigidBody::RemoveCollisionWith(MyRigidBody* other)
 	{
 		if (m_CollidingArray[i] == other)
 		{
+			//a view is copied before it is changed
+			if (m_CollidingArray != m_lCollidingList.data())
+				m_lCollidingList.assign(m_CollidingArray, m_CollidingArray + m_nCollidingCount);
+
 			//if it is, then we swap it with the last one and then we pop
-			std::swap(m_CollidingArray[i], m_CollidingArray[m_nCollidingCount - 1]);
-			PRigidBody* pTemp;
-			pTemp = new PRigidBody[m_nCollidingCount - 1];
-			if (m_CollidingArray)
-			{
-				memcpy(pTemp, m_CollidingArray, sizeof(uint) * (m_nCollidingCount - 1));
-				delete[] m_CollidingArray;
-				m_CollidingArray = nullptr;
-			}
-			m_CollidingArray = pTemp;
+			std::swap(m_lCollidingList[i], m_lCollidingList.back());
+			m_lCollidingList.pop_back();
+			m_CollidingArray = m_lCollidingList.data();
 
 			--m_nCollidingCount;
 			return;
 		}
 	}
 }
+void MyRigidBody::SetCollidingView(PRigidBody const* a_pList, uint a_uCount)
+{
+	m_lCollidingList.clear();
+	m_CollidingArray = a_pList;
+	m_nCollidingCount = a_uCount;
+}
 void MyRigidBody::ClearCollidingList(void)
 {
+	//the room of the list is kept for the next collisions
 	m_nCollidingCount = 0;
-	if (m_CollidingArray)
-	{
-		delete[] m_CollidingArray;
-		m_CollidingArray = nullptr;
-	}
+	m_CollidingArray = nullptr;
+	m_lCollidingList.clear();
 }
 uint MyRigidBody::SAT(MyRigidBody* const a_pOther)
 {
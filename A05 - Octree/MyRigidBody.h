@@ -40,7 +40,8 @@ class MyRigidBody
 	matrix4 m_m4ToWorld = IDENTITY_M4; //Matrix that will take us from local to world coordinate
 
 	uint m_nCollidingCount = 0; //size of the colliding set
-	PRigidBody* m_CollidingArray = nullptr; //array of rigid bodies this one is colliding with
+	PRigidBody const* m_CollidingArray = nullptr; //rigid bodies this one is colliding with, its own list or a view of the contacts of the Entity Manager
+	std::vector<PRigidBody> m_lCollidingList; //collisions added one at a time, the room is kept when cleared
 
 public:
 	/*
@@ -50,6 +51,13 @@ public:
 	*/
 	MyRigidBody(std::vector<vector3> a_pointList);
 	/*
+	Usage: Constructor that takes the local space box and sphere of another Rigid Body instead of
+	going through the points of a model again, nothing else is taken
+	Arguments: MyRigidBody* const a_pShape -> Rigid Body with the shape
+	Output: class object instance
+	*/
+	MyRigidBody(MyRigidBody* const a_pShape);
+	/*
 	Usage: Copy Constructor
 	Arguments: class object to copy
 	Output: class object instance
@@ -102,6 +110,17 @@ public:
 	*/
 	void RemoveCollisionWith(MyRigidBody* other);
 
+	/*
+	USAGE: Makes the colliding list a view of a list kept by someone else, it is not copied; the
+	collisions added one at a time are cleared
+	ARGUMENTS:
+	-	PRigidBody const* a_pList -> rigid bodies this one is colliding with, valid until the list is
+		cleared or set again
+	-	uint a_uCount -> number of rigid bodies in the list
+	OUTPUT: ---
+	*/
+	void SetCollidingView(PRigidBody const* a_pList, uint a_uCount);
+
 	/*
 	USAGE: Tells if the object is colliding with the incoming one
 	ARGUMENTS: MyRigidBody* const other -> inspected rigid body
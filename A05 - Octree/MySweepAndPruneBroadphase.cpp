@@ -0,0 +1,212 @@
+#include "MySweepAndPruneBroadphase.h"
+using namespace Simplex;
+
+namespace
+{
+	//on the same value the minimum goes first, boxes that touch overlap
+	template <class T>
+	bool IsBefore(T const& a_A, T const& a_B)
+	{
+		return a_A.fValue < a_B.fValue || (a_A.fValue == a_B.fValue && (a_A.uData & 1) < (a_B.uData & 1));
+	}
+
+	uint64_t PairKey(uint a_uA, uint a_uB)
+	{
+		if (a_uA > a_uB) std::swap(a_uA, a_uB);
+		return (static_cast<uint64_t>(a_uA) << 32) | a_uB;
+	}
+}
+
+MySweepAndPruneBroadphase::MySweepAndPruneBroadphase(uint a_uAxisCount)
+{
+	m_uAxisCount = a_uAxisCount < 3 ? 1 : 3;
+}
+
+String MySweepAndPruneBroadphase::GetName(void)
+{
+	return GetTypeName(m_uAxisCount == 1 ? BROADPHASE_SAP_X : BROADPHASE_SAP);
+}
+
+void MySweepAndPruneBroadphase::Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	m_uEntityCount = 0;
+	for (uint uAxis = 0; uAxis < 3; uAxis++)
+		m_lAxis[uAxis].clear();
+	SetEndpoints(a_lMin, a_lMax);
+	for (uint uAxis = 0; uAxis < m_uAxisCount; uAxis++)
+		std::sort(m_lAxis[uAxis].begin(), m_lAxis[uAxis].end(), IsBefore<Endpoint>);
+
+	m_lBegin.clear();
+	m_lEnd.clear();
+	m_uSwapCount = 0;
+	Sweep(a_lMin, a_lMax, m_lBegin);
+
+	m_lOverlap.clear();
+	m_lPair.clear();
+	if (m_uAxisCount == 3)
+	{
+		m_lOverlap.reserve(m_lBegin.size() * 2);
+		for (uint i = 0; i < m_lBegin.size(); i++)
+			m_lOverlap.insert(PairKey(m_lBegin[i].first, m_lBegin[i].second));
+	}
+	else
+	{
+		std::sort(m_lBegin.begin(), m_lBegin.end());
+		m_lPair = m_lBegin;
+	}
+}
+
+void MySweepAndPruneBroadphase::Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<uint> const& a_lMoved)
+{
+	//removed Entities shift the indices, and a lot of new ones would take the insertion sort too long
+	uint nEntities = a_lMin.size();
+	if (nEntities < m_uEntityCount || (nEntities - m_uEntityCount) * 2 > nEntities)
+	{
+		Build(a_lMin, a_lMax);
+		return;
+	}
+
+	m_lBegin.clear();
+	m_lEnd.clear();
+	m_uSwapCount = 0;
+	if (a_lMoved.empty())
+		return;
+
+	SetEndpoints(a_lMin, a_lMax);
+	for (uint uAxis = 0; uAxis < m_uAxisCount; uAxis++)
+		SortAxis(uAxis, a_lMin, a_lMax);
+
+	if (m_uAxisCount == 3)
+		return;
+
+	//a single axis does not see the boxes move apart on the others, the events come from the pairs
+	std::vector<std::pair<uint, uint>> lPair;
+	lPair.reserve(m_lPair.size());
+	Sweep(a_lMin, a_lMax, lPair);
+	std::sort(lPair.begin(), lPair.end());
+	std::set_difference(lPair.begin(), lPair.end(), m_lPair.begin(), m_lPair.end(), std::back_inserter(m_lBegin));
+	std::set_difference(m_lPair.begin(), m_lPair.end(), lPair.begin(), lPair.end(), std::back_inserter(m_lEnd));
+	m_lPair.swap(lPair);
+}
+
+void MySweepAndPruneBroadphase::GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	if (m_uAxisCount == 1)
+	{
+		a_lOutput.insert(a_lOutput.end(), m_lPair.begin(), m_lPair.end());
+		return;
+	}
+
+	a_lOutput.reserve(a_lOutput.size() + m_lOverlap.size());
+	for (uint64_t uKey : m_lOverlap)
+		a_lOutput.push_back(std::pair<uint, uint>(static_cast<uint>(uKey >> 32), static_cast<uint>(uKey & 0xFFFFFFFF)));
+}
+
+std::vector<std::pair<uint, uint>> const& MySweepAndPruneBroadphase::GetBeginEvents(void) { return m_lBegin; }
+
+std::vector<std::pair<uint, uint>> const& MySweepAndPruneBroadphase::GetEndEvents(void) { return m_lEnd; }
+
+uint MySweepAndPruneBroadphase::GetSwapCount(void) { return m_uSwapCount; }
+
+void MySweepAndPruneBroadphase::SetEndpoints(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	for (uint uAxis = 0; uAxis < m_uAxisCount; uAxis++)
+	{
+		std::vector<Endpoint>& lAxis = m_lAxis[uAxis];
+		uint nEndpoints = lAxis.size();
+		for (uint i = 0; i < nEndpoints; i++)
+		{
+			uint uEntity = lAxis[i].uData >> 1;
+			lAxis[i].fValue = (lAxis[i].uData & 1) ? a_lMax[uEntity][uAxis] : a_lMin[uEntity][uAxis];
+		}
+
+		//the new boxes start past every other one, as if they did not overlap anything yet
+		for (uint uEntity = m_uEntityCount; uEntity < a_lMin.size(); uEntity++)
+		{
+			Endpoint endpoint;
+			endpoint.fValue = a_lMin[uEntity][uAxis];
+			endpoint.uData = uEntity << 1;
+			lAxis.push_back(endpoint);
+			endpoint.fValue = a_lMax[uEntity][uAxis];
+			endpoint.uData = (uEntity << 1) | 1;
+			lAxis.push_back(endpoint);
+		}
+	}
+	m_uEntityCount = a_lMin.size();
+}
+
+void MySweepAndPruneBroadphase::SortAxis(uint a_uAxis, std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax)
+{
+	std::vector<Endpoint>& lAxis = m_lAxis[a_uAxis];
+	uint nEndpoints = lAxis.size();
+	for (uint i = 1; i < nEndpoints; i++)
+	{
+		Endpoint endpoint = lAxis[i];
+		uint j = i;
+		for (; j > 0 && IsBefore(endpoint, lAxis[j - 1]); j--)
+		{
+			Endpoint const& other = lAxis[j - 1];
+			if (m_uAxisCount == 3 && (endpoint.uData & 1) != (other.uData & 1))
+			{
+				//each pair of ends is swapped once at most, in the order they end up in
+				uint uA = endpoint.uData >> 1;
+				uint uB = other.uData >> 1;
+				uint64_t uKey = PairKey(uA, uB);
+				if ((endpoint.uData & 1) == 0)
+				{
+					//a minimum passing a maximum may start an overlap, if the other axes agree
+					if (uA != uB && IsOverlapping(a_lMin[uA], a_lMax[uA], a_lMin[uB], a_lMax[uB]) &&
+						m_lOverlap.insert(uKey).second)
+						m_lBegin.push_back(std::pair<uint, uint>(std::min(uA, uB), std::max(uA, uB)));
+				}
+				else if (m_lOverlap.erase(uKey) > 0)
+				{
+					//a maximum passing a minimum, they are apart on this axis
+					m_lEnd.push_back(std::pair<uint, uint>(std::min(uA, uB), std::max(uA, uB)));
+				}
+			}
+			lAxis[j] = other;
+			m_uSwapCount++;
+		}
+		lAxis[j] = endpoint;
+	}
+}
+
+void MySweepAndPruneBroadphase::Sweep(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+	std::vector<std::pair<uint, uint>>& a_lOutput)
+{
+	//boxes whose minimum was passed and whose maximum was not, and where each one is in that list
+	std::vector<uint> lOpen;
+	std::vector<uint> lSlot(m_uEntityCount);
+
+	std::vector<Endpoint> const& lAxis = m_lAxis[0];
+	uint nEndpoints = lAxis.size();
+	for (uint i = 0; i < nEndpoints; i++)
+	{
+		uint uEntity = lAxis[i].uData >> 1;
+		if (lAxis[i].uData & 1)
+		{
+			uint uLast = lOpen.back();
+			lOpen[lSlot[uEntity]] = uLast;
+			lSlot[uLast] = lSlot[uEntity];
+			lOpen.pop_back();
+			continue;
+		}
+
+		//every open box overlaps this one on x already
+		vector3 const& v3Min = a_lMin[uEntity];
+		vector3 const& v3Max = a_lMax[uEntity];
+		uint nOpen = lOpen.size();
+		for (uint j = 0; j < nOpen; j++)
+		{
+			uint uOther = lOpen[j];
+			if (v3Max.y < a_lMin[uOther].y || v3Min.y > a_lMax[uOther].y ||
+				v3Max.z < a_lMin[uOther].z || v3Min.z > a_lMax[uOther].z)
+				continue;
+			a_lOutput.push_back(std::pair<uint, uint>(std::min(uEntity, uOther), std::max(uEntity, uOther)));
+		}
+		lSlot[uEntity] = nOpen;
+		lOpen.push_back(uEntity);
+	}
+}
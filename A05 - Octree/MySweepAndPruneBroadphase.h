@@ -0,0 +1,125 @@
+#ifndef __MYSWEEPANDPRUNEBROADPHASECLASS_H_
+#define __MYSWEEPANDPRUNEBROADPHASECLASS_H_
+
+#include "MyBroadphase.h"
+
+#include <iterator>
+#include <unordered_set>
+
+namespace Simplex
+{
+
+	//System Class
+	class MySweepAndPruneBroadphase : public MyBroadphase
+	{
+		//an end of the box of an Entity on one axis, the minimum sorts before a maximum of the same value
+		struct Endpoint
+		{
+			float fValue; //coordinate on the axis
+			uint uData; //Entity index times 2, plus 1 for the maximum
+		};
+
+		uint m_uAxisCount = 3; //1 sweeps x and tests the pairs, 3 keeps the overlaps from the swaps of every axis
+		uint m_uEntityCount = 0; //number of Entities in the lists
+		std::vector<Endpoint> m_lAxis[3]; //ends of every box sorted along x, y and z (only x when sweeping 1 axis)
+		std::unordered_set<uint64_t> m_lOverlap; //overlapping pairs, smaller index in the high half (3 axes)
+		std::vector<std::pair<uint, uint>> m_lPair; //overlapping pairs, sorted (1 axis)
+		std::vector<std::pair<uint, uint>> m_lBegin; //pairs that started overlapping in the last Build or Update
+		std::vector<std::pair<uint, uint>> m_lEnd; //pairs that stopped overlapping in the last Build or Update
+		uint m_uSwapCount = 0; //endpoints swapped by the sort in the last Update
+
+	public:
+		/*
+		USAGE: Constructor
+		ARGUMENTS: uint a_uAxisCount -> 1 to sort along x only, 3 to sort along every axis
+		OUTPUT: class object
+		*/
+		MySweepAndPruneBroadphase(uint a_uAxisCount);
+		/*
+		USAGE: Gets the name of the broadphase
+		ARGUMENTS: ---
+		OUTPUT: name
+		*/
+		String GetName(void) override;
+		/*
+		USAGE: Sorts the ends of every box from scratch and finds the overlaps, all of them are
+		reported as begun
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void Build(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax) override;
+		/*
+		USAGE: Takes the new boxes and sorts the ends again with insertion sort, starting from the
+		order of the last frame; with 3 axes every swap of a minimum and a maximum is an overlap that
+		begins or ends, so the cost follows the number of swaps
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<uint> const& a_lMoved -> Entities whose box changed or that are new
+		OUTPUT: ---
+		*/
+		void Update(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<uint> const& a_lMoved) override;
+		/*
+		USAGE: Gets the pairs overlapping since the last Build or Update
+		ARGUMENTS: std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void GetPairs(std::vector<std::pair<uint, uint>>& a_lOutput) override;
+		/*
+		USAGE: Gets the pairs that started overlapping in the last Build or Update
+		ARGUMENTS: ---
+		OUTPUT: pairs, the smaller index first
+		*/
+		std::vector<std::pair<uint, uint>> const& GetBeginEvents(void);
+		/*
+		USAGE: Gets the pairs that stopped overlapping in the last Update
+		ARGUMENTS: ---
+		OUTPUT: pairs, the smaller index first
+		*/
+		std::vector<std::pair<uint, uint>> const& GetEndEvents(void);
+		/*
+		USAGE: Gets how many endpoints the sort swapped in the last Update
+		ARGUMENTS: ---
+		OUTPUT: number of swaps
+		*/
+		uint GetSwapCount(void);
+
+	private:
+		/*
+		USAGE: Sets the values of the ends on every axis from the boxes and adds the ends of the new
+		Entities at the back of the lists
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void SetEndpoints(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax);
+		/*
+		USAGE: Insertion sort of the ends along one axis; with 3 axes each minimum that passes a
+		maximum checks the boxes and each maximum that passes a minimum ends the overlap
+		ARGUMENTS:
+		- uint a_uAxis -> axis to sort
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		OUTPUT: ---
+		*/
+		void SortAxis(uint a_uAxis, std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax);
+		/*
+		USAGE: Sweeps the sorted ends of x keeping the boxes open at each point and tests them against
+		every box that opens, used by 1 axis and by Build
+		ARGUMENTS:
+		- std::vector<vector3> const& a_lMin -> minimum corner of the box of each Entity
+		- std::vector<vector3> const& a_lMax -> maximum corner of the box of each Entity
+		- std::vector<std::pair<uint, uint>>& a_lOutput -> list the pairs are appended to
+		OUTPUT: ---
+		*/
+		void Sweep(std::vector<vector3> const& a_lMin, std::vector<vector3> const& a_lMax,
+			std::vector<std::pair<uint, uint>>& a_lOutput);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYSWEEPANDPRUNEBROADPHASECLASS_H_
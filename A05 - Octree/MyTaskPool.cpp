@@ -0,0 +1,65 @@
+#include "MyTaskPool.h"
+using namespace Simplex;
+
+MyTaskPool::MyTaskPool(uint a_uThreadCount)
+{
+	if (a_uThreadCount == 0)
+		a_uThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	//the thread calling Wait is one of them
+	for (uint i = 1; i < a_uThreadCount; i++)
+	{
+		m_lWorker.push_back(std::thread(&MyTaskPool::Run, this, false));
+	}
+}
+
+MyTaskPool::~MyTaskPool(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bStop = true;
+	}
+	m_Condition.notify_all();
+
+	for (uint i = 0; i < m_lWorker.size(); i++)
+	{
+		m_lWorker[i].join();
+	}
+}
+
+uint MyTaskPool::GetThreadCount(void) { return m_lWorker.size() + 1; }
+
+void MyTaskPool::Push(std::function<void(void)> a_Task)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_lTask.push_back(std::move(a_Task));
+		m_uPending++;
+	}
+	m_Condition.notify_one();
+}
+
+void MyTaskPool::Wait(void) { Run(true); }
+
+void MyTaskPool::Run(bool a_bWait)
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	while (true)
+	{
+		m_Condition.wait(lock, [&] { return !m_lTask.empty() || m_bStop || (a_bWait && m_uPending == 0); });
+
+		//nothing to take, either everything is done or the pool is stopping
+		if (m_lTask.empty())
+			return;
+
+		//the newest task first keeps the work depth first, close to what the thread just did
+		std::function<void(void)> task = std::move(m_lTask.back());
+		m_lTask.pop_back();
+		lock.unlock();
+		task();
+		lock.lock();
+
+		if (--m_uPending == 0)
+			m_Condition.notify_all();
+	}
+}
@@ -0,0 +1,79 @@
+#ifndef __MYTASKPOOLCLASS_H_
+#define __MYTASKPOOLCLASS_H_
+
+#include "Simplex\Simplex.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Simplex
+{
+
+	//System Class
+	class MyTaskPool
+	{
+		std::vector<std::thread> m_lWorker; //threads running the tasks next to the one that waits
+		std::vector<std::function<void(void)>> m_lTask; //tasks not taken yet, the newest one goes first
+		std::mutex m_Mutex; //guards the task list, the pending count and the stop flag
+		std::condition_variable m_Condition; //signals new tasks, the last task finishing and the stop
+		uint m_uPending = 0; //tasks pushed that have not finished
+		bool m_bStop = false; //are the workers asked to leave
+
+	public:
+		/*
+		USAGE: Constructor, starts the worker threads, the thread calling Wait works too
+		ARGUMENTS: uint a_uThreadCount -> threads working on the tasks, 0 for one per core
+		OUTPUT: class object
+		*/
+		MyTaskPool(uint a_uThreadCount);
+		/*
+		USAGE: Destructor, runs the tasks left and joins the worker threads
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		~MyTaskPool(void);
+		/*
+		USAGE: Gets the number of threads working on the tasks, the one calling Wait included
+		ARGUMENTS: ---
+		OUTPUT: thread count
+		*/
+		uint GetThreadCount(void);
+		/*
+		USAGE: Adds a task, tasks can push more tasks while they run
+		ARGUMENTS: std::function<void(void)> a_Task -> task to run
+		OUTPUT: ---
+		*/
+		void Push(std::function<void(void)> a_Task);
+		/*
+		USAGE: Runs tasks on the calling thread until every task pushed (and the ones they push) is done
+		ARGUMENTS: ---
+		OUTPUT: ---
+		*/
+		void Wait(void);
+
+	private:
+		/*
+		USAGE: Copy Constructor, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: class object instance
+		*/
+		MyTaskPool(MyTaskPool const& other);
+		/*
+		USAGE: Copy Assignment Operator, private so it does not let object copy
+		ARGUMENTS: class object to copy
+		OUTPUT: ---
+		*/
+		MyTaskPool& operator=(MyTaskPool const& other);
+		/*
+		USAGE: Takes and runs tasks until there is nothing left to do
+		ARGUMENTS: bool a_bWait -> leave once no task is pending (Wait) instead of once the pool stops (workers)
+		OUTPUT: ---
+		*/
+		void Run(bool a_bWait);
+	};//class
+
+} //namespace Simplex
+
+#endif //__MYTASKPOOLCLASS_H_